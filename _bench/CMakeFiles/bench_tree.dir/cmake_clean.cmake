@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_tree.dir/benchmarks/bench_tree.cpp.o"
+  "CMakeFiles/bench_tree.dir/benchmarks/bench_tree.cpp.o.d"
+  "bench_tree"
+  "bench_tree.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_tree.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
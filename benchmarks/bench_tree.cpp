@@ -0,0 +1,638 @@
+/**
+ * @file bench_tree.cpp
+ * @brief Micro-benchmarks for BPTree, NodePool, selector and column pool hot paths.
+ *
+ * Self-contained harness (no external benchmark library). Build with
+ * -DBUILD_BENCHMARKS=ON and run:
+ *
+ *   ./bench_tree [--quick] [--filter TEXT] [--json FILE]
+ *
+ * --quick caps problem sizes at 10^5 nodes, --filter runs only the
+ * groups whose key (index, creation, dive, pruning, selectors, hybrid,
+ * pool, pairs, memory) contains TEXT, and --json writes every measurement to
+ * FILE so results can be compared across releases.
+ */
+
+#include "core/tree.hpp"
+#include "core/selection.hpp"
+#include "core/column_filter.hpp"
+#include "core/column_pool.hpp"
+#include "core/column_sets.hpp"
+#include "core/pair_scoring.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace openbp;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief One measurement: a timed operation count, or a plain value.
+ */
+struct Record {
+    std::string group;
+    std::string name;
+    size_t ops = 0;
+    double seconds = 0.0;
+    double value = 0.0;  // Non-timed metrics (e.g. bytes per node)
+    const char* unit = "";
+};
+
+std::vector<Record> g_records;
+std::string g_group;
+
+void begin_group(const std::string& group) {
+    g_group = group;
+    std::printf("\n-- %s --\n", group.c_str());
+}
+
+void report(const char* name, size_t ops, double seconds) {
+    std::printf("%-40s %12zu ops %10.3f ms %10.2f Mops/s\n",
+                name, ops, seconds * 1e3, ops / seconds / 1e6);
+    g_records.push_back({g_group, name, ops, seconds, 0.0, ""});
+}
+
+void report_value(const char* name, double value, const char* unit) {
+    std::printf("%-40s %12.1f %s\n", name, value, unit);
+    g_records.push_back({g_group, name, 0, 0.0, value, unit});
+}
+
+void write_json_string(FILE* out, const std::string& text) {
+    std::fputc('"', out);
+    for (char c : text) {
+        if (c == '"' || c == '\\') std::fputc('\\', out);
+        std::fputc(c, out);
+    }
+    std::fputc('"', out);
+}
+
+bool write_json(const char* path) {
+    FILE* out = std::fopen(path, "w");
+    if (!out) return false;
+    std::fprintf(out, "{\n  \"suite\": \"bench_tree\",\n  \"results\": [\n");
+    for (size_t k = 0; k < g_records.size(); ++k) {
+        const Record& r = g_records[k];
+        std::fprintf(out, "    {\"group\": ");
+        write_json_string(out, r.group);
+        std::fprintf(out, ", \"name\": ");
+        write_json_string(out, r.name);
+        if (r.ops > 0) {
+            std::fprintf(out, ", \"ops\": %zu, \"seconds\": %.9g, \"ops_per_second\": %.9g}",
+                         r.ops, r.seconds, r.ops / r.seconds);
+        } else {
+            std::fprintf(out, ", \"value\": %.9g, \"unit\": ", r.value);
+            write_json_string(out, r.unit);
+            std::fputc('}', out);
+        }
+        std::fprintf(out, "%s\n", k + 1 < g_records.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+    return std::fclose(out) == 0;
+}
+
+// Keeps results observable so the optimizer cannot drop the loops.
+volatile double g_sink = 0.0;
+
+/**
+ * @brief Build a complete binary tree with @p num_nodes nodes.
+ */
+void build_binary_tree(BPTree& tree, size_t num_nodes) {
+    std::vector<BPNode*> frontier = {tree.root()};
+    size_t head = 0;
+    while (tree.num_nodes() < num_nodes) {
+        BPNode* parent = frontier[head++];
+        parent->set_lower_bound(static_cast<double>(parent->id()));
+        int32_t var = static_cast<int32_t>(parent->id());
+        auto children = tree.create_children(parent, {
+            BranchingDecision::variable_branch(var, 0.5, true),
+            BranchingDecision::variable_branch(var, 0.5, false),
+        });
+        frontier.insert(frontier.end(), children.begin(), children.end());
+    }
+}
+
+void bench_node_index(size_t num_nodes) {
+    begin_group("Node index, " + std::to_string(num_nodes) + " nodes");
+
+    BPTree tree;
+    build_binary_tree(tree, num_nodes);
+    const size_t n = tree.num_nodes();
+
+    // Reference: the previous unordered_map index
+    std::unordered_map<BPNode::NodeId, BPNode*> map;
+    map.reserve(n);
+    tree.for_each_node([&](BPNode* node) { map[node->id()] = node; });
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<BPNode::NodeId> pick(0, static_cast<BPNode::NodeId>(n - 1));
+    std::vector<BPNode::NodeId> ids(n);
+    for (auto& id : ids) id = pick(rng);
+
+    double sum = 0.0;
+    auto start = Clock::now();
+    for (auto id : ids) sum += tree.node(id)->lower_bound();
+    report("lookup random (dense index)", n, seconds_since(start));
+
+    start = Clock::now();
+    for (auto id : ids) sum += map.find(id)->second->lower_bound();
+    report("lookup random (unordered_map)", n, seconds_since(start));
+
+    start = Clock::now();
+    tree.for_each_node([&](const BPNode* node) { sum += node->lower_bound(); });
+    report("scan all (dense index, ID order)", n, seconds_since(start));
+
+    start = Clock::now();
+    for (const auto& entry : map) sum += entry.second->lower_bound();
+    report("scan all (unordered_map)", n, seconds_since(start));
+
+    g_sink = g_sink + sum;
+}
+
+/**
+ * @brief Expand a breadth-first frontier with @p arity children per node
+ * until @p num_nodes exist, using @p branch to create each node's children.
+ */
+template<typename Branch>
+double expand_tree(size_t num_nodes, int32_t arity, Branch&& branch) {
+    BPTree tree;
+    std::vector<BranchingDecision> decisions(static_cast<size_t>(arity));
+    std::vector<BPNode*> frontier = {tree.root()};
+    size_t head = 0;
+    auto start = Clock::now();
+    while (tree.num_nodes() < num_nodes) {
+        BPNode* parent = frontier[head++];
+        auto item = static_cast<int32_t>(parent->id());
+        for (int32_t k = 0; k < arity; ++k) {
+            decisions[static_cast<size_t>(k)] = BranchingDecision::ryan_foster(item, k, k == 0);
+        }
+        branch(tree, parent, decisions, frontier);
+    }
+    double seconds = seconds_since(start);
+    g_sink = g_sink + static_cast<double>(tree.num_nodes());
+    return seconds;
+}
+
+void bench_branching(size_t num_nodes, int32_t arity) {
+    begin_group("Node creation, " + std::to_string(arity) + " children per node, " +
+                std::to_string(num_nodes) + " nodes");
+
+    // Reference: one create_child() per decision, then close the parent
+    double seconds = expand_tree(num_nodes, arity,
+        [](BPTree& tree, BPNode* parent, const std::vector<BranchingDecision>& decisions,
+           std::vector<BPNode*>& frontier) {
+            for (const auto& d : decisions) frontier.push_back(tree.create_child(parent, d));
+            tree.mark_processed(parent, NodeStatus::BRANCHED);
+        });
+    report("create_child per child", num_nodes, seconds);
+
+    seconds = expand_tree(num_nodes, arity,
+        [](BPTree& tree, BPNode* parent, const std::vector<BranchingDecision>& decisions,
+           std::vector<BPNode*>& frontier) {
+            auto children = tree.create_children(parent, decisions);
+            frontier.insert(frontier.end(), children.begin(), children.end());
+        });
+    report("create_children (batched)", num_nodes, seconds);
+}
+
+/**
+ * @brief The previous HybridSelector, kept as a baseline: every node sits
+ * in two std::priority_queues and the other queue is rebuilt (pop all,
+ * push back the open ones) after each selection.
+ */
+class LegacyHybridSelector {
+public:
+    LegacyHybridSelector(int dive_frequency = 5, int dive_depth = 10)
+        : dive_frequency_(dive_frequency), dive_depth_(dive_depth) {}
+
+    void add_node(BPNode* node) {
+        best_first_.push(node);
+        depth_first_.push(node);
+    }
+
+    BPNode* select_next() {
+        if (!diving_ && nodes_since_dive_ >= dive_frequency_) {
+            diving_ = true;
+            current_dive_depth_ = 0;
+        }
+        if (diving_) {
+            BPNode* node = pop_next(depth_first_);
+            if (node) {
+                if (++current_dive_depth_ >= dive_depth_) {
+                    diving_ = false;
+                    nodes_since_dive_ = 0;
+                }
+                rebuild(best_first_);
+                return node;
+            }
+            diving_ = false;
+        }
+        nodes_since_dive_++;
+        rebuild(depth_first_);
+        return pop_next(best_first_);
+    }
+
+private:
+    struct ByBound {
+        bool operator()(const BPNode* a, const BPNode* b) const {
+            return a->lower_bound() > b->lower_bound();
+        }
+    };
+    struct ByDepth {
+        bool operator()(const BPNode* a, const BPNode* b) const {
+            if (a->depth() != b->depth()) return a->depth() < b->depth();
+            return a->lower_bound() > b->lower_bound();
+        }
+    };
+
+    template<typename Queue>
+    static BPNode* pop_next(Queue& queue) {
+        rebuild(queue);
+        if (queue.empty()) return nullptr;
+        BPNode* node = queue.top();
+        queue.pop();
+        return node;
+    }
+
+    template<typename Queue>
+    static void rebuild(Queue& queue) {
+        std::vector<BPNode*> valid;
+        while (!queue.empty()) {
+            if (queue.top()->can_be_explored()) valid.push_back(queue.top());
+            queue.pop();
+        }
+        for (BPNode* node : valid) queue.push(node);
+    }
+
+    std::priority_queue<BPNode*, std::vector<BPNode*>, ByBound> best_first_;
+    std::priority_queue<BPNode*, std::vector<BPNode*>, ByDepth> depth_first_;
+    int dive_frequency_;
+    int dive_depth_;
+    int nodes_since_dive_ = 0;
+    int current_dive_depth_ = 0;
+    bool diving_ = false;
+};
+
+/**
+ * @brief Open nodes of a binary tree, with random bounds, for selector benchmarks.
+ */
+std::vector<BPNode*> make_open_frontier(BPTree& tree, size_t num_open) {
+    build_binary_tree(tree, 2 * num_open);
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> bound(0.0, 1000.0);
+    std::vector<BPNode*> open;
+    for (auto id : tree.get_open_nodes()) {
+        BPNode* node = tree.node(id);
+        node->set_lower_bound(bound(rng));
+        open.push_back(node);
+    }
+    return open;
+}
+
+template<typename Selector>
+double drain(Selector& selector, size_t count) {
+    double sum = 0.0;
+    for (size_t k = 0; k < count; ++k) {
+        BPNode* node = selector.select_next();
+        if (!node) break;
+        node->set_status(NodeStatus::PROCESSING);  // As the solver does
+        sum += node->lower_bound();
+    }
+    return sum;
+}
+
+void bench_hybrid_selector(size_t num_open, size_t legacy_selections) {
+    begin_group("Hybrid selector vs legacy, " + std::to_string(num_open) + " open nodes");
+    double sum = 0.0;
+
+    {
+        BPTree tree;
+        auto open = make_open_frontier(tree, num_open);
+        LegacyHybridSelector legacy;
+        auto start = Clock::now();
+        for (BPNode* node : open) legacy.add_node(node);
+        report("legacy add (two queues)", open.size(), seconds_since(start));
+        start = Clock::now();
+        sum += drain(legacy, legacy_selections);
+        report("legacy select (rebuild per pick)", legacy_selections, seconds_since(start));
+    }
+    {
+        BPTree tree;
+        auto open = make_open_frontier(tree, num_open);
+        HybridSelector hybrid;
+        auto start = Clock::now();
+        hybrid.add_nodes(open);
+        report("shared store add", open.size(), seconds_since(start));
+        start = Clock::now();
+        sum += drain(hybrid, legacy_selections);
+        report("shared store select (same count)", legacy_selections, seconds_since(start));
+        size_t rest = hybrid.size();
+        start = Clock::now();
+        sum += drain(hybrid, rest);
+        report("shared store select (drain rest)", rest, seconds_since(start));
+    }
+
+    g_sink = g_sink + sum;
+}
+
+/**
+ * @brief Repeated dives: expand the deepest open node (two children)
+ * and select again, as a depth-first search does between backtracks.
+ */
+void bench_deep_dive(size_t num_steps) {
+    begin_group("Deep dive, " + std::to_string(num_steps) + " expansions");
+
+    BPTree tree;
+    DepthFirstSelector selector;
+    tree.add_listener(&selector);
+    selector.add_node(tree.root());
+    std::vector<BranchingDecision> decisions(2);
+
+    auto start = Clock::now();
+    for (size_t step = 0; step < num_steps; ++step) {
+        BPNode* node = selector.select_next();
+        tree.begin_processing(node);
+        auto item = static_cast<int32_t>(node->depth());
+        decisions[0] = BranchingDecision::ryan_foster(item, item + 1, true);
+        decisions[1] = BranchingDecision::ryan_foster(item, item + 1, false);
+        selector.add_nodes(tree.create_children(node, decisions));
+    }
+    report("select + branch (depth-first)", num_steps, seconds_since(start));
+
+    BPNode* leaf = selector.select_next();
+    start = Clock::now();
+    double sum = 0.0;
+    for (const auto& d : leaf->decision_path()) sum += d.item_i();
+    report("walk decision path of deepest node", leaf->num_decisions(), seconds_since(start));
+
+    start = Clock::now();
+    auto all = leaf->all_decisions();
+    report("materialise all_decisions()", all.size(), seconds_since(start));
+
+    tree.remove_listener(&selector);
+    g_sink = g_sink + sum + static_cast<double>(all.size());
+}
+
+/**
+ * @brief Prune an open frontier against a sequence of improving incumbents.
+ */
+void bench_pruning(size_t num_open, size_t num_updates) {
+    begin_group("Pruning after incumbent updates, " + std::to_string(num_open) + " open nodes");
+
+    for (bool with_selector : {false, true}) {
+        BPTree tree;
+        auto open = make_open_frontier(tree, num_open);
+        BestFirstSelector selector;
+        if (with_selector) {
+            selector.add_nodes(open);
+            tree.add_listener(&selector);
+        }
+
+        // Bounds are uniform in [0, 1000): each update cuts an equal share
+        int64_t pruned = 0;
+        auto start = Clock::now();
+        for (size_t k = 1; k <= num_updates; ++k) {
+            tree.tighten_upper_bound(1000.0 * (1.0 - static_cast<double>(k) / (num_updates + 1)));
+            pruned += tree.prune_if_pending();
+        }
+        double seconds = seconds_since(start);
+        report(with_selector ? "prune with attached selector" : "prune tree only",
+               static_cast<size_t>(pruned), seconds);
+
+        if (with_selector) tree.remove_listener(&selector);
+    }
+}
+
+/**
+ * @brief Bulk add and full drain for one selector.
+ */
+void bench_selector(const char* name, size_t num_open) {
+    BPTree tree;
+    auto open = make_open_frontier(tree, num_open);
+    auto selector = create_selector(name);
+
+    auto start = Clock::now();
+    selector->add_nodes(open);
+    std::string label = std::string(name) + " add";
+    report(label.c_str(), open.size(), seconds_since(start));
+
+    start = Clock::now();
+    double sum = drain(*selector, open.size());
+    label = std::string(name) + " select";
+    report(label.c_str(), open.size(), seconds_since(start));
+
+    g_sink = g_sink + sum;
+}
+
+void bench_selectors(size_t num_open) {
+    begin_group("Selectors, " + std::to_string(num_open) + " open nodes");
+    for (const char* name : {"best_first", "depth_first", "best_estimate", "hybrid", "work_stealing"}) {
+        bench_selector(name, num_open);
+    }
+}
+
+/**
+ * @brief Column pool insertion and duplicate detection (crew-pairing-like
+ * columns: 10 of 2000 items, 12 arcs each).
+ */
+void bench_column_pool(size_t num_columns) {
+    begin_group("Column pool, " + std::to_string(num_columns) + " columns");
+
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int32_t> item(0, 1999);
+    std::vector<int32_t> items(num_columns * 10);
+    std::vector<int32_t> arcs(num_columns * 12);
+    for (auto& i : items) i = item(rng);
+    for (auto& a : arcs) a = item(rng);
+
+    ColumnPool pool(2000);
+    auto start = Clock::now();
+    for (size_t k = 0; k < num_columns; ++k) {
+        pool.add(1.0, items.data() + 10 * k, 10, arcs.data() + 12 * k, 12);
+    }
+    report("add (new columns)", num_columns, seconds_since(start));
+
+    start = Clock::now();
+    size_t duplicates = 0;
+    for (size_t k = 0; k < num_columns; ++k) {
+        duplicates += !pool.add(1.0, items.data() + 10 * k, 10, arcs.data() + 12 * k, 12).inserted;
+    }
+    report("add (all duplicates)", duplicates, seconds_since(start));
+    report_value("pool memory per column",
+                 static_cast<double>(pool.memory_usage()) / static_cast<double>(pool.size()), "bytes");
+
+    // Node filtering: 200 Ryan-Foster decisions on random item pairs
+    std::vector<BranchingDecision> decisions;
+    for (int k = 0; k < 200; ++k) {
+        decisions.push_back(BranchingDecision::ryan_foster(item(rng), item(rng), k % 2 == 0));
+    }
+    ColumnFilter filter(decisions);
+    for (bool simd : {false, true}) {
+        if (simd && !ColumnFilter::simd_available()) continue;
+        filter.set_use_simd(simd);
+        start = Clock::now();
+        auto valid = filter.indices(pool);
+        report(simd ? "filter 200 decisions (AVX2)" : "filter 200 decisions (scalar)",
+               pool.size(), seconds_since(start));
+        g_sink = g_sink + static_cast<double>(valid.size());
+    }
+
+    // Valid columns of both children along a 50-level dive: full re-filter vs derived from parent
+    const int dive_depth = 50;
+    for (bool incremental : {false, true}) {
+        BPTree tree;
+        NodeColumnSets sets(pool);
+        std::mt19937_64 dive_rng(13);
+        BPNode* node = tree.root();
+        size_t total = 0;
+        start = Clock::now();
+        for (int depth = 0; depth < dive_depth; ++depth) {
+            int32_t i = item(dive_rng), j = item(dive_rng);
+            auto children = tree.create_children(node, {BranchingDecision::ryan_foster(i, j, false),
+                                                        BranchingDecision::ryan_foster(i, j, true)});
+            node = children[0];
+            if (incremental) {
+                if (depth == 0) sets.get(*tree.root());
+                sets.branch(*tree.node(node->parent_id()), children);
+                total += sets.get(*node)->count();
+            } else {
+                auto sibling = ColumnFilter::for_node(*children[1]).indices(pool);
+                g_sink = g_sink + static_cast<double>(sibling.size());
+                total += ColumnFilter::for_node(*node).indices(pool).size();
+            }
+        }
+        report(incremental ? "dive node sets (derived from parent)" : "dive node sets (full re-filter)",
+               dive_depth, seconds_since(start));
+        g_sink = g_sink + static_cast<double>(total);
+    }
+}
+
+/**
+ * @brief Ryan-Foster pair scoring on a crew-pairing-like LP solution:
+ * fractional columns of 12 flights each, drawn from 500 flights.
+ */
+void bench_pair_scoring(size_t num_columns) {
+    begin_group("Ryan-Foster pair scoring, " + std::to_string(num_columns) + " fractional columns");
+
+    std::mt19937_64 rng(17);
+    std::uniform_int_distribution<int32_t> flight(0, 499);
+    std::uniform_real_distribution<double> value(0.01, 0.5);
+    std::vector<int64_t> offsets{0};
+    std::vector<int32_t> items;
+    std::vector<double> values;
+    for (size_t c = 0; c < num_columns; ++c) {
+        std::vector<int32_t> column(12);
+        for (auto& f : column) f = flight(rng);
+        std::sort(column.begin(), column.end());
+        column.erase(std::unique(column.begin(), column.end()), column.end());
+        items.insert(items.end(), column.begin(), column.end());
+        offsets.push_back(static_cast<int64_t>(items.size()));
+        values.push_back(value(rng));
+    }
+    RyanFosterClosure closure;
+    for (int32_t f = 0; f < 40; f += 2) closure.add(BranchingDecision::ryan_foster(f, f + 1, f % 4 == 0));
+
+    // Reference: one hash-map update per pair, as the Python dict loop does
+    auto start = Clock::now();
+    std::unordered_map<uint64_t, double> together;
+    for (size_t c = 0; c < num_columns; ++c) {
+        for (int64_t a = offsets[c]; a < offsets[c + 1]; ++a) {
+            for (int64_t b = a + 1; b < offsets[c + 1]; ++b) {
+                together[(static_cast<uint64_t>(items[a]) << 32) | static_cast<uint32_t>(items[b])] += values[c];
+            }
+        }
+    }
+    double best = -1.0;
+    for (const auto& [key, mass] : together) {
+        if (mass < 0.01 || mass > 0.99) continue;
+        if (closure.implied(static_cast<int32_t>(key >> 32), static_cast<int32_t>(key & 0xFFFFFFFFu))) continue;
+        best = std::max(best, 1.0 - std::abs(mass - 0.5) * 2.0);
+    }
+    report("best pair (std::unordered_map)", num_columns, seconds_since(start));
+    g_sink = g_sink + best;
+
+    RyanFosterPairScorer scorer;
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        start = Clock::now();
+        auto top = scorer.score(offsets, items, values, 20, &closure);
+        report(repeat == 0 ? "top-20 pairs (scorer, cold)" : "top-20 pairs (scorer, reused)",
+               num_columns, seconds_since(start));
+        g_sink = g_sink + (top.size() > 0 ? top.score[0] : 0.0);
+    }
+    report_value("distinct pairs", static_cast<double>(scorer.num_pairs()), "pairs");
+}
+
+/**
+ * @brief Memory held per node by node storage and the ID index.
+ */
+void bench_memory(size_t num_nodes) {
+    begin_group("Memory, " + std::to_string(num_nodes) + " nodes");
+
+    BPTree tree;
+    build_binary_tree(tree, num_nodes);
+    report_value("sizeof(BPNode)", static_cast<double>(sizeof(BPNode)), "bytes");
+    report_value("tree storage per node",
+                 static_cast<double>(tree.memory_usage()) / static_cast<double>(tree.num_nodes()),
+                 "bytes");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool quick = false;
+    const char* filter = nullptr;
+    const char* json_path = nullptr;
+    for (int k = 1; k < argc; ++k) {
+        if (std::strcmp(argv[k], "--quick") == 0) {
+            quick = true;
+        } else if (std::strcmp(argv[k], "--filter") == 0 && k + 1 < argc) {
+            filter = argv[++k];
+        } else if (std::strcmp(argv[k], "--json") == 0 && k + 1 < argc) {
+            json_path = argv[++k];
+        } else {
+            std::fprintf(stderr, "usage: %s [--quick] [--filter TEXT] [--json FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    auto enabled = [&](const char* group) {
+        return !filter || std::strstr(group, filter) != nullptr;
+    };
+    const size_t max_nodes = quick ? 100000 : 1000000;
+
+    std::printf("=== OpenBP tree benchmarks ===\n");
+
+    if (enabled("index")) bench_node_index(max_nodes);
+    if (enabled("creation")) {
+        bench_branching(max_nodes, 2);
+        bench_branching(max_nodes, 8);
+    }
+    if (enabled("dive")) bench_deep_dive(max_nodes / 10);
+    if (enabled("pruning")) bench_pruning(max_nodes, 100);
+    if (enabled("selectors")) {
+        for (size_t n = 1000; n <= max_nodes; n *= 10) bench_selectors(n);
+    }
+    if (enabled("hybrid")) {
+        bench_hybrid_selector(max_nodes / 10, 100);  // Legacy is O(n log n) per pick
+    }
+    if (enabled("pool")) bench_column_pool(max_nodes);
+    if (enabled("pairs")) bench_pair_scoring(quick ? 4000 : 20000);
+    if (enabled("memory")) bench_memory(max_nodes);
+
+    if (json_path && !write_json(json_path)) {
+        std::fprintf(stderr, "cannot write %s\n", json_path);
+        return 1;
+    }
+    return 0;
+}
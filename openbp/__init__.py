@@ -8,23 +8,44 @@ using Branch-and-Price, built on top of OpenCG for column generation.
 __version__ = "0.1.0"
 
 # Core classes from C++ backend
-from openbp._core import (
+from openbp._core import (  # noqa: I001 (grouped by component)
     # Backend info
     HAS_CPP_BACKEND,
-    BestEstimateSelector,
-    BestFirstSelector,
     # Node and tree
     BPNode,
     BPTree,
     BranchingDecision,
     BranchType,
+    NodeStatus,
+    TreeStats,
+    # Selection policies
+    BestEstimateSelector,
+    BestFirstSelector,
     DepthFirstSelector,
     HybridSelector,
-    # Selection policies
     NodeSelector,
-    NodeStatus,
-    TreeStats,
+    WorkStealingSelector,
     create_selector,
+    # Column storage
+    ColumnFilter,
+    ColumnPool,
+    NodeColumnSets,
+    # Branching kernels
+    RyanFosterClosure,
+    RyanFosterPairScorer,
+    # Parallel driver
+    IncumbentRegister,
+    NodeResult,
+    ParallelConfig,
+    ParallelResult,
+    ParallelSolver,
+    ParallelStatus,
+    PortfolioConfig,
+    PortfolioResult,
+    PortfolioSolver,
+    RacerResult,
+    apply_round,
+    select_round,
 )
 
 # Python branching strategies
@@ -43,6 +64,7 @@ from openbp.selection import (
     BestFirstSelection,
     DepthFirstSelection,
     HybridSelection,
+    WorkStealingSelection,
 )
 
 # Solver
@@ -69,12 +91,34 @@ __all__ = [
     "DepthFirstSelector",
     "BestEstimateSelector",
     "HybridSelector",
+    "WorkStealingSelector",
     "create_selector",
+    # Parallel driver (C++)
+    "ParallelSolver",
+    "ParallelConfig",
+    "ParallelStatus",
+    "ParallelResult",
+    "NodeResult",
+    "PortfolioSolver",
+    "PortfolioConfig",
+    "PortfolioResult",
+    "RacerResult",
+    "IncumbentRegister",
+    "select_round",
+    "apply_round",
+    # Column storage (C++)
+    "ColumnPool",
+    "ColumnFilter",
+    "NodeColumnSets",
+    # Branching kernels (C++)
+    "RyanFosterClosure",
+    "RyanFosterPairScorer",
     # Selection (Python wrappers)
     "BestFirstSelection",
     "DepthFirstSelection",
     "BestEstimateSelection",
     "HybridSelection",
+    "WorkStealingSelection",
     # Branching
     "BranchingStrategy",
     "BranchingCandidate",
@@ -18,15 +18,35 @@ try:
         BPTree,
         BranchingDecision,
         BranchType,
+        # Column storage
+        ColumnFilter,
+        ColumnPool,
+        NodeColumnSets,
         DepthFirstSelector,
         HybridSelector,
         # Selection policies
         NodeSelector,
         NodeStatus,
+        # Parallel driver
+        IncumbentRegister,
+        NodeResult,
+        ParallelConfig,
+        ParallelResult,
+        ParallelSolver,
+        ParallelStatus,
+        PortfolioConfig,
+        PortfolioResult,
+        PortfolioSolver,
+        RacerResult,
+        RyanFosterClosure,
+        RyanFosterPairScorer,
         TreeStats,
+        WorkStealingSelector,
         # Version info
         __version__,
+        apply_round,
         create_selector,
+        select_round,
     )
 except ImportError:
     # C++ module not available - use pure Python fallback
@@ -36,15 +56,33 @@ except ImportError:
         BranchingDecision,
         BranchType,
         NodeStatus,
+        RyanFosterClosure,
     )
+    from openbp.core.column_pool import ColumnFilter, ColumnPool, NodeColumnSets
+    from openbp.core.pair_scoring import RyanFosterPairScorer
     from openbp.core.selection import (
         BestEstimateSelector,
         BestFirstSelector,
         DepthFirstSelector,
         HybridSelector,
         NodeSelector,
+        WorkStealingSelector,
         create_selector,
     )
+    from openbp.core.parallel import (
+        IncumbentRegister,
+        NodeResult,
+        ParallelConfig,
+        ParallelResult,
+        ParallelSolver,
+        ParallelStatus,
+        PortfolioConfig,
+        PortfolioResult,
+        PortfolioSolver,
+        RacerResult,
+        apply_round,
+        select_round,
+    )
     from openbp.core.tree import BPTree, TreeStats
     __version__ = "0.1.0"
 
@@ -55,12 +93,30 @@ __all__ = [
     "NodeStatus",
     "BranchType",
     "BranchingDecision",
+    "RyanFosterClosure",
+    "RyanFosterPairScorer",
     "NodeSelector",
     "BestFirstSelector",
     "DepthFirstSelector",
     "BestEstimateSelector",
     "HybridSelector",
+    "WorkStealingSelector",
     "create_selector",
+    "NodeResult",
+    "ParallelConfig",
+    "ParallelStatus",
+    "ParallelResult",
+    "ParallelSolver",
+    "PortfolioConfig",
+    "PortfolioResult",
+    "PortfolioSolver",
+    "RacerResult",
+    "IncumbentRegister",
+    "select_round",
+    "apply_round",
+    "ColumnPool",
+    "ColumnFilter",
+    "NodeColumnSets",
     "__version__",
     "HAS_CPP_BACKEND",
 ]
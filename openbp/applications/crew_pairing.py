@@ -14,10 +14,16 @@ at each B&B node to find new columns that respect the branching decisions.
 """
 
 import time
-from collections import defaultdict
 from dataclasses import dataclass
 from typing import Any, Optional
 
+from openbp._core import (
+    BranchingDecision,
+    ColumnFilter,
+    ColumnPool,
+    RyanFosterClosure,
+    RyanFosterPairScorer,
+)
 from openbp.solver import BPSolution, BPStatus
 
 
@@ -126,13 +132,12 @@ def solve_crew_pairing_bp(
 
     # Global pairing pool - accumulates all generated pairings
     all_pairings: list[dict] = []
-    pairing_set: set[frozenset[int]] = set()
+    pairing_index = ColumnPool(n_flights)  # Flight sets of all_pairings
 
     def add_pairing(cost: float, flights: set[int], arc_indices: tuple[int, ...]) -> bool:
         """Add pairing to pool if not already present. Returns True if added."""
-        key = frozenset(flights)
-        if key not in pairing_set:
-            pairing_set.add(key)
+        _, inserted = pairing_index.add(cost, flights)
+        if inserted:
             all_pairings.append({
                 'cost': cost,
                 'flights': flights,
@@ -217,7 +222,7 @@ def solve_crew_pairing_bp(
 
         # Solve node with column generation
         result = _solve_node_with_cg(
-            problem, n_flights, pricing, all_pairings, add_pairing,
+            problem, n_flights, pricing, all_pairings, pairing_index, add_pairing,
             rf_decisions, config.cg_max_iterations_per_node,
             config.verbose and depth < 2
         )
@@ -350,6 +355,7 @@ def _solve_node_with_cg(
     n_flights: int,
     pricing,
     all_pairings: list[dict],
+    pairing_index: ColumnPool,
     add_pairing_fn,
     rf_decisions: list[RyanFosterDecision],
     max_cg_iterations: int,
@@ -393,19 +399,24 @@ def _solve_node_with_cg(
     valid_pairings = []
     pairing_to_col_id = {}
 
-    for pairing in all_pairings:
-        if _pairing_satisfies_rf_decisions(pairing['flights'], rf_decisions):
-            col = Column(
-                arc_indices=pairing['arc_indices'],
-                cost=pairing['cost'],
-                covered_items=frozenset(pairing['flights']),
-                column_id=next_col_id,
-                attributes={'pairing': pairing},
-            )
-            master.add_column(col)
-            pairing_to_col_id[frozenset(pairing['flights'])] = next_col_id
-            valid_pairings.append(pairing)
-            next_col_id += 1
+    # pairing_index holds all_pairings in the same order, so one native
+    # pass over its coverage bitsets selects the valid pairings
+    rf_filter = ColumnFilter([
+        BranchingDecision.ryan_foster(d.item_i, d.item_j, d.same_column) for d in rf_decisions
+    ])
+    for k in rf_filter.indices(pairing_index):
+        pairing = all_pairings[k]
+        col = Column(
+            arc_indices=pairing['arc_indices'],
+            cost=pairing['cost'],
+            covered_items=frozenset(pairing['flights']),
+            column_id=next_col_id,
+            attributes={'pairing': pairing},
+        )
+        master.add_column(col)
+        pairing_to_col_id[frozenset(pairing['flights'])] = next_col_id
+        valid_pairings.append(pairing)
+        next_col_id += 1
 
     # Column generation loop at this node
     for cg_iter in range(max_cg_iterations):
@@ -507,47 +518,26 @@ def _find_ryan_foster_pair(
     Returns:
         (flight_i, flight_j, together_value) or None if no valid pair
     """
-    # Compute pair overlap values
-    pair_together: dict[tuple[int, int], float] = defaultdict(float)
-    all_flights: set[int] = set()
-
+    # Pairings with a positive LP value, as CSR coverage
+    offsets = [0]
+    flights: list[int] = []
+    values: list[float] = []
     for pairing, val in zip(pairings, pairing_values):
         if val < 1e-9:
             continue
-
-        flights = list(pairing['flights'])
-        all_flights.update(flights)
-
-        # Flights in this pairing are "together"
-        for i in range(len(flights)):
-            for j in range(i + 1, len(flights)):
-                pair = (min(flights[i], flights[j]), max(flights[i], flights[j]))
-                pair_together[pair] += val
-
-    # Find pairs that are already constrained
-    constrained_pairs: set[tuple[int, int]] = set()
-    for decision in existing_decisions:
-        pair = (min(decision.item_i, decision.item_j),
-                max(decision.item_i, decision.item_j))
-        constrained_pairs.add(pair)
-
-    # Find best fractional pair
-    best_pair = None
-    best_score = -1.0
-
-    for pair, together in pair_together.items():
-        if pair in constrained_pairs:
-            continue
-
-        # Skip if not fractional
-        if together < 0.01 or together > 0.99:
-            continue
-
-        # Score: prefer balanced splits (together close to 0.5)
-        score = 1.0 - abs(together - 0.5) * 2
-
-        if score > best_score:
-            best_score = score
-            best_pair = (pair[0], pair[1], together)
-
-    return best_pair
+        flights.extend(pairing['flights'])
+        offsets.append(len(flights))
+        values.append(val)
+
+    # Pairs already decided, directly or through transitivity
+    closure = RyanFosterClosure([
+        BranchingDecision.ryan_foster(d.item_i, d.item_j, d.same_column)
+        for d in existing_decisions
+    ])
+
+    # Most balanced fractional pair (together closest to 0.5), scored natively
+    scorer = RyanFosterPairScorer(min_pair_value=0.01)
+    best = scorer.score(offsets, flights, values, k=1, closure=closure)
+    if len(best["score"]) == 0:
+        return None
+    return int(best["item_i"][0]), int(best["item_j"][0]), float(best["together"][0])
@@ -15,10 +15,10 @@ at each B&B node to find new columns that respect the branching decisions.
 
 import math
 import time
-from collections import defaultdict
 from dataclasses import dataclass
 from typing import Any, Optional
 
+from openbp._core import BranchingDecision, RyanFosterClosure, RyanFosterPairScorer
 from openbp.solver import BPSolution, BPStatus
 
 
@@ -526,46 +526,26 @@ def _find_ryan_foster_pair(
     Returns:
         (item_i, item_j, together_value) or None if no valid pair
     """
-    # Compute pair overlap values
-    pair_together: dict[tuple[int, int], float] = defaultdict(float)
-    all_items: set[int] = set()
-
+    # Routes with a positive LP value, as CSR coverage
+    offsets = [0]
+    items: list[int] = []
+    values: list[float] = []
     for route, val in zip(routes, route_values):
         if val < 1e-9:
             continue
-
-        all_items.update(route)
-
-        # Items in this route are "together"
-        for i in range(len(route)):
-            for j in range(i + 1, len(route)):
-                pair = (min(route[i], route[j]), max(route[i], route[j]))
-                pair_together[pair] += val
-
-    # Find pairs that are already constrained
-    constrained_pairs: set[tuple[int, int]] = set()
-    for decision in existing_decisions:
-        pair = (min(decision.item_i, decision.item_j),
-                max(decision.item_i, decision.item_j))
-        constrained_pairs.add(pair)
-
-    # Find best fractional pair
-    best_pair = None
-    best_score = -1.0
-
-    for pair, together in pair_together.items():
-        if pair in constrained_pairs:
-            continue
-
-        # Skip if not fractional
-        if together < 0.01 or together > 0.99:
-            continue
-
-        # Score: prefer balanced splits (together close to 0.5)
-        score = 1.0 - abs(together - 0.5) * 2
-
-        if score > best_score:
-            best_score = score
-            best_pair = (pair[0], pair[1], together)
-
-    return best_pair
+        items.extend(route)
+        offsets.append(len(items))
+        values.append(val)
+
+    # Pairs already decided, directly or through transitivity
+    closure = RyanFosterClosure([
+        BranchingDecision.ryan_foster(d.item_i, d.item_j, d.same_column)
+        for d in existing_decisions
+    ])
+
+    # Most balanced fractional pair (together closest to 0.5), scored natively
+    scorer = RyanFosterPairScorer(min_pair_value=0.01)
+    best = scorer.score(offsets, items, values, k=1, closure=closure)
+    if len(best["score"]) == 0:
+        return None
+    return int(best["item_i"][0]), int(best["item_j"][0]), float(best["together"][0])
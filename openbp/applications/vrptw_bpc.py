@@ -19,6 +19,7 @@ from dataclasses import dataclass
 from itertools import combinations
 from typing import Any, Optional
 
+from openbp._core import BranchingDecision, RyanFosterClosure, RyanFosterPairScorer
 from openbp.solver import BPSolution, BPStatus
 
 
@@ -654,40 +655,23 @@ def _find_ryan_foster_pair(
     existing_decisions: list[RyanFosterDecision],
 ) -> Optional[tuple[int, int, float]]:
     """Find the best item pair for Ryan-Foster branching."""
-    pair_together: dict[tuple[int, int], float] = defaultdict(float)
-    all_items: set[int] = set()
-
+    offsets = [0]
+    items: list[int] = []
+    values: list[float] = []
     for route, val in zip(routes, route_values):
         if val < 1e-9:
             continue
-
-        all_items.update(route)
-
-        for i in range(len(route)):
-            for j in range(i + 1, len(route)):
-                pair = (min(route[i], route[j]), max(route[i], route[j]))
-                pair_together[pair] += val
-
-    constrained_pairs: set[tuple[int, int]] = set()
-    for decision in existing_decisions:
-        pair = (min(decision.item_i, decision.item_j),
-                max(decision.item_i, decision.item_j))
-        constrained_pairs.add(pair)
-
-    best_pair = None
-    best_score = -1.0
-
-    for pair, together in pair_together.items():
-        if pair in constrained_pairs:
-            continue
-
-        if together < 0.01 or together > 0.99:
-            continue
-
-        score = 1.0 - abs(together - 0.5) * 2
-
-        if score > best_score:
-            best_score = score
-            best_pair = (pair[0], pair[1], together)
-
-    return best_pair
+        items.extend(route)
+        offsets.append(len(items))
+        values.append(val)
+
+    closure = RyanFosterClosure([
+        BranchingDecision.ryan_foster(d.item_i, d.item_j, d.same_column)
+        for d in existing_decisions
+    ])
+
+    scorer = RyanFosterPairScorer(min_pair_value=0.01)
+    best = scorer.score(offsets, items, values, k=1, closure=closure)
+    if len(best["score"]) == 0:
+        return None
+    return int(best["item_i"][0]), int(best["item_j"][0]), float(best["together"][0])
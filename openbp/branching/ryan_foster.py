@@ -14,15 +14,15 @@ Reference:
     to Scheduling. Computer Scheduling of Public Transport, 269-280.
 """
 
-from collections import defaultdict
 from dataclasses import dataclass
 
 from openbp.branching.base import BranchingCandidate, BranchingStrategy
 
 try:
-    from openbp._core import BranchingDecision, BranchType
+    from openbp._core import BranchingDecision, BranchType, RyanFosterPairScorer
 except ImportError:
     from openbp.core.node import BranchingDecision, BranchType
+    from openbp.core.pair_scoring import RyanFosterPairScorer
 
 
 @dataclass
@@ -91,6 +91,8 @@ class RyanFosterBranching(BranchingStrategy):
         """
         Find item pairs with fractional overlap.
 
+        Pairs already decided on the path to the node are skipped.
+
         Args:
             node: Current B&P node
             columns: Columns in the LP
@@ -100,65 +102,33 @@ class RyanFosterBranching(BranchingStrategy):
         Returns:
             List of branching candidates sorted by score
         """
-        # Compute pair overlap values
-        pair_together: dict[tuple[int, int], float] = defaultdict(float)
-        pair_apart: dict[tuple[int, int], float] = defaultdict(float)
-        all_items: set[int] = set()
-
+        # Columns with a positive LP value, as CSR coverage
+        offsets = [0]
+        items: list[int] = []
+        values: list[float] = []
         for col, val in zip(columns, column_values):
             if val < 1e-9:
                 continue
+            items.extend(col.covered_items)
+            offsets.append(len(items))
+            values.append(val)
+
+        # Best fractional pairs, skipping pairs the node's decisions already
+        # fix (directly or through transitivity), which would produce a
+        # duplicate and an infeasible child
+        scorer = RyanFosterPairScorer(min_pair_value=self.config.min_pair_value)
+        best = scorer.score(
+            offsets, items, values,
+            k=self.config.max_candidates,
+            closure=node.ryan_foster_closure(),
+        )
 
-            items = list(col.covered_items)
-            all_items.update(items)
-
-            # Items in this column are "together"
-            for i in range(len(items)):
-                for j in range(i + 1, len(items)):
-                    pair = (min(items[i], items[j]), max(items[i], items[j]))
-                    pair_together[pair] += val
-
-        # For "apart", we need items that appear separately
-        # Item i appears in column c but j doesn't
-        item_to_columns: dict[int, list[tuple[int, float]]] = defaultdict(list)
-        for idx, (col, val) in enumerate(zip(columns, column_values)):
-            if val < 1e-9:
-                continue
-            for item in col.covered_items:
-                item_to_columns[item].append((idx, val))
-
-        # Compute apart values
-        all_items_list = sorted(all_items)
-        for i in range(len(all_items_list)):
-            for j in range(i + 1, len(all_items_list)):
-                item_i, item_j = all_items_list[i], all_items_list[j]
-                pair = (item_i, item_j)
-
-                # Columns containing i but not j, and vice versa
-                cols_i = {idx for idx, _ in item_to_columns[item_i]}
-                cols_j = {idx for idx, _ in item_to_columns[item_j]}
-
-                # i without j
-                for idx, val in item_to_columns[item_i]:
-                    if idx not in cols_j:
-                        pair_apart[pair] += val
-
-                # j without i
-                for idx, val in item_to_columns[item_j]:
-                    if idx not in cols_i:
-                        pair_apart[pair] += val
-
-        # Find fractional pairs
         candidates = []
-        for pair, together in pair_together.items():
-            apart = pair_apart.get(pair, 0.0)
-            together + apart
-
-            # Skip if no fractional overlap
-            if together < self.config.min_pair_value:
-                continue
-            if together > 1.0 - self.config.min_pair_value:
-                continue
+        for item_i, item_j, together, apart in zip(
+            best["item_i"], best["item_j"], best["together"], best["apart"]
+        ):
+            item_i, item_j = int(item_i), int(item_j)
+            together, apart = float(together), float(apart)
 
             # Score: prefer balanced splits (together close to 0.5)
             if self.config.prefer_fractional:
@@ -166,9 +136,6 @@ class RyanFosterBranching(BranchingStrategy):
             else:
                 score = min(together, 1.0 - together)
 
-            # Create branching decisions
-            item_i, item_j = pair
-
             # Same branch: i and j must be together
             same_decision = BranchingDecision.ryan_foster(item_i, item_j, True)
 
@@ -188,9 +155,7 @@ class RyanFosterBranching(BranchingStrategy):
             )
             candidates.append(candidate)
 
-        # Sort by score and limit
-        candidates.sort(key=lambda c: c.score, reverse=True)
-        return candidates[: self.config.max_candidates]
+        return candidates
 
     def filter_columns(
         self,
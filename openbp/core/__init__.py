@@ -10,15 +10,33 @@ from openbp.core.node import (
     BranchingDecision,
     BranchType,
     NodeStatus,
+    RyanFosterClosure,
 )
+from openbp.core.column_pool import ColumnFilter, ColumnPool, NodeColumnSets
+from openbp.core.pair_scoring import RyanFosterPairScorer
 from openbp.core.selection import (
     BestEstimateSelector,
     BestFirstSelector,
     DepthFirstSelector,
     HybridSelector,
     NodeSelector,
+    WorkStealingSelector,
     create_selector,
 )
+from openbp.core.parallel import (
+    IncumbentRegister,
+    NodeResult,
+    ParallelConfig,
+    ParallelResult,
+    ParallelSolver,
+    ParallelStatus,
+    PortfolioConfig,
+    PortfolioResult,
+    PortfolioSolver,
+    RacerResult,
+    apply_round,
+    select_round,
+)
 from openbp.core.tree import BPTree, TreeStats
 
 __all__ = [
@@ -26,6 +44,8 @@ __all__ = [
     "NodeStatus",
     "BranchType",
     "BranchingDecision",
+    "RyanFosterClosure",
+    "RyanFosterPairScorer",
     "BPTree",
     "TreeStats",
     "NodeSelector",
@@ -33,5 +53,21 @@ __all__ = [
     "DepthFirstSelector",
     "BestEstimateSelector",
     "HybridSelector",
+    "WorkStealingSelector",
     "create_selector",
+    "NodeResult",
+    "ParallelConfig",
+    "ParallelStatus",
+    "ParallelResult",
+    "ParallelSolver",
+    "PortfolioConfig",
+    "PortfolioResult",
+    "PortfolioSolver",
+    "RacerResult",
+    "IncumbentRegister",
+    "select_round",
+    "apply_round",
+    "ColumnPool",
+    "ColumnFilter",
+    "NodeColumnSets",
 ]
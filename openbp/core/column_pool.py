@@ -0,0 +1,336 @@
+"""
+Pure Python implementation of the column pool, column filter and
+per-node column sets.
+
+This is a fallback when the C++ module is not available. Coverage is kept
+as one integer bitmask per column and duplicates are found through a dict
+keyed by (bitmask, arcs), so add() is O(1) expected like the C++ pool.
+"""
+
+from collections.abc import Iterable
+from typing import Optional
+
+from openbp.core.node import BPNode, BranchingDecision, BranchType
+
+
+class ColumnPool:
+    """Deduplicating pool of columns (cost, coverage, arc sequence)."""
+
+    def __init__(self, num_items: int = 0):
+        if num_items < 0:
+            raise ValueError("num_items must be non-negative")
+        self._num_items = num_items
+        self._costs: list[float] = []
+        self._masks: list[int] = []
+        self._arcs: list[tuple[int, ...]] = []
+        self._index: dict[tuple[int, tuple[int, ...]], int] = {}
+
+    @staticmethod
+    def _encode(items: Iterable[int]) -> tuple[int, int]:
+        """Return (bitmask, max item) and reject negative items."""
+        mask = 0
+        max_item = -1
+        for item in items:
+            item = int(item)
+            if item < 0:
+                raise IndexError(f"item index {item} is negative")
+            mask |= 1 << item
+            max_item = max(max_item, item)
+        return mask, max_item
+
+    # =========================================================================
+    # Insertion and lookup
+    # =========================================================================
+
+    def add(
+        self, cost: float, items: Iterable[int], arcs: Optional[Iterable[int]] = None
+    ) -> tuple[int, bool]:
+        """Add a column; returns (index, inserted)."""
+        mask, max_item = self._encode(items)
+        key = (mask, tuple(int(a) for a in arcs) if arcs is not None else ())
+        index = self._index.get(key)
+        if index is not None:
+            return index, False
+
+        index = len(self._costs)
+        self._index[key] = index
+        self._costs.append(float(cost))
+        self._masks.append(mask)
+        self._arcs.append(key[1])
+        self._num_items = max(self._num_items, max_item + 1)
+        return index, True
+
+    def add_batch(self, costs, item_offsets, items, arc_offsets=None, arcs=None):
+        """Add many columns given in CSR form; returns their pool indices."""
+        if (arc_offsets is None) != (arcs is None):
+            raise ValueError("add_batch: pass both arc_offsets and arcs, or neither")
+        costs = list(costs)
+        item_offsets = [int(k) for k in item_offsets]
+        items = list(items)
+        if arc_offsets is None:
+            arc_offsets, arcs = [0] * (len(costs) + 1), []
+        arc_offsets = [int(k) for k in arc_offsets]
+        arcs = list(arcs)
+        for what, offsets, data in (("item", item_offsets, items), ("arc", arc_offsets, arcs)):
+            if (len(offsets) != len(costs) + 1 or offsets[0] != 0 or offsets[-1] != len(data)
+                    or any(a > b for a, b in zip(offsets, offsets[1:]))):
+                raise ValueError(f"add_batch: invalid {what} offsets")
+
+        indices = [
+            self.add(cost,
+                     items[item_offsets[k]:item_offsets[k + 1]],
+                     arcs[arc_offsets[k]:arc_offsets[k + 1]])[0]
+            for k, cost in enumerate(costs)
+        ]
+        try:
+            import numpy as np
+        except ImportError:
+            return indices
+        return np.array(indices, dtype=np.int64)
+
+    def find(self, items: Iterable[int], arcs: Optional[Iterable[int]] = None) -> int:
+        """Index of the column with this signature, or -1."""
+        mask, _ = self._encode(items)
+        key = (mask, tuple(int(a) for a in arcs) if arcs is not None else ())
+        return self._index.get(key, -1)
+
+    def contains(self, items: Iterable[int], arcs: Optional[Iterable[int]] = None) -> bool:
+        """Check whether a column with this signature is pooled."""
+        return self.find(items, arcs) >= 0
+
+    # =========================================================================
+    # Column access
+    # =========================================================================
+
+    def cost(self, index: int) -> float:
+        return self._costs[index]
+
+    def items(self, index: int) -> list[int]:
+        mask = self._masks[index]
+        return [i for i in range(mask.bit_length()) if (mask >> i) & 1]
+
+    def arcs(self, index: int) -> list[int]:
+        return list(self._arcs[index])
+
+    def covers(self, index: int, item: int) -> bool:
+        return item >= 0 and bool((self._masks[index] >> item) & 1)
+
+    @property
+    def num_items(self) -> int:
+        return self._num_items
+
+    @property
+    def words_per_column(self) -> int:
+        return (self._num_items + 63) // 64
+
+    def costs(self):
+        import numpy as np
+
+        return np.array(self._costs, dtype=np.float64)
+
+    def coverage(self):
+        """Coverage bitsets as a (len(pool), words_per_column) uint64 array."""
+        import numpy as np
+
+        words = self.words_per_column
+        result = np.zeros((len(self._masks), words), dtype=np.uint64)
+        for row, mask in enumerate(self._masks):
+            for w in range(words):
+                result[row, w] = (mask >> (64 * w)) & 0xFFFFFFFFFFFFFFFF
+        return result
+
+    def arc_offsets(self):
+        import numpy as np
+
+        offsets = [0]
+        for arcs in self._arcs:
+            offsets.append(offsets[-1] + len(arcs))
+        return np.array(offsets, dtype=np.int64)
+
+    def arc_indices(self):
+        import numpy as np
+
+        return np.array([a for arcs in self._arcs for a in arcs], dtype=np.int32)
+
+    # =========================================================================
+    # Capacity
+    # =========================================================================
+
+    def reserve(self, num_columns: int, num_arcs: int = 0) -> None:
+        """No-op (Python lists grow on demand)."""
+
+    def reserve_items(self, num_items: int) -> None:
+        self._num_items = max(self._num_items, num_items)
+
+    def clear(self) -> None:
+        self._costs.clear()
+        self._masks.clear()
+        self._arcs.clear()
+        self._index.clear()
+
+    def memory_usage(self) -> int:
+        import sys
+
+        return (sys.getsizeof(self._costs) + sys.getsizeof(self._masks)
+                + sys.getsizeof(self._arcs) + sys.getsizeof(self._index))
+
+    def __len__(self) -> int:
+        return len(self._costs)
+
+    def __repr__(self) -> str:
+        return f"<ColumnPool columns={len(self)} items={self._num_items}>"
+
+
+class ColumnFilter:
+    """Branching decisions compiled into bitmask tests over a ColumnPool."""
+
+    simd_available = False
+
+    def __init__(self, decisions: Iterable[BranchingDecision] = ()):
+        self._pairs: list[tuple[int, int, bool]] = []
+        self._required_arcs: set[int] = set()
+        self._forbidden_arcs: set[int] = set()
+        self._skipped = 0
+        for decision in decisions:
+            self.add(decision)
+
+    @staticmethod
+    def for_node(node: BPNode) -> "ColumnFilter":
+        """Filter enforcing every decision on the path to node."""
+        return ColumnFilter(node.all_decisions())
+
+    def add(self, decision: BranchingDecision) -> bool:
+        """Add a decision; returns True if it is enforced."""
+        if decision.type == BranchType.RYAN_FOSTER:
+            i, j = decision.item_i, decision.item_j
+            if i < 0 or j < 0:
+                return False
+            if not (decision.same_column and i == j):
+                self._pairs.append((1 << i, 1 << j, decision.same_column))
+            return True
+        if decision.type == BranchType.ARC:
+            if decision.source_node >= 0:
+                self._skipped += 1
+                return False
+            if decision.arc_required:
+                self._required_arcs.add(decision.arc_index)
+            else:
+                self._forbidden_arcs.add(decision.arc_index)
+            return True
+        return False
+
+    @property
+    def num_tests(self) -> int:
+        return len(self._pairs) + len(self._required_arcs) + len(self._forbidden_arcs)
+
+    @property
+    def num_skipped(self) -> int:
+        return self._skipped
+
+    def set_use_simd(self, use: bool) -> None:
+        """No-op (there is no vector kernel in Python)."""
+
+    def accepts(self, pool: ColumnPool, index: int) -> bool:
+        mask = pool._masks[index]
+        for bit_i, bit_j, same in self._pairs:
+            has_i = bool(mask & bit_i)
+            has_j = bool(mask & bit_j)
+            if (has_i != has_j) if same else (has_i and has_j):
+                return False
+        if self._required_arcs or self._forbidden_arcs:
+            arcs = set(pool._arcs[index])
+            if arcs & self._forbidden_arcs or not self._required_arcs <= arcs:
+                return False
+        return True
+
+    def indices(self, pool: ColumnPool, begin: int = 0) -> list[int]:
+        """Pool indices of valid columns in [begin, len(pool))."""
+        return [k for k in range(begin, len(pool)) if self.accepts(pool, k)]
+
+    def mask(self, pool: ColumnPool, begin: int = 0):
+        """Bool array over columns [begin, len(pool))."""
+        import numpy as np
+
+        return np.array([self.accepts(pool, k) for k in range(begin, len(pool))], dtype=bool)
+
+    def __repr__(self) -> str:
+        return f"<ColumnFilter tests={self.num_tests} skipped={self._skipped}>"
+
+
+class NodeColumnSets:
+    """Cache of valid-column sets for the open nodes of a tree."""
+
+    def __init__(self, pool: ColumnPool):
+        self._pool = pool
+        self._sets: dict[int, tuple[list[int], int]] = {}  # id -> (indices, limit)
+        self._tree = None
+
+    def _drop_pruned(self) -> None:
+        # The Python tree has no listeners: look up pruned nodes instead
+        if self._tree is None:
+            return
+        for node_id in list(self._sets):
+            node = self._tree.node(node_id)
+            if node is None or node.is_pruned:
+                del self._sets[node_id]
+
+    def _derive(self, node: BPNode, base: list[int], limit: int, decisions) -> list[int]:
+        local = ColumnFilter(decisions)
+        valid = [k for k in base if local.accepts(self._pool, k)]
+        return valid + ColumnFilter.for_node(node).indices(self._pool, begin=limit)
+
+    def get(self, node: BPNode) -> list[int]:
+        """Pool indices of the node's valid columns over the whole pool."""
+        self._drop_pruned()
+        size = len(self._pool)
+        cached = self._sets.get(node.id)
+        if cached is not None and cached[1] == size:
+            return list(cached[0])
+
+        if cached is not None:
+            valid = self._derive(node, cached[0], cached[1], ())
+        elif node.parent_id in self._sets:
+            base, limit = self._sets[node.parent_id]
+            valid = self._derive(node, base, limit, node.local_decisions)
+        else:
+            valid = ColumnFilter.for_node(node).indices(self._pool)
+        self._sets[node.id] = (valid, size)
+        return list(valid)
+
+    def count(self, node: BPNode) -> int:
+        return len(self.get(node))
+
+    def branch(self, parent: BPNode, children: list[BPNode]) -> None:
+        """Derive the children's sets from the parent's, then drop the parent's."""
+        base = self.get(parent)
+        for child in children:
+            self._sets[child.id] = (
+                self._derive(child, base, len(self._pool), child.local_decisions),
+                len(self._pool),
+            )
+        self.release(parent.id)
+
+    def release(self, node_id: int) -> None:
+        self._sets.pop(node_id, None)
+
+    def is_cached(self, node_id: int) -> bool:
+        return node_id in self._sets
+
+    def attach(self, tree) -> None:
+        """Drop sets of nodes the tree prunes."""
+        self._tree = tree
+
+    def detach(self, tree) -> None:
+        if self._tree is tree:
+            self._tree = None
+
+    def clear(self) -> None:
+        self._sets.clear()
+
+    def memory_usage(self) -> int:
+        import sys
+
+        return sum(sys.getsizeof(indices) for indices, _ in self._sets.values())
+
+    def __len__(self) -> int:
+        return len(self._sets)
@@ -98,6 +98,96 @@ class BranchingDecision:
         )
 
 
+class RyanFosterClosure:
+    """Transitive closure of Ryan-Foster decisions on a path.
+
+    "Same" decisions merge items into classes (union-find); "different"
+    decisions keep two classes apart. The closure is infeasible once a
+    class must be apart from itself.
+    """
+
+    def __init__(self, decisions=()):
+        self._parent: dict[int, int] = {}
+        self._apart: dict[int, set[int]] = {}  # root -> roots it must avoid
+        self._feasible = True
+        for decision in decisions:
+            self.add(decision)
+
+    def _find(self, item: int) -> int:
+        parent = self._parent
+        root = item
+        while parent.get(root, root) != root:
+            root = parent[root]
+        while item != root:
+            parent[item], item = root, parent[item]
+        return root
+
+    def _intern(self, item: int) -> int:
+        self._parent.setdefault(item, item)
+        return self._find(item)
+
+    def add(self, decision: BranchingDecision) -> bool:
+        """Merge one decision; returns False if the closure is infeasible."""
+        i, j = decision.item_i, decision.item_j
+        if decision.type != BranchType.RYAN_FOSTER or i < 0 or j < 0:
+            return self._feasible
+        a, b = self._intern(i), self._intern(j)
+        if decision.same_column:
+            if a != b:
+                apart_a = self._apart.pop(a, set())
+                apart_b = self._apart.pop(b, set())
+                if b in apart_a:
+                    self._feasible = False
+                self._parent[b] = a
+                merged = (apart_a | apart_b) - {a, b}
+                for other in merged:
+                    links = self._apart[other]
+                    links.discard(b)
+                    links.add(a)
+                if merged:
+                    self._apart[a] = merged
+        elif a == b:
+            self._feasible = False
+        else:
+            self._apart.setdefault(a, set()).add(b)
+            self._apart.setdefault(b, set()).add(a)
+        return self._feasible
+
+    @property
+    def feasible(self) -> bool:
+        return self._feasible
+
+    @property
+    def num_items(self) -> int:
+        return len(self._parent)
+
+    def representative(self, item: int) -> int:
+        return self._find(item) if item in self._parent else item
+
+    def together(self, i: int, j: int) -> bool:
+        return i == j or (i in self._parent and j in self._parent
+                          and self._find(i) == self._find(j))
+
+    def apart(self, i: int, j: int) -> bool:
+        if i not in self._parent or j not in self._parent:
+            return False
+        return self._find(j) in self._apart.get(self._find(i), ())
+
+    def implied(self, i: int, j: int) -> bool:
+        return self.together(i, j) or self.apart(i, j)
+
+    def implied_pairs(self, same: bool) -> list[tuple[int, int]]:
+        """Sorted decided pairs (i < j) that are together (same) or apart."""
+        items = sorted(self._parent)
+        return [
+            (i, j) for k, i in enumerate(items) for j in items[k + 1:]
+            if (self.together(i, j) if same else self.apart(i, j))
+        ]
+
+    def __repr__(self) -> str:
+        return f"<RyanFosterClosure items={self.num_items} feasible={self._feasible}>"
+
+
 @dataclass
 class BPNode:
     """A node in the branch-and-price tree."""
@@ -166,6 +256,15 @@ class BPNode:
         """Get all branching decisions."""
         return self.inherited_decisions + self.local_decisions
 
+    def ryan_foster_closure(self) -> RyanFosterClosure:
+        """Ryan-Foster closure of the node's decision path."""
+        return RyanFosterClosure(self.all_decisions())
+
+    @property
+    def ryan_foster_feasible(self) -> bool:
+        """Whether the Ryan-Foster decisions on the path are consistent."""
+        return self.ryan_foster_closure().feasible
+
     def add_local_decision(self, decision: BranchingDecision) -> None:
         """Add a local branching decision."""
         self.local_decisions.append(decision)
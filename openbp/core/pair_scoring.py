@@ -0,0 +1,93 @@
+"""
+Pure Python implementation of Ryan-Foster pair scoring.
+
+This is a fallback when the C++ module is not available. Pair masses are
+accumulated in a dict, in the same order and with the same arithmetic as
+the C++ scorer, so both return the same pairs.
+"""
+
+import heapq
+from collections import defaultdict
+from typing import Optional
+
+from openbp.core.node import RyanFosterClosure
+
+
+class RyanFosterPairScorer:
+    """Scores Ryan-Foster branching pairs from an LP solution (CSR columns)."""
+
+    def __init__(self, min_pair_value: float = 0.01, min_column_value: float = 1e-9):
+        self._min_pair_value = min_pair_value
+        self._min_column_value = min_column_value
+        self._num_pairs = 0
+
+    def score(
+        self,
+        item_offsets,
+        items,
+        values,
+        k: int = 1,
+        closure: Optional[RyanFosterClosure] = None,
+    ) -> dict:
+        """Return the best k pairs as a dict of equally long arrays, best first."""
+        offsets = [int(o) for o in item_offsets]
+        items = [int(i) for i in items]
+        values = [float(v) for v in values]
+        if (len(offsets) != len(values) + 1 or offsets[0] != 0 or offsets[-1] != len(items)
+                or any(a > b for a, b in zip(offsets, offsets[1:]))):
+            raise ValueError("offsets must have len(values) + 1 entries, start at 0, "
+                             "end at the number of items and be non-decreasing")
+        if any(i < 0 for i in items):
+            raise IndexError("item indices must be non-negative")
+
+        together: dict[tuple[int, int], float] = defaultdict(float)
+        item_mass: dict[int, float] = defaultdict(float)
+        for c, value in enumerate(values):
+            if value <= self._min_column_value:
+                continue
+            column = sorted(set(items[offsets[c]:offsets[c + 1]]))
+            for a, i in enumerate(column):
+                item_mass[i] += value
+                for j in column[a + 1:]:
+                    together[i, j] += value
+        self._num_pairs = len(together)
+
+        low, high = self._min_pair_value, 1.0 - self._min_pair_value
+        candidates = (
+            (1.0 - abs(mass - 0.5) * 2.0, pair, mass)
+            for pair, mass in together.items()
+            if low <= mass <= high and not (closure is not None and closure.implied(*pair))
+        )
+        best = heapq.nsmallest(k, candidates, key=lambda c: (-c[0], c[1]))
+
+        columns = {
+            "item_i": [pair[0] for _, pair, _ in best],
+            "item_j": [pair[1] for _, pair, _ in best],
+            "together": [mass for _, _, mass in best],
+            "apart": [item_mass[i] + item_mass[j] - 2.0 * mass for _, (i, j), mass in best],
+            "score": [score for score, _, _ in best],
+        }
+        try:
+            import numpy as np
+        except ImportError:
+            return columns
+        return {
+            name: np.array(data, dtype=np.int32 if name.startswith("item") else np.float64)
+            for name, data in columns.items()
+        }
+
+    @property
+    def num_pairs(self) -> int:
+        """Distinct pairs seen by the last call."""
+        return self._num_pairs
+
+    @property
+    def min_pair_value(self) -> float:
+        return self._min_pair_value
+
+    @property
+    def min_column_value(self) -> float:
+        return self._min_column_value
+
+    def __repr__(self) -> str:
+        return f"<RyanFosterPairScorer min_pair_value={self._min_pair_value}>"
@@ -0,0 +1,459 @@
+"""
+Pure Python implementation of the parallel B&P driver.
+
+This is a fallback when the C++ module is not available. It has the same
+interface as the C++ ParallelSolver but evaluates nodes on the calling
+thread; num_threads is accepted and ignored. Deterministic mode uses the
+same rounds as the C++ driver, so both explore the same tree.
+"""
+
+import os
+import time
+from dataclasses import dataclass, field
+from enum import Enum, auto
+from typing import Callable
+
+from openbp.core.node import BPNode, BranchingDecision, NodeStatus
+from openbp.core.selection import NodeSelector, create_selector
+from openbp.core.tree import BPTree
+
+PRUNE_TOLERANCE = 1e-6
+
+
+@dataclass
+class NodeResult:
+    """Outcome of evaluating one node, returned by a node processor."""
+    status: NodeStatus = NodeStatus.BRANCHED
+    lower_bound: float = float("-inf")
+    lp_value: float = float("inf")
+    branches: list[BranchingDecision] = field(default_factory=list)
+    solution: list[float] = field(default_factory=list)
+
+    @staticmethod
+    def branch(
+        lower_bound: float, lp_value: float, branches: list[BranchingDecision]
+    ) -> "NodeResult":
+        return NodeResult(NodeStatus.BRANCHED, lower_bound, lp_value, list(branches))
+
+    @staticmethod
+    def integer(lp_value: float, solution: list[float] = ()) -> "NodeResult":
+        return NodeResult(NodeStatus.INTEGER, lp_value, lp_value, solution=list(solution))
+
+    @staticmethod
+    def infeasible() -> "NodeResult":
+        return NodeResult(NodeStatus.PRUNED_INFEASIBLE)
+
+    @staticmethod
+    def fathomed(lower_bound: float) -> "NodeResult":
+        return NodeResult(NodeStatus.FATHOMED, lower_bound, lower_bound)
+
+
+def apply_node_result(
+    tree: BPTree, node: BPNode, r: NodeResult
+) -> tuple[bool, list[BPNode]]:
+    """
+    Apply an evaluated node to its tree.
+
+    Returns whether the node became the new incumbent, and the children
+    created by branching.
+    Pruning the rest of the tree against a new incumbent is left to the
+    caller (BPTree.prune_if_pending()).
+    """
+    if r.status == NodeStatus.PRUNED_INFEASIBLE:
+        tree.mark_processed(node, NodeStatus.PRUNED_INFEASIBLE)
+        return False, []
+
+    node.lower_bound = max(node.lower_bound, r.lower_bound)
+    node.lp_value = r.lp_value
+
+    if r.status == NodeStatus.INTEGER:
+        node.is_integer = True
+        node.set_solution(r.solution)
+        tree.mark_processed(node, NodeStatus.INTEGER)
+        if node.lp_value < tree.global_upper_bound:
+            tree.set_incumbent(node)
+            return True, []
+    elif node.lower_bound >= tree.global_upper_bound - PRUNE_TOLERANCE:
+        tree.mark_processed(node, NodeStatus.PRUNED_BOUND)
+    elif r.status != NodeStatus.BRANCHED or not r.branches:
+        tree.mark_processed(node, NodeStatus.FATHOMED)
+    else:
+        return False, tree.create_children(node, r.branches)
+    return False, []
+
+
+class IncumbentRegister:
+    """
+    Shared best known upper bound.
+
+    Mirrors the C++ lock-free register: offer() keeps the minimum and
+    bumps the epoch on every improvement; readers compare epochs.
+    """
+
+    def __init__(self):
+        self.reset()
+
+    def offer(self, value: float, source: int = -1) -> bool:
+        """Offer a solution value; True if it improved the upper bound."""
+        if not value < self._upper_bound:
+            return False
+        self._upper_bound = value
+        self._source = source
+        self._epoch += 1
+        return True
+
+    @property
+    def upper_bound(self) -> float:
+        return self._upper_bound
+
+    @property
+    def epoch(self) -> int:
+        return self._epoch
+
+    @property
+    def source(self) -> int:
+        return self._source
+
+    def reset(self) -> None:
+        self._upper_bound = float("inf")
+        self._source = -1
+        self._epoch = 0
+
+
+def select_round(tree: BPTree, selector: NodeSelector, max_nodes: int) -> list[BPNode]:
+    """Take up to max_nodes explorable nodes from the selector and claim them."""
+    batch = []
+    while len(batch) < max_nodes:
+        node = selector.select_next()
+        if node is None:
+            break
+        if tree.begin_processing(node):
+            batch.append(node)
+    return batch
+
+
+_STATUS_CODES = list(NodeStatus)  # Integer codes follow the C++ enum (0-based)
+
+
+def apply_round(
+    tree: BPTree,
+    selector: NodeSelector,
+    nodes: list[BPNode],
+    results_or_statuses,
+    lower_bounds=None,
+    lp_values=None,
+    branches=(),
+    solutions=(),
+) -> int:
+    """
+    Apply a round of node results, in node order.
+
+    Takes either one NodeResult per node, or parallel sequences of
+    statuses (NodeStatus or C++ integer codes), lower bounds and LP
+    values plus optional per-node branches and solutions. Returns the
+    number of new incumbents.
+    """
+    if lower_bounds is None:
+        results = list(results_or_statuses)
+    else:
+        statuses = list(results_or_statuses)
+        n = len(nodes)
+        if len(statuses) != n or len(lower_bounds) != n or len(lp_values) != n:
+            raise ValueError("apply_round: one status, lower bound and LP value per node")
+        if (len(branches) and len(branches) != n) or (len(solutions) and len(solutions) != n):
+            raise ValueError("apply_round: branches and solutions must be empty or per node")
+        results = []
+        for k in range(n):
+            status = statuses[k]
+            if not isinstance(status, NodeStatus):
+                status = _STATUS_CODES[int(status)]
+            results.append(NodeResult(
+                status,
+                float(lower_bounds[k]),
+                float(lp_values[k]),
+                list(branches[k]) if len(branches) else [],
+                list(solutions[k]) if len(solutions) else [],
+            ))
+    if len(results) != len(nodes):
+        raise ValueError("apply_round: one result per node required")
+
+    improved = 0
+    for node, r in zip(nodes, results):
+        became_incumbent, children = apply_node_result(tree, node, r)
+        improved += became_incumbent
+        selector.add_nodes(children)
+    if improved:
+        selector.on_bound_update(tree.global_upper_bound)
+    tree.prune_if_pending()
+    return improved
+
+
+@dataclass
+class ParallelConfig:
+    """Configuration of ParallelSolver."""
+    num_threads: int = field(default_factory=lambda: os.cpu_count() or 1)
+    deterministic: bool = False
+    round_size: int = 32  # Deterministic mode: nodes per round
+    max_nodes: int = 0  # 0 = unlimited
+    time_limit: float = float("inf")
+    gap_tolerance: float = 1e-6
+
+
+class ParallelStatus(Enum):
+    """Why ParallelSolver stopped."""
+    COMPLETED = auto()
+    GAP_LIMIT = auto()
+    NODE_LIMIT = auto()
+    TIME_LIMIT = auto()
+    INTERRUPTED = auto()
+
+
+@dataclass
+class ParallelResult:
+    """Summary of a ParallelSolver run."""
+    status: ParallelStatus = ParallelStatus.COMPLETED
+    nodes_processed: int = 0
+    rounds: int = 0
+    elapsed: float = 0.0
+    nodes_per_worker: list[int] = field(default_factory=list)
+
+
+class ParallelSolver:
+    """Sequential stand-in for the C++ parallel driver."""
+
+    def __init__(
+        self,
+        tree: BPTree,
+        selector: NodeSelector,
+        config: ParallelConfig = None,
+    ):
+        self._tree = tree
+        self._selector = selector
+        self._config = config or ParallelConfig()
+        self._incumbent = IncumbentRegister()
+        self._seen_epoch = 0
+        self._stop = False
+
+    @property
+    def config(self) -> ParallelConfig:
+        return self._config
+
+    def share_incumbent(self, incumbent: IncumbentRegister) -> None:
+        """Exchange upper bounds through the given register."""
+        self._incumbent = incumbent
+
+    @property
+    def incumbent(self) -> IncumbentRegister:
+        return self._incumbent
+
+    def run(self, process: Callable[[BPNode, int], NodeResult]) -> ParallelResult:
+        """Explore the tree until it is complete or a limit is reached."""
+        start = time.perf_counter()
+        self._stop = False
+        result = ParallelResult(nodes_per_worker=[0])
+        tree, selector, config = self._tree, self._selector, self._config
+
+        self._incumbent.offer(tree.global_upper_bound)
+        self._seen_epoch = -1
+        self._import_bound()
+        if selector.empty() and tree.root().can_be_explored:
+            selector.add_node(tree.root())
+
+        round_size = max(1, config.round_size) if config.deterministic else 1
+        limit_hit = False
+        while not limit_hit:
+            self._import_bound()
+            tree.prune_if_pending()
+            if self._stop:
+                result.status = ParallelStatus.INTERRUPTED
+                break
+            if tree.gap() <= config.gap_tolerance:
+                result.status = ParallelStatus.GAP_LIMIT
+                break
+            if time.perf_counter() - start >= config.time_limit:
+                result.status = ParallelStatus.TIME_LIMIT
+                break
+
+            batch = []
+            while len(batch) < round_size:
+                node = selector.select_next()
+                if node is None:
+                    break
+                if not node.can_be_explored:
+                    continue  # Pruned after queuing
+                if 0 < config.max_nodes <= result.nodes_processed + len(batch):
+                    selector.add_node(node)  # Left open for a later run
+                    result.status = ParallelStatus.NODE_LIMIT
+                    limit_hit = True
+                    break
+                tree.begin_processing(node)
+                batch.append(node)
+            if not batch:
+                break
+
+            results = [process(node, 0) for node in batch]
+            for node, r in sorted(zip(batch, results), key=lambda p: p[0].id):
+                self._apply(node, r)
+            result.nodes_processed += len(batch)
+            if config.deterministic:
+                result.rounds += 1
+
+        tree.prune_if_pending()
+        result.nodes_per_worker[0] = result.nodes_processed
+        result.elapsed = time.perf_counter() - start
+        return result
+
+    def stop(self) -> None:
+        """Ask a running solve to stop."""
+        self._stop = True
+
+    def _apply(self, node: BPNode, r: NodeResult) -> None:
+        improved, children = apply_node_result(self._tree, node, r)
+        if improved:
+            self._incumbent.offer(node.lp_value, 0)
+        self._selector.add_nodes(children)
+
+    def _import_bound(self) -> None:
+        """Adopt the register's bound if it improved since the last look."""
+        if self._incumbent.epoch == self._seen_epoch:
+            return
+        self._seen_epoch = self._incumbent.epoch
+        self._tree.tighten_upper_bound(self._incumbent.upper_bound)
+        if self._tree.global_upper_bound < float("inf"):
+            self._selector.on_bound_update(self._tree.global_upper_bound)
+
+
+@dataclass
+class PortfolioConfig:
+    """Configuration of PortfolioSolver."""
+    selectors: list[str] = field(
+        default_factory=lambda: ["best_first", "depth_first", "best_estimate", "hybrid"]
+    )
+    max_nodes: int = 0  # Per racer, 0 = unlimited
+    time_limit: float = float("inf")
+    gap_tolerance: float = 1e-6
+
+
+@dataclass
+class RacerResult:
+    """Outcome of one portfolio racer."""
+    selector: str = ""
+    status: ParallelStatus = ParallelStatus.INTERRUPTED
+    nodes_processed: int = 0
+    bounds_imported: int = 0
+    lower_bound: float = float("-inf")
+
+
+@dataclass
+class PortfolioResult:
+    """Summary of a PortfolioSolver run."""
+    status: ParallelStatus = ParallelStatus.INTERRUPTED
+    winner: int = -1
+    incumbent_racer: int = -1
+    upper_bound: float = float("inf")
+    lower_bound: float = float("-inf")
+    solution: list[float] = field(default_factory=list)
+    elapsed: float = 0.0
+    racers: list[RacerResult] = field(default_factory=list)
+
+
+class PortfolioSolver:
+    """
+    Races several node selectors with a shared incumbent.
+
+    The fallback interleaves the racers on the calling thread, one node
+    per racer in turn, instead of running them on separate threads.
+    """
+
+    def __init__(self, config: PortfolioConfig = None):
+        self._config = config or PortfolioConfig()
+        if not self._config.selectors:
+            self._config.selectors = ["best_first"]
+        self._trees: list[BPTree] = []
+        self._stop = False
+
+    @property
+    def config(self) -> PortfolioConfig:
+        return self._config
+
+    @property
+    def num_racers(self) -> int:
+        return len(self._config.selectors)
+
+    def tree(self, racer: int) -> BPTree:
+        return self._trees[racer]
+
+    def stop(self) -> None:
+        self._stop = True
+
+    def run(
+        self,
+        process: Callable[[BPNode, int], NodeResult],
+        setup_root: Callable[[BPNode], None] = None,
+    ) -> PortfolioResult:
+        """Race all configured selectors until one proves optimality."""
+        start = time.perf_counter()
+        self._stop = False
+        config = self._config
+        best = PortfolioResult()
+        self._trees = [BPTree() for _ in config.selectors]
+        selectors = [create_selector(name) for name in config.selectors]
+        racers = [RacerResult(selector=name) for name in config.selectors]
+        active = list(range(self.num_racers))
+
+        for tree, selector in zip(self._trees, selectors):
+            if setup_root:
+                setup_root(tree.root())
+            selector.add_node(tree.root())
+
+        while active and best.winner < 0:
+            for r in list(active):
+                tree, selector, racer = self._trees[r], selectors[r], racers[r]
+                if tree.tighten_upper_bound(best.upper_bound):
+                    selector.on_bound_update(best.upper_bound)
+                    racer.bounds_imported += 1
+                tree.prune_if_pending()
+                racer.lower_bound = tree.global_lower_bound
+
+                done = None
+                if self._stop:
+                    done = ParallelStatus.INTERRUPTED
+                elif tree.gap() <= config.gap_tolerance:
+                    done = ParallelStatus.GAP_LIMIT
+                elif time.perf_counter() - start >= config.time_limit:
+                    done = ParallelStatus.TIME_LIMIT
+                elif 0 < config.max_nodes <= racer.nodes_processed:
+                    done = ParallelStatus.NODE_LIMIT
+                else:
+                    node = selector.select_next()
+                    if node is None:
+                        done = ParallelStatus.COMPLETED
+                    elif tree.begin_processing(node):
+                        improved, children = apply_node_result(tree, node, process(node, r))
+                        racer.nodes_processed += 1
+                        if improved:
+                            selector.on_bound_update(tree.global_upper_bound)
+                            if node.lp_value < best.upper_bound:
+                                best.upper_bound = node.lp_value
+                                best.solution = list(node.solution)
+                                best.incumbent_racer = r
+                        selector.add_nodes(children)
+
+                if done is not None:
+                    racer.status = done
+                    active.remove(r)
+                    if done in (ParallelStatus.COMPLETED, ParallelStatus.GAP_LIMIT):
+                        best.winner = r
+                        break
+
+        best.racers = racers
+        best.status = ParallelStatus.NODE_LIMIT
+        for racer in racers:
+            best.lower_bound = max(best.lower_bound, racer.lower_bound)
+            if racer.status in (ParallelStatus.TIME_LIMIT, ParallelStatus.INTERRUPTED):
+                best.status = racer.status
+        if best.winner >= 0:
+            best.status = racers[best.winner].status
+        best.lower_bound = min(best.lower_bound, best.upper_bound)
+        best.elapsed = time.perf_counter() - start
+        return best
@@ -5,6 +5,7 @@ This is a fallback when the C++ module is not available.
 """
 
 import heapq
+import os
 from abc import ABC, abstractmethod
 from typing import Optional
 
@@ -63,6 +64,18 @@ class NodeSelector(ABC):
         """Get all open node IDs."""
         pass
 
+    def is_concurrent(self) -> bool:
+        """Whether the selector is safe to use without a lock."""
+        return False
+
+    def select_for_worker(self, worker: int) -> Optional[BPNode]:
+        """Select the next node on behalf of a parallel worker."""
+        return self.select_next()
+
+    def add_nodes_for_worker(self, nodes: list[BPNode], worker: int) -> None:
+        """Add nodes created by a parallel worker."""
+        self.add_nodes(nodes)
+
     @abstractmethod
     def clear(self) -> None:
         """Clear all nodes from the selector."""
@@ -302,6 +315,99 @@ class HybridSelector(NodeSelector):
         self._diving = False
 
 
+class WorkStealingSelector(NodeSelector):
+    """Per-worker depth-first queues with bound balancing and stealing."""
+
+    def __init__(self, num_workers: int = 0, max_bound_drift: float = 0.1):
+        num_workers = num_workers if num_workers > 0 else (os.cpu_count() or 1)
+        self._locals = [DepthFirstSelector() for _ in range(num_workers)]
+        self._max_bound_drift = max_bound_drift
+        self._next_local = 0
+        self.num_steals = 0
+        self.num_balancing_picks = 0
+
+    @property
+    def num_workers(self) -> int:
+        return len(self._locals)
+
+    @property
+    def max_bound_drift(self) -> float:
+        return self._max_bound_drift
+
+    def is_concurrent(self) -> bool:
+        return True  # Trivially: the fallback driver is single-threaded
+
+    def add_node(self, node: BPNode) -> None:
+        self._locals[self._next_local % len(self._locals)].add_node(node)
+        self._next_local += 1
+
+    def add_nodes_for_worker(self, nodes: list[BPNode], worker: int) -> None:
+        self._locals[worker % len(self._locals)].add_nodes(nodes)
+
+    def select_next(self) -> Optional[BPNode]:
+        return self.select_for_worker(0)
+
+    def select_for_worker(self, worker: int) -> Optional[BPNode]:
+        own = self._locals[worker % len(self._locals)]
+        own.prune()
+        best = self._best_local()
+        if not own.empty():
+            drift = self._max_bound_drift * max(1.0, abs(best.best_bound()))
+            if best is not own and own.best_bound() - best.best_bound() > drift:
+                self.num_balancing_picks += 1
+                return self._take_best_bound(best)
+            return own.select_next()
+        if best is None:
+            return None
+        self.num_steals += 1
+        return self._take_best_bound(best)
+
+    def _best_local(self) -> Optional[DepthFirstSelector]:
+        for q in self._locals:
+            q.prune()
+        candidates = [q for q in self._locals if not q.empty()]
+        return min(candidates, key=lambda q: q.best_bound(), default=None)
+
+    @staticmethod
+    def _best_entry(queue: DepthFirstSelector) -> tuple:
+        return min(queue._heap, key=lambda e: (e[1], e[3].id))
+
+    def _take_best_bound(self, queue: DepthFirstSelector) -> BPNode:
+        entry = self._best_entry(queue)
+        queue._heap.remove(entry)
+        heapq.heapify(queue._heap)
+        return entry[3]
+
+    def local_size(self, worker: int) -> int:
+        return self._locals[worker % len(self._locals)].size()
+
+    def peek_next(self) -> Optional[BPNode]:
+        node = self._locals[0].peek_next()
+        if node is None:
+            best = self._best_local()
+            node = self._best_entry(best)[3] if best else None
+        return node
+
+    def empty(self) -> bool:
+        return all(q.empty() for q in self._locals)
+
+    def size(self) -> int:
+        return sum(q.size() for q in self._locals)
+
+    def prune(self) -> int:
+        return sum(q.prune() for q in self._locals)
+
+    def best_bound(self) -> float:
+        return min((q.best_bound() for q in self._locals), default=float("inf"))
+
+    def get_open_node_ids(self) -> list[int]:
+        return [i for q in self._locals for i in q.get_open_node_ids()]
+
+    def clear(self) -> None:
+        for q in self._locals:
+            q.clear()
+
+
 def create_selector(name: str) -> NodeSelector:
     """Create a node selector by name."""
     name_lower = name.lower()
@@ -313,4 +419,6 @@ def create_selector(name: str) -> NodeSelector:
         return BestEstimateSelector()
     elif name_lower == "hybrid":
         return HybridSelector()
+    elif name_lower in ("work_stealing", "workstealing"):
+        return WorkStealingSelector()
     return BestFirstSelector()
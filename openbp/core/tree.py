@@ -21,6 +21,7 @@ class TreeStats:
     nodes_branched: int = 0
     nodes_open: int = 0
     max_depth: int = 0
+    nodes_released: int = 0
     best_lower_bound: float = float("-inf")
     best_upper_bound: float = float("inf")
 
@@ -48,6 +49,7 @@ class BPTree:
         self._next_id = 0
         self._global_lower_bound = float("-inf")
         self._global_upper_bound = float("inf")
+        self._prune_pending = False
         self._incumbent: Optional[BPNode] = None
         self._stats = TreeStats()
 
@@ -85,7 +87,11 @@ class BPTree:
         parent: BPNode,
         decision: BranchingDecision,
     ) -> BPNode:
-        """Create a child node."""
+        """Create a child node.
+
+        A child whose Ryan-Foster decisions contradict each other is
+        created closed, as PRUNED_INFEASIBLE.
+        """
         child = BPNode(
             id=self._next_id,
             parent_id=parent.id,
@@ -101,7 +107,11 @@ class BPTree:
         self._nodes[child.id] = child
 
         self._stats.nodes_created += 1
-        self._stats.nodes_open += 1
+        if child.ryan_foster_feasible:
+            self._stats.nodes_open += 1
+        else:
+            child.status = NodeStatus.PRUNED_INFEASIBLE
+            self._stats.nodes_pruned_infeasible += 1
         if child.depth > self._stats.max_depth:
             self._stats.max_depth = child.depth
 
@@ -121,6 +131,13 @@ class BPTree:
 
         return children
 
+    def begin_processing(self, node: BPNode) -> bool:
+        """Claim a pending node for processing. Returns False if not pending."""
+        if node.status != NodeStatus.PENDING:
+            return False
+        node.status = NodeStatus.PROCESSING
+        return True
+
     def mark_processed(self, node: BPNode, new_status: NodeStatus) -> None:
         """Mark a node as processed."""
         old_status = node.status
@@ -140,8 +157,17 @@ class BPTree:
 
     @property
     def global_lower_bound(self) -> float:
-        """Global lower bound."""
-        return self._global_lower_bound
+        """
+        Global lower bound: the lowest bound among open nodes (the upper
+        bound once none is open), never below an explicitly set floor.
+
+        The C++ tree maintains this incrementally; this fallback scans.
+        """
+        lb = self._global_upper_bound
+        for node in self._nodes.values():
+            if node.status in (NodeStatus.PENDING, NodeStatus.PROCESSING):
+                lb = min(lb, node.lower_bound)
+        return max(lb, self._global_lower_bound)
 
     @global_lower_bound.setter
     def global_lower_bound(self, value: float) -> None:
@@ -168,6 +194,7 @@ class BPTree:
         if node.is_integer and node.lp_value < self._global_upper_bound:
             self._global_upper_bound = node.lp_value
             self._stats.best_upper_bound = self._global_upper_bound
+            self._prune_pending = True
             improved = True
 
         return improved
@@ -181,8 +208,31 @@ class BPTree:
                 lb = min(lb, node.lower_bound)
         return lb
 
+    def tighten_upper_bound(self, upper_bound: float) -> bool:
+        """
+        Lower the upper bound to a value found elsewhere; pruning is
+        deferred to prune_if_pending(). Returns True if it improved.
+        """
+        if not upper_bound < self._global_upper_bound:
+            return False
+        self._global_upper_bound = upper_bound
+        self._prune_pending = True
+        return True
+
+    @property
+    def prune_pending(self) -> bool:
+        """Whether the upper bound improved since the last prune_by_bound()."""
+        return self._prune_pending
+
+    def prune_if_pending(self) -> int:
+        """Run prune_by_bound() if the upper bound improved since the last pass."""
+        if not self._prune_pending:
+            return 0
+        return self.prune_by_bound()
+
     def prune_by_bound(self) -> int:
         """Prune all nodes by bound."""
+        self._prune_pending = False
         pruned = 0
         for node in self._nodes.values():
             if node.can_be_explored and node.try_prune_by_bound(self._global_upper_bound):
@@ -202,15 +252,17 @@ class BPTree:
 
     def gap(self) -> float:
         """Current optimality gap."""
-        if self._global_upper_bound == float("inf") or self._global_lower_bound == float("-inf"):
+        lower = self.global_lower_bound
+        if self._global_upper_bound == float("inf") or lower == float("-inf"):
             return float("inf")
         if abs(self._global_upper_bound) < 1e-10:
-            return 0.0 if abs(self._global_lower_bound) < 1e-10 else float("inf")
-        return (self._global_upper_bound - self._global_lower_bound) / abs(self._global_upper_bound)
+            return 0.0 if abs(lower) < 1e-10 else float("inf")
+        return (self._global_upper_bound - lower) / abs(self._global_upper_bound)
 
     @property
     def stats(self) -> TreeStats:
         """Tree statistics."""
+        self._stats.best_lower_bound = self.global_lower_bound
         return self._stats
 
     def incumbent(self) -> Optional[BPNode]:
@@ -223,6 +275,7 @@ class BPTree:
         if node:
             self._global_upper_bound = node.lp_value
             self._stats.best_upper_bound = self._global_upper_bound
+            self._prune_pending = True
 
     def get_path_to_root(self, target_id: int) -> list[int]:
         """Get node IDs from root to target."""
@@ -243,3 +296,23 @@ class BPTree:
         """Iterate over all nodes."""
         for node in self._nodes.values():
             callback(node)
+
+    def node_table(self) -> dict:
+        """
+        Export all nodes as NumPy columns, in ascending ID order.
+
+        Same layout as the C++ tree: id, parent_id, depth, lower_bound,
+        lp_value and status (the C++ NodeStatus integer codes).
+        """
+        import numpy as np
+
+        codes = {status: k for k, status in enumerate(NodeStatus)}
+        nodes = sorted(self._nodes.values(), key=lambda n: n.id)
+        return {
+            "id": np.array([n.id for n in nodes], dtype=np.int64),
+            "parent_id": np.array([n.parent_id for n in nodes], dtype=np.int64),
+            "depth": np.array([n.depth for n in nodes], dtype=np.int32),
+            "lower_bound": np.array([n.lower_bound for n in nodes], dtype=np.float64),
+            "lp_value": np.array([n.lp_value for n in nodes], dtype=np.float64),
+            "status": np.array([codes[n.status] for n in nodes], dtype=np.uint8),
+        }
@@ -10,6 +10,7 @@ Available Policies:
 - DepthFirstSelection: Dive deep before backtracking
 - BestEstimateSelection: Balance bound and depth
 - HybridSelection: Alternate between strategies
+- WorkStealingSelection: Per-worker queues for parallel search
 """
 
 from typing import Optional
@@ -21,6 +22,7 @@ try:
         DepthFirstSelector,
         HybridSelector,
         NodeSelector,
+        WorkStealingSelector,
         create_selector,
     )
     HAS_CPP_BACKEND = True
@@ -31,6 +33,7 @@ except ImportError:
         DepthFirstSelector,
         HybridSelector,
         NodeSelector,
+        WorkStealingSelector,
         create_selector,
     )
     HAS_CPP_BACKEND = False
@@ -101,16 +104,35 @@ class HybridSelection:
         return HybridSelector(dive_frequency, dive_depth)
 
 
+class WorkStealingSelection:
+    """
+    Work-stealing node selection for parallel workers.
+
+    Each worker explores its own queue depth-first, switches to the
+    global best node when its bound drifts too far behind, and steals
+    the best node from other workers when idle.
+
+    Args:
+        num_workers: Number of worker queues (default: CPU count)
+        max_bound_drift: Relative bound drift that triggers balancing
+    """
+
+    def __new__(cls, num_workers: int = 0, max_bound_drift: float = 0.1) -> NodeSelector:
+        return WorkStealingSelector(num_workers, max_bound_drift)
+
+
 __all__ = [
     "NodeSelector",
     "BestFirstSelector",
     "DepthFirstSelector",
     "BestEstimateSelector",
     "HybridSelector",
+    "WorkStealingSelector",
     "BestFirstSelection",
     "DepthFirstSelection",
     "BestEstimateSelection",
     "HybridSelection",
+    "WorkStealingSelection",
     "create_selector",
     "HAS_CPP_BACKEND",
 ]
@@ -18,11 +18,13 @@ try:
         BPNode,
         BPTree,
         BranchingDecision,
+        ColumnPool,
         NodeStatus,
         create_selector,
     )
     HAS_CPP_BACKEND = True
 except ImportError:
+    from openbp.core.column_pool import ColumnPool
     from openbp.core.node import BPNode, BranchingDecision, NodeStatus
     from openbp.core.selection import create_selector
     from openbp.core.tree import BPTree
@@ -170,6 +172,8 @@ class BranchAndPrice:
         # State
         self._tree: Optional[BPTree] = None
         self._column_pool: list[Any] = []  # Global column pool
+        self._column_index = ColumnPool()  # Signatures of pooled columns
+        self._column_buckets: list[list[Any]] = []  # Pooled columns per signature
         self._solution: Optional[BPSolution] = None
         self._start_time: float = 0.0
         self._cg_time: float = 0.0
@@ -230,7 +234,13 @@ class BranchAndPrice:
 
         # Initialize tree
         self._tree = BPTree(minimize=True)
-        self._column_pool = list(self.problem.initial_columns) if hasattr(self.problem, 'initial_columns') else []
+        self._column_pool = []
+        self._column_index = ColumnPool()
+        self._column_buckets = []
+        self._add_to_pool(getattr(self.problem, 'initial_columns', ()))
+
+        # Let the tree keep the selector in sync when it prunes nodes
+        self._selector_attached = self._attach_selector()
 
         # Add root to selector
         root = self._tree.root()
@@ -267,6 +277,17 @@ class BranchAndPrice:
         self._solution = self._build_solution(nodes_explored)
         return self._solution
 
+    def _attach_selector(self) -> bool:
+        """Attach the node selector to the tree if both are C++ objects."""
+        attach = getattr(self._tree, "attach_selector", None)
+        if attach is None:
+            return False
+        try:
+            attach(self.node_selector)
+        except TypeError:
+            return False  # Pure-Python selector: pruned lazily via prune()
+        return True
+
     def _check_termination(self, nodes_explored: int) -> bool:
         """Check if we should terminate."""
         # Time limit
@@ -303,8 +324,9 @@ class BranchAndPrice:
         node.lp_value = lp_value
         node.lower_bound = lp_value
 
-        # Check if pruned by bound
-        if node.try_prune_by_bound(self._tree.global_upper_bound):
+        # Check if pruned by bound (through the tree, so it stays consistent)
+        if lp_value >= self._tree.global_upper_bound - 1e-6:
+            self._tree.mark_processed(node, NodeStatus.PRUNED_BOUND)
             return
 
         # Check if integer
@@ -316,12 +338,13 @@ class BranchAndPrice:
             # Update incumbent
             if lp_value < self._tree.global_upper_bound:
                 self._tree.set_incumbent(node)
-                self._column_pool.extend(columns)  # Add to pool
+                self._add_to_pool(columns)
                 self.node_selector.on_bound_update(lp_value)
 
                 # Prune nodes by bound
                 self._tree.prune_by_bound()
-                self.node_selector.prune()
+                if not self._selector_attached:
+                    self.node_selector.prune()
 
             return
 
@@ -410,12 +433,36 @@ class BranchAndPrice:
 
         # Add new columns to global pool
         if self.config.column_pool_global:
-            for col in columns:
-                if col not in self._column_pool:
-                    self._column_pool.append(col)
+            self._add_to_pool(columns)
 
         return (lp_value, columns, column_values, duals)
 
+    def _add_to_pool(self, columns: Any) -> None:
+        """
+        Add columns to the global pool, skipping duplicates.
+
+        Columns with covered_items are bucketed by coverage and arc
+        sequence through the ColumnPool hash index, and a column is only a
+        duplicate if it equals one in its bucket (columns with the same
+        signature may still differ in cost or coefficients). Others fall
+        back to an equality scan of the pool.
+        """
+        for col in columns:
+            items = getattr(col, "covered_items", None)
+            if items is None:
+                if col not in self._column_pool:
+                    self._column_pool.append(col)
+                continue
+            signature, inserted = self._column_index.add(
+                col.cost, items, getattr(col, "arc_indices", None) or ()
+            )
+            if inserted:
+                self._column_buckets.append([])
+            bucket = self._column_buckets[signature]
+            if col not in bucket:
+                bucket.append(col)
+                self._column_pool.append(col)
+
     def _apply_decisions(
         self,
         master: Any,
@@ -0,0 +1,78 @@
+/**
+ * @file branching_bindings.cpp
+ * @brief pybind11 bindings for branching kernels (RyanFosterPairScorer).
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+
+#include "core/pair_scoring.hpp"
+#include "numpy_util.hpp"
+
+namespace py = pybind11;
+
+void init_branching_bindings(py::module_& m) {
+    using namespace openbp;
+
+    py::class_<RyanFosterPairScorer>(m, "RyanFosterPairScorer", R"doc(
+Scores Ryan-Foster branching pairs from an LP solution.
+
+Columns are passed in CSR form: the items of column c are
+items[item_offsets[c]:item_offsets[c+1]] and values[c] is its LP value.
+For every pair of items, "together" is the LP mass of the columns
+covering both. Pairs with together in [min_pair_value, 1 - min_pair_value]
+that the node's RyanFosterClosure does not already decide are ranked by
+1 - 2 |together - 0.5|, ties broken by the smaller pair.
+
+Pairs are accumulated in a flat buffer (a dense triangle for small item
+universes, else an open-addressing table), with the GIL released. Reuse
+one scorer across nodes to keep its buffers.
+
+Example:
+    >>> scorer = RyanFosterPairScorer()
+    >>> top = scorer.score(offsets, items, values, k=5,
+    ...                    closure=node.ryan_foster_closure())
+    >>> i, j = top["item_i"][0], top["item_j"][0]
+)doc")
+        .def(py::init<double, double>(),
+            py::arg("min_pair_value") = 0.01, py::arg("min_column_value") = 1e-9)
+
+        .def("score", [](RyanFosterPairScorer& scorer,
+                         py::array_t<int64_t, py::array::c_style | py::array::forcecast> item_offsets,
+                         py::array_t<int32_t, py::array::c_style | py::array::forcecast> items,
+                         py::array_t<double, py::array::c_style | py::array::forcecast> values,
+                         size_t k, const RyanFosterClosure* closure) {
+            auto offsets = bindings::from_numpy<int64_t>(item_offsets);
+            auto item_data = bindings::from_numpy<int32_t>(items);
+            auto value_data = bindings::from_numpy<double>(values);
+            PairScores scores;
+            {
+                py::gil_scoped_release release;
+                scores = scorer.score(offsets, item_data, value_data, k, closure);
+            }
+            py::dict result;
+            result["item_i"] = bindings::to_numpy(std::move(scores.item_i));
+            result["item_j"] = bindings::to_numpy(std::move(scores.item_j));
+            result["together"] = bindings::to_numpy(std::move(scores.together));
+            result["apart"] = bindings::to_numpy(std::move(scores.apart));
+            result["score"] = bindings::to_numpy(std::move(scores.score));
+            return result;
+        },
+        py::arg("item_offsets"), py::arg("items"), py::arg("values"),
+        py::arg("k") = 1, py::arg("closure") = py::none(),
+        R"doc(
+Return the best k pairs as a dict of equally long arrays, best first:
+item_i < item_j (int32), together, apart and score (float64). apart is
+the mass of the columns covering exactly one of the two items.
+)doc")
+
+        .def_property_readonly("num_pairs", &RyanFosterPairScorer::num_pairs,
+            "Distinct pairs seen by the last call")
+        .def_property_readonly("min_pair_value", &RyanFosterPairScorer::min_pair_value)
+        .def_property_readonly("min_column_value", &RyanFosterPairScorer::min_column_value)
+
+        .def("__repr__", [](const RyanFosterPairScorer& s) {
+            return "<RyanFosterPairScorer min_pair_value=" + std::to_string(s.min_pair_value()) + ">";
+        });
+}
@@ -0,0 +1,309 @@
+/**
+ * @file column_pool_bindings.cpp
+ * @brief pybind11 bindings for ColumnPool, ColumnFilter and NodeColumnSets.
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+
+#include "core/column_filter.hpp"
+#include "core/column_pool.hpp"
+#include "core/column_sets.hpp"
+#include "numpy_util.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace py = pybind11;
+
+namespace {
+
+using openbp::ColumnFilter;
+using openbp::ColumnPool;
+using openbp::NodeColumnSets;
+using IndexArray = py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+
+/// Item or arc indices from an array (one memcpy) or any iterable (frozenset, tuple, ...)
+std::vector<int32_t> to_indices(py::handle obj) {
+    if (py::isinstance<py::array>(obj)) {
+        return openbp::bindings::from_numpy<int32_t>(
+            py::reinterpret_borrow<py::object>(obj)
+                .cast<py::array_t<int32_t, py::array::c_style | py::array::forcecast>>());
+    }
+    std::vector<int32_t> values;
+    if (py::hasattr(obj, "__len__")) values.reserve(py::len(obj));
+    for (py::handle value : obj) values.push_back(value.cast<int32_t>());
+    return values;
+}
+
+/// Validate CSR offsets against the data length and column count
+void check_offsets(const std::vector<int64_t>& offsets, size_t num_columns, size_t data_size,
+                   const char* what) {
+    if (offsets.size() != num_columns + 1 || offsets.front() != 0 ||
+        static_cast<size_t>(offsets.back()) != data_size) {
+        throw py::value_error(std::string("add_batch: ") + what +
+                              " offsets must have len(costs) + 1 entries, start at 0 "
+                              "and end at the data length");
+    }
+    for (size_t k = 0; k < num_columns; ++k) {
+        if (offsets[k] > offsets[k + 1]) {
+            throw py::value_error(std::string("add_batch: ") + what + " offsets must be non-decreasing");
+        }
+    }
+}
+
+}  // namespace
+
+void init_column_pool_bindings(py::module_& m) {
+    using namespace openbp;
+
+    py::class_<ColumnPool>(m, "ColumnPool", R"doc(
+Deduplicating pool of columns stored in columnar form.
+
+Each column has a cost, a coverage bitset over the items (rows) it
+covers and an optional arc sequence. Columns with the same coverage and
+the same arcs in the same order are duplicates; add() keeps the first
+and reports the existing index in O(1) expected time. Items beyond
+num_items widen the bitsets automatically.
+
+Not thread-safe.
+
+Example:
+    >>> pool = ColumnPool(num_items=len(problem.cover_constraints))
+    >>> index, inserted = pool.add(col.cost, col.covered_items, col.arc_indices)
+)doc")
+        .def(py::init<int32_t>(), py::arg("num_items") = 0)
+
+        // Insertion and lookup
+        .def("add", [](ColumnPool& pool, double cost, py::handle items, py::handle arcs) {
+            auto item_list = to_indices(items);
+            auto arc_list = arcs.is_none() ? std::vector<int32_t>() : to_indices(arcs);
+            auto result = pool.add(cost, item_list, arc_list);
+            return py::make_tuple(result.index, result.inserted);
+        },
+        py::arg("cost"), py::arg("items"), py::arg("arcs") = py::none(),
+        "Add a column; returns (index, inserted) where inserted is False for a duplicate")
+
+        .def("add_batch", [](ColumnPool& pool,
+                             py::array_t<double, py::array::c_style | py::array::forcecast> costs,
+                             IndexArray item_offsets,
+                             py::array_t<int32_t, py::array::c_style | py::array::forcecast> items,
+                             py::object arc_offsets, py::object arcs) {
+            auto cost_values = bindings::from_numpy<double>(costs);
+            auto item_off = bindings::from_numpy<int64_t>(item_offsets);
+            auto item_data = bindings::from_numpy<int32_t>(items);
+            std::vector<int64_t> arc_off(cost_values.size() + 1, 0);
+            std::vector<int32_t> arc_data;
+            if (!arc_offsets.is_none() || !arcs.is_none()) {
+                if (arc_offsets.is_none() || arcs.is_none()) {
+                    throw py::value_error("add_batch: pass both arc_offsets and arcs, or neither");
+                }
+                arc_off = bindings::from_numpy<int64_t>(arc_offsets.cast<IndexArray>());
+                arc_data = to_indices(arcs);
+            }
+            const size_t n = cost_values.size();
+            check_offsets(item_off, n, item_data.size(), "item");
+            check_offsets(arc_off, n, arc_data.size(), "arc");
+
+            std::vector<int64_t> indices(n);
+            {
+                py::gil_scoped_release release;
+                for (size_t k = 0; k < n; ++k) {
+                    indices[k] = pool.add(cost_values[k],
+                                          item_data.data() + item_off[k],
+                                          static_cast<size_t>(item_off[k + 1] - item_off[k]),
+                                          arc_data.data() + arc_off[k],
+                                          static_cast<size_t>(arc_off[k + 1] - arc_off[k])).index;
+                }
+            }
+            return bindings::to_numpy(std::move(indices));
+        },
+        py::arg("costs"), py::arg("item_offsets"), py::arg("items"),
+        py::arg("arc_offsets") = py::none(), py::arg("arcs") = py::none(),
+        R"doc(
+Add many columns given in CSR form, releasing the GIL.
+
+Column k covers items[item_offsets[k]:item_offsets[k + 1]] and uses
+arcs[arc_offsets[k]:arc_offsets[k + 1]]. Returns the pool index of each
+column (int64); indices >= the previous len(pool) are new columns.
+)doc")
+
+        .def("find", [](const ColumnPool& pool, py::handle items, py::handle arcs) {
+            auto arc_list = arcs.is_none() ? std::vector<int32_t>() : to_indices(arcs);
+            return pool.find(to_indices(items), arc_list);
+        },
+        py::arg("items"), py::arg("arcs") = py::none(),
+        "Index of the column with this coverage and arc sequence, or -1")
+
+        .def("contains", [](const ColumnPool& pool, py::handle items, py::handle arcs) {
+            auto arc_list = arcs.is_none() ? std::vector<int32_t>() : to_indices(arcs);
+            return pool.contains(to_indices(items), arc_list);
+        },
+        py::arg("items"), py::arg("arcs") = py::none(),
+        "Check whether a column with this signature is pooled")
+
+        // Column access
+        .def("cost", &ColumnPool::cost, py::arg("index"), "Cost of a column")
+        .def("items", &ColumnPool::items, py::arg("index"),
+            "Covered items of a column, ascending")
+        .def("arcs", &ColumnPool::arcs, py::arg("index"), "Arc indices of a column, in order")
+        .def("covers", &ColumnPool::covers, py::arg("index"), py::arg("item"),
+            "Check whether a column covers an item")
+        .def_property_readonly("num_items", &ColumnPool::num_items,
+            "Size of the item universe (coverage width)")
+        .def_property_readonly("words_per_column", &ColumnPool::words_per_column,
+            "Coverage bitset width in 64-bit words")
+
+        // Columnar export (copies: the pool's buffers move when it grows)
+        .def("costs", [](const ColumnPool& pool) {
+            return bindings::to_numpy(std::vector<double>(pool.costs()));
+        }, "Costs of all columns (float64 array)")
+        .def("coverage", [](const ColumnPool& pool) {
+            py::array_t<uint64_t> result({static_cast<py::ssize_t>(pool.size()),
+                                          static_cast<py::ssize_t>(pool.words_per_column())});
+            const auto& words = pool.coverage_data();
+            if (!words.empty()) {
+                std::memcpy(result.mutable_data(), words.data(), words.size() * sizeof(uint64_t));
+            }
+            return result;
+        },
+        R"doc(
+Coverage bitsets as a (len(pool), words_per_column) uint64 array.
+
+Item i of column k is bit i % 64 of word i // 64 in row k.
+)doc")
+        .def("arc_offsets", [](const ColumnPool& pool) {
+            return bindings::to_numpy(std::vector<int64_t>(pool.arc_offsets()));
+        }, "CSR offsets into arc_indices() (int64, len(pool) + 1 entries)")
+        .def("arc_indices", [](const ColumnPool& pool) {
+            return bindings::to_numpy(std::vector<int32_t>(pool.arc_data()));
+        }, "Arc indices of all columns, concatenated (int32)")
+
+        // Capacity
+        .def("reserve", &ColumnPool::reserve, py::arg("num_columns"), py::arg("num_arcs") = 0,
+            "Pre-allocate for num_columns columns and num_arcs arcs")
+        .def("reserve_items", &ColumnPool::reserve_items, py::arg("num_items"),
+            "Widen the coverage bitsets to num_items items")
+        .def("clear", &ColumnPool::clear, "Remove all columns")
+        .def("memory_usage", &ColumnPool::memory_usage,
+            "Approximate bytes held by the pool")
+
+        .def("__len__", &ColumnPool::size)
+        .def("__repr__", [](const ColumnPool& pool) {
+            return "<ColumnPool columns=" + std::to_string(pool.size()) +
+                   " items=" + std::to_string(pool.num_items()) + ">";
+        });
+
+    py::class_<ColumnFilter>(m, "ColumnFilter", R"doc(
+Branching decisions compiled into bitmask tests over a ColumnPool.
+
+Enforces Ryan-Foster decisions (same/different column) and ARC decisions
+without a source node (source_node < 0). ARC decisions tied to a source
+are counted in num_skipped and must be checked by the caller; other
+decision types do not restrict columns. Evaluation releases the GIL and
+uses AVX2 when the CPU supports it.
+
+Example:
+    >>> f = ColumnFilter.for_node(node)
+    >>> valid = f.indices(pool)          # int64 pool indices
+    >>> keep = f.mask(pool)              # bool array, one entry per column
+)doc")
+        .def(py::init<>())
+        .def(py::init<const std::vector<BranchingDecision>&>(), py::arg("decisions"))
+        .def_static("for_node", &ColumnFilter::for_node, py::arg("node"),
+            "Filter enforcing every decision on the path to node")
+        .def("add", &ColumnFilter::add, py::arg("decision"),
+            "Add a decision; returns True if it is enforced")
+        .def_property_readonly("num_tests", &ColumnFilter::num_tests,
+            "Number of enforced decisions")
+        .def_property_readonly("num_skipped", &ColumnFilter::num_skipped,
+            "Number of source-specific ARC decisions left to the caller")
+        .def_property_readonly_static("simd_available", [](py::object) {
+            return ColumnFilter::simd_available();
+        }, "True if the AVX2 kernel can run on this CPU")
+        .def("set_use_simd", &ColumnFilter::set_use_simd, py::arg("use"),
+            "Enable or disable the AVX2 kernel (enabled by default)")
+        .def("accepts", &ColumnFilter::accepts, py::arg("pool"), py::arg("index"),
+            "Check one column")
+        .def("mask", [](const ColumnFilter& filter, const ColumnPool& pool, size_t begin) {
+            std::vector<uint8_t> keep;
+            {
+                py::gil_scoped_release release;
+                keep = filter.mask(pool, begin);
+            }
+            return bindings::to_numpy(std::move(keep)).attr("view")("bool");
+        },
+        py::arg("pool"), py::arg("begin") = 0,
+        "Bool array over columns [begin, len(pool)): True = satisfies all decisions")
+        .def("indices", [](const ColumnFilter& filter, const ColumnPool& pool, size_t begin) {
+            std::vector<int64_t> valid;
+            {
+                py::gil_scoped_release release;
+                valid = filter.indices(pool, begin);
+            }
+            return bindings::to_numpy(std::move(valid));
+        },
+        py::arg("pool"), py::arg("begin") = 0,
+        "Pool indices (int64, ascending) of valid columns in [begin, len(pool))")
+        .def("__repr__", [](const ColumnFilter& filter) {
+            return "<ColumnFilter tests=" + std::to_string(filter.num_tests()) +
+                   " skipped=" + std::to_string(filter.num_skipped()) + ">";
+        });
+
+    py::class_<NodeColumnSets>(m, "NodeColumnSets", R"doc(
+Cache of valid-column sets for the open nodes of a tree.
+
+A child's set is derived from its parent's cached set by applying only
+the child's local decisions, plus a full check of columns added to the
+pool since; nodes without a cached parent are filtered against the whole
+pool. Sets are stored as sorted indices or a bitmap, whichever is
+smaller. Attach the cache to the tree to drop the sets of pruned nodes,
+and release() nodes processed without branching.
+
+get(), count() and branch() release the GIL and may run from several
+threads, but the pool must not be added to while any of them runs.
+
+Example:
+    >>> sets = NodeColumnSets(pool)
+    >>> sets.attach(tree)
+    >>> valid = sets.get(node)                 # int64 pool indices
+    >>> children = tree.create_children(node, decisions)
+    >>> sets.branch(node, children)            # derive children, drop node
+)doc")
+        .def(py::init<const ColumnPool&>(), py::arg("pool"), py::keep_alive<1, 2>())
+        .def("get", [](NodeColumnSets& sets, const BPNode& node) {
+            std::vector<int64_t> valid;
+            {
+                py::gil_scoped_release release;
+                valid = sets.get(node)->indices();
+            }
+            return bindings::to_numpy(std::move(valid));
+        },
+        py::arg("node"),
+        "Pool indices (int64, ascending) of the node's valid columns over the whole pool")
+        .def("count", [](NodeColumnSets& sets, const BPNode& node) {
+            return sets.get(node)->count();
+        },
+        py::arg("node"), py::call_guard<py::gil_scoped_release>(),
+        "Number of valid columns of a node")
+        .def("branch", &NodeColumnSets::branch, py::arg("parent"), py::arg("children"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Derive the children's sets from the parent's, then drop the parent's")
+        .def("release", &NodeColumnSets::release, py::arg("node_id"),
+            "Drop a node's set")
+        .def("is_cached", &NodeColumnSets::is_cached, py::arg("node_id"),
+            "Check whether a node's set is cached")
+        .def("attach", [](NodeColumnSets& sets, BPTree& tree) {
+            tree.add_listener(&sets);
+        }, py::arg("tree"), py::keep_alive<2, 1>(),
+        "Drop sets of nodes the tree prunes")
+        .def("detach", [](NodeColumnSets& sets, BPTree& tree) {
+            tree.remove_listener(&sets);
+        }, py::arg("tree"),
+        "Stop listening to the tree")
+        .def("clear", &NodeColumnSets::clear, "Drop all sets")
+        .def("memory_usage", &NodeColumnSets::memory_usage,
+            "Approximate bytes held by cached sets")
+        .def("__len__", &NodeColumnSets::size);
+}
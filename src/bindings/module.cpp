@@ -11,6 +11,9 @@ namespace py = pybind11;
 void init_node_bindings(py::module_& m);
 void init_tree_bindings(py::module_& m);
 void init_selection_bindings(py::module_& m);
+void init_parallel_bindings(py::module_& m);
+void init_column_pool_bindings(py::module_& m);
+void init_branching_bindings(py::module_& m);
 
 PYBIND11_MODULE(_core, m) {
     m.doc() = R"doc(
@@ -24,6 +27,9 @@ This module provides:
 - BPTree: Search tree management with node storage
 - NodeSelector: Various node selection policies (best-first, depth-first, etc.)
 - BranchingDecision: Representation of branching choices
+- ParallelSolver: Multi-threaded tree exploration with a worker pool
+- ColumnPool: Columnar, deduplicating storage for generated columns
+- RyanFosterPairScorer: Native scoring of Ryan-Foster branching pairs
 
 These classes are designed to work with Python branching strategies
 while providing high-performance tree traversal and node management.
@@ -37,4 +43,7 @@ while providing high-performance tree traversal and node management.
     init_node_bindings(m);
     init_tree_bindings(m);
     init_selection_bindings(m);
+    init_parallel_bindings(m);
+    init_column_pool_bindings(m);
+    init_branching_bindings(m);
 }
@@ -5,8 +5,10 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 
 #include "core/node.hpp"
+#include "numpy_util.hpp"
 
 namespace py = pybind11;
 
@@ -46,33 +48,49 @@ Factory methods:
     - ryan_foster(item_i, item_j, same_column): Ryan-Foster branching
     - arc_branch(arc, source, required): Arc branching
     - resource_branch(res_idx, lb, ub): Resource window branching
+    - custom(int_data, float_data): User-defined branching payload
 )doc")
         .def(py::init<>())
-        .def_readwrite("type", &BranchingDecision::type, "Type of branching")
+        .def_property("type", &BranchingDecision::type, &BranchingDecision::set_type,
+            "Type of branching (changing it resets the payload)")
 
         // Variable branching fields
-        .def_readwrite("variable_index", &BranchingDecision::variable_index)
-        .def_readwrite("bound_value", &BranchingDecision::bound_value)
-        .def_readwrite("is_upper_bound", &BranchingDecision::is_upper_bound)
+        .def_property("variable_index", &BranchingDecision::variable_index,
+            &BranchingDecision::set_variable_index)
+        .def_property("bound_value", &BranchingDecision::bound_value,
+            &BranchingDecision::set_bound_value)
+        .def_property("is_upper_bound", &BranchingDecision::is_upper_bound,
+            &BranchingDecision::set_is_upper_bound)
 
         // Ryan-Foster fields
-        .def_readwrite("item_i", &BranchingDecision::item_i)
-        .def_readwrite("item_j", &BranchingDecision::item_j)
-        .def_readwrite("same_column", &BranchingDecision::same_column)
+        .def_property("item_i", &BranchingDecision::item_i, &BranchingDecision::set_item_i)
+        .def_property("item_j", &BranchingDecision::item_j, &BranchingDecision::set_item_j)
+        .def_property("same_column", &BranchingDecision::same_column,
+            &BranchingDecision::set_same_column)
 
         // Arc branching fields
-        .def_readwrite("arc_index", &BranchingDecision::arc_index)
-        .def_readwrite("source_node", &BranchingDecision::source_node)
-        .def_readwrite("arc_required", &BranchingDecision::arc_required)
+        .def_property("arc_index", &BranchingDecision::arc_index,
+            &BranchingDecision::set_arc_index)
+        .def_property("source_node", &BranchingDecision::source_node,
+            &BranchingDecision::set_source_node)
+        .def_property("arc_required", &BranchingDecision::arc_required,
+            &BranchingDecision::set_arc_required)
 
         // Resource branching fields
-        .def_readwrite("resource_index", &BranchingDecision::resource_index)
-        .def_readwrite("lower_bound", &BranchingDecision::lower_bound)
-        .def_readwrite("upper_bound", &BranchingDecision::upper_bound)
+        .def_property("resource_index", &BranchingDecision::resource_index,
+            &BranchingDecision::set_resource_index)
+        .def_property("lower_bound", &BranchingDecision::lower_bound,
+            &BranchingDecision::set_lower_bound)
+        .def_property("upper_bound", &BranchingDecision::upper_bound,
+            &BranchingDecision::set_upper_bound)
 
-        // Custom fields
-        .def_readwrite("custom_int_data", &BranchingDecision::custom_int_data)
-        .def_readwrite("custom_float_data", &BranchingDecision::custom_float_data)
+        // Custom fields (stored out of line, returned as copies)
+        .def_property("custom_int_data",
+            [](const BranchingDecision& d) { return d.custom_int_data().to_vector(); },
+            &BranchingDecision::set_custom_int_data)
+        .def_property("custom_float_data",
+            [](const BranchingDecision& d) { return d.custom_float_data().to_vector(); },
+            &BranchingDecision::set_custom_float_data)
 
         // Factory methods
         .def_static("variable_branch", &BranchingDecision::variable_branch,
@@ -87,24 +105,78 @@ Factory methods:
         .def_static("resource_branch", &BranchingDecision::resource_branch,
             py::arg("res_idx"), py::arg("lb"), py::arg("ub"),
             "Create a resource branching decision")
+        .def_static("custom", &BranchingDecision::custom,
+            py::arg("int_data"), py::arg("float_data") = std::vector<double>{},
+            "Create a custom branching decision")
 
         .def("__repr__", [](const BranchingDecision& d) {
-            std::string type_str = branch_type_to_string(d.type);
-            switch (d.type) {
+            std::string type_str = branch_type_to_string(d.type());
+            switch (d.type()) {
                 case BranchType::VARIABLE:
-                    return "<BranchingDecision VARIABLE x[" + std::to_string(d.variable_index) + "] " +
-                           (d.is_upper_bound ? "<=" : ">=") + " " + std::to_string(d.bound_value) + ">";
+                    return "<BranchingDecision VARIABLE x[" + std::to_string(d.variable_index()) + "] " +
+                           (d.is_upper_bound() ? "<=" : ">=") + " " + std::to_string(d.bound_value()) + ">";
                 case BranchType::RYAN_FOSTER:
-                    return "<BranchingDecision RYAN_FOSTER (" + std::to_string(d.item_i) + "," +
-                           std::to_string(d.item_j) + ") " + (d.same_column ? "SAME" : "DIFF") + ">";
+                    return "<BranchingDecision RYAN_FOSTER (" + std::to_string(d.item_i()) + "," +
+                           std::to_string(d.item_j()) + ") " + (d.same_column() ? "SAME" : "DIFF") + ">";
                 case BranchType::ARC:
-                    return "<BranchingDecision ARC " + std::to_string(d.arc_index) +
-                           (d.arc_required ? " REQUIRED" : " FORBIDDEN") + ">";
+                    return "<BranchingDecision ARC " + std::to_string(d.arc_index()) +
+                           (d.arc_required() ? " REQUIRED" : " FORBIDDEN") + ">";
                 default:
                     return "<BranchingDecision " + type_str + ">";
             }
         });
 
+    // DecisionPath (read-only view over a node's shared decisions)
+    py::class_<DecisionPath>(m, "DecisionPath", R"doc(
+Persistent, structurally shared sequence of branching decisions.
+
+Each node extends its parent's path by its local decisions without
+copying the prefix. Iteration visits decisions from the node back to
+the root (most recent first).
+)doc")
+        .def("__len__", &DecisionPath::size)
+        .def("__iter__", [](const DecisionPath& p) {
+            return py::make_iterator(p.begin(), p.end());
+        }, py::keep_alive<0, 1>())
+        .def("to_list", &DecisionPath::to_vector,
+            "Materialise the path in root-to-node order")
+        .def("__repr__", [](const DecisionPath& p) {
+            return "<DecisionPath size=" + std::to_string(p.size()) + ">";
+        });
+
+    // RyanFosterClosure (implied pairs of a decision path)
+    py::class_<RyanFosterClosure>(m, "RyanFosterClosure", R"doc(
+Transitive closure of Ryan-Foster decisions on a path.
+
+"Same" decisions merge items into classes that must share a column,
+"different" decisions keep two classes apart. A pair is implied when it
+is already decided by the closure, and the closure is infeasible once a
+class must be apart from itself.
+)doc")
+        .def(py::init<>(), "Create an empty closure")
+        .def(py::init<const std::vector<BranchingDecision>&>(), py::arg("decisions"),
+            "Closure of a list of decisions (non Ryan-Foster ones are ignored)")
+        .def("add", &RyanFosterClosure::add, py::arg("decision"),
+            "Merge one decision; returns False if the closure is infeasible")
+        .def_property_readonly("feasible", &RyanFosterClosure::feasible,
+            "Whether some column set satisfies every decision")
+        .def_property_readonly("num_items", &RyanFosterClosure::num_items,
+            "Number of items named by decisions")
+        .def("representative", &RyanFosterClosure::representative, py::arg("item"),
+            "Representative item of the item's class")
+        .def("together", &RyanFosterClosure::together, py::arg("i"), py::arg("j"),
+            "Whether i and j must share a column")
+        .def("apart", &RyanFosterClosure::apart, py::arg("i"), py::arg("j"),
+            "Whether i and j must not share a column")
+        .def("implied", &RyanFosterClosure::implied, py::arg("i"), py::arg("j"),
+            "Whether the pair is already decided")
+        .def("implied_pairs", &RyanFosterClosure::implied_pairs, py::arg("same"),
+            "Sorted list of decided pairs (i < j) that are together (same=True) or apart")
+        .def("__repr__", [](const RyanFosterClosure& c) {
+            return "<RyanFosterClosure items=" + std::to_string(c.num_items()) +
+                   " feasible=" + (c.feasible() ? "True" : "False") + ">";
+        });
+
     // BPNode class
     py::class_<BPNode>(m, "BPNode", R"doc(
 A node in the branch-and-price tree.
@@ -152,16 +224,23 @@ Attributes:
 
         // Branching decisions
         .def_property_readonly("local_decisions", &BPNode::local_decisions,
-            py::return_value_policy::reference,
             "Branching decisions at this node")
         .def_property_readonly("inherited_decisions", &BPNode::inherited_decisions,
-            py::return_value_policy::reference,
             "Branching decisions inherited from ancestors")
+        .def_property_readonly("decision_path", &BPNode::decision_path,
+            "Shared decision path (iterates most recent decision first)")
         .def("all_decisions", &BPNode::all_decisions,
             "Get all branching decisions (inherited + local)")
         .def_property_readonly("num_decisions", &BPNode::num_decisions,
             "Total number of branching decisions")
 
+        .def_property_readonly("ryan_foster_feasible", &BPNode::ryan_foster_feasible,
+            "Whether the Ryan-Foster decisions on the path are consistent")
+        .def("ryan_foster_closure", [](const BPNode& self) {
+            return RyanFosterClosure(*self.ryan_foster_closure());
+        },
+        "Copy of the Ryan-Foster closure of the node's decision path")
+
         .def("add_local_decision", &BPNode::add_local_decision,
             py::arg("decision"),
             "Add a local branching decision")
@@ -173,22 +252,31 @@ Attributes:
         .def_property_readonly("has_children", &BPNode::has_children,
             "Whether node has children")
 
-        // Solution
-        .def("set_solution", [](BPNode& self, std::vector<double> sol) {
-            self.set_solution(std::move(sol));
-        }, py::arg("solution"), "Set the solution vector")
-        .def_property_readonly("solution", &BPNode::solution,
-            py::return_value_policy::reference,
-            "Solution vector")
+        // Solution (read-only NumPy views sharing the node's buffers)
+        .def("set_solution", [](BPNode& self,
+                                py::array_t<double, py::array::c_style | py::array::forcecast> sol) {
+            self.set_solution(bindings::from_numpy(sol));
+        }, py::arg("solution"),
+        "Set the solution vector from an array or sequence (one memcpy)")
+        .def_property_readonly("solution", [](const BPNode& self) {
+            return bindings::view_numpy(self.shared_solution());
+        },
+        "Solution vector as a read-only, zero-copy float64 array. The array "
+        "keeps its buffer alive, so it stays valid after the solution is "
+        "replaced or the node is released.")
         .def_property_readonly("has_solution", &BPNode::has_solution,
             "Whether node has a solution stored")
 
-        .def("set_solution_columns", [](BPNode& self, std::vector<int32_t> cols) {
-            self.set_solution_columns(std::move(cols));
-        }, py::arg("columns"), "Set the solution columns")
-        .def_property_readonly("solution_columns", &BPNode::solution_columns,
-            py::return_value_policy::reference,
-            "Column indices in the solution")
+        .def("set_solution_columns", [](BPNode& self,
+                                        py::array_t<int32_t, py::array::c_style | py::array::forcecast> cols) {
+            self.set_solution_columns(bindings::from_numpy(cols));
+        }, py::arg("columns"),
+        "Set the solution columns from an array or sequence (one memcpy)")
+        .def_property_readonly("solution_columns", [](const BPNode& self) {
+            return bindings::view_numpy(self.shared_solution_columns());
+        },
+        "Column indices in the solution as a read-only, zero-copy int32 "
+        "array (same lifetime as solution)")
 
         // Pruning
         .def("try_prune_by_bound", &BPNode::try_prune_by_bound,
@@ -0,0 +1,72 @@
+/**
+ * @file numpy_util.hpp
+ * @brief Helpers for passing C++ arrays to and from NumPy without copies.
+ */
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace openbp {
+namespace bindings {
+
+namespace py = pybind11;
+
+/**
+ * @brief Hand a vector over to NumPy without copying its elements.
+ *
+ * The vector is moved to the heap and owned by a capsule that becomes
+ * the array's base, so it lives exactly as long as the array.
+ */
+template<typename T>
+py::array_t<T> to_numpy(std::vector<T>&& values) {
+    auto* owned = new std::vector<T>(std::move(values));
+    py::capsule owner(owned, [](void* p) { delete static_cast<std::vector<T>*>(p); });
+    return py::array_t<T>(static_cast<py::ssize_t>(owned->size()), owned->data(), owner);
+}
+
+/**
+ * @brief Read-only NumPy view of a shared, immutable buffer.
+ *
+ * A capsule holding a reference to the buffer becomes the array's base,
+ * so the view stays valid after the producer replaces or drops its own
+ * reference (e.g. a node that is re-solved or recycled).
+ */
+template<typename T>
+py::array_t<T> view_numpy(std::shared_ptr<const std::vector<T>> values) {
+    if (!values) values = std::make_shared<const std::vector<T>>();
+    using Shared = std::shared_ptr<const std::vector<T>>;
+    auto* owned = new Shared(std::move(values));
+    py::capsule owner(owned, [](void* p) { delete static_cast<Shared*>(p); });
+    py::array_t<T> array(static_cast<py::ssize_t>((*owned)->size()),
+                         const_cast<T*>((*owned)->data()), owner);
+    array.attr("setflags")(py::arg("write") = false);
+    return array;
+}
+
+/**
+ * @brief Copy a 1-D buffer into a vector in one memcpy.
+ *
+ * Accepts any object exposing the buffer protocol (NumPy arrays,
+ * array.array, memoryview) or a sequence; the dtype is converted only
+ * if it differs from @p T.
+ */
+template<typename T>
+std::vector<T> from_numpy(const py::array_t<T, py::array::c_style | py::array::forcecast>& array) {
+    if (array.ndim() != 1) {
+        throw py::value_error("expected a 1-D array");
+    }
+    std::vector<T> values(static_cast<size_t>(array.shape(0)));
+    if (!values.empty()) {
+        std::memcpy(values.data(), array.data(), values.size() * sizeof(T));
+    }
+    return values;
+}
+
+}  // namespace bindings
+}  // namespace openbp
@@ -0,0 +1,420 @@
+/**
+ * @file parallel_bindings.cpp
+ * @brief pybind11 bindings for the parallel branch-and-price driver.
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+
+#include "core/parallel.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace py = pybind11;
+
+namespace {
+
+/**
+ * @brief Python callbacks made from the driver's worker threads.
+ *
+ * A Python error raised by a callback is kept here, under the GIL, and
+ * the core driver only sees a plain C++ exception. No Python object is
+ * then copied or destroyed while the driver unwinds with the GIL
+ * released; run() raises the saved error once the GIL is back.
+ */
+class PythonCallbacks {
+public:
+    /// Call @p f holding the GIL
+    template<typename F>
+    auto call(F&& f) -> decltype(f()) {
+        py::gil_scoped_acquire gil;
+        try {
+            return f();
+        } catch (py::error_already_set& e) {
+            // Keep the first error; the driver stops after it
+            if (!error_) error_ = std::make_unique<py::error_already_set>(std::move(e));
+            throw Failed();
+        }
+    }
+
+    /// Run @p fn with the GIL released, then re-raise a callback's Python error
+    template<typename F>
+    auto run(F&& fn) -> decltype(fn()) {
+        try {
+            py::gil_scoped_release release;
+            return fn();
+        } catch (const Failed&) {
+            if (!error_) throw;
+            py::error_already_set error = std::move(*error_);
+            error_.reset();
+            throw error;
+        }
+    }
+
+private:
+    struct Failed : std::runtime_error {
+        Failed() : std::runtime_error("Python callback failed") {}
+    };
+
+    std::unique_ptr<py::error_already_set> error_;  // Guarded by the GIL
+};
+
+}  // namespace
+
+void init_parallel_bindings(py::module_& m) {
+    using namespace openbp;
+
+    // NodeResult struct
+    py::class_<NodeResult>(m, "NodeResult", R"doc(
+Outcome of evaluating one node, returned by a node processor.
+
+The processor only computes; ParallelSolver applies the result to the
+tree (bounds, children, incumbent, pruning). Use the static factories
+for the common cases.
+)doc")
+        .def(py::init<>())
+        .def_readwrite("status", &NodeResult::status,
+            "BRANCHED, INTEGER, PRUNED_INFEASIBLE or FATHOMED")
+        .def_readwrite("lower_bound", &NodeResult::lower_bound,
+            "Lower bound proven at the node")
+        .def_readwrite("lp_value", &NodeResult::lp_value,
+            "LP relaxation value")
+        .def_readwrite("branches", &NodeResult::branches,
+            "Branching decisions, one child per decision")
+        .def_readwrite("solution", &NodeResult::solution,
+            "Solution values (integer results only)")
+        .def_static("branch", &NodeResult::branch,
+            py::arg("lower_bound"), py::arg("lp_value"), py::arg("branches"),
+            "Branch the node with the given decisions")
+        .def_static("integer", &NodeResult::integer,
+            py::arg("lp_value"), py::arg("solution") = std::vector<double>(),
+            "The node's LP solution is integer")
+        .def_static("infeasible", &NodeResult::infeasible,
+            "The node is infeasible")
+        .def_static("fathomed", &NodeResult::fathomed,
+            py::arg("lower_bound"),
+            "Close the node without branching");
+
+    // Batched rounds: one boundary crossing per round instead of per node
+    m.def("select_round", [](BPTree& tree, NodeSelector& selector, size_t max_nodes) {
+            std::vector<BPNode*> batch;
+            select_round(tree, selector, max_nodes, batch);
+            return batch;
+        },
+        py::arg("tree"), py::arg("selector"), py::arg("max_nodes"),
+        py::return_value_policy::reference,
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+Take up to max_nodes explorable nodes from the selector and claim them
+for processing (PENDING -> PROCESSING), in one call.
+)doc");
+
+    m.def("apply_round", [](BPTree& tree, NodeSelector& selector,
+                            const std::vector<BPNode*>& nodes, std::vector<NodeResult> results) {
+            return apply_round(tree, selector, nodes, results);
+        },
+        py::arg("tree"), py::arg("selector"), py::arg("nodes"), py::arg("results"),
+        py::call_guard<py::gil_scoped_release>(),
+        "Apply one NodeResult per node, in order; returns the number of new incumbents");
+
+    m.def("apply_round", [](BPTree& tree, NodeSelector& selector,
+                            const std::vector<BPNode*>& nodes,
+                            py::array_t<int32_t, py::array::c_style | py::array::forcecast> statuses,
+                            py::array_t<double, py::array::c_style | py::array::forcecast> lower_bounds,
+                            py::array_t<double, py::array::c_style | py::array::forcecast> lp_values,
+                            std::vector<std::vector<BranchingDecision>> branches,
+                            std::vector<std::vector<double>> solutions) {
+            const size_t n = nodes.size();
+            if (statuses.ndim() != 1 || lower_bounds.ndim() != 1 || lp_values.ndim() != 1 ||
+                static_cast<size_t>(statuses.shape(0)) != n ||
+                static_cast<size_t>(lower_bounds.shape(0)) != n ||
+                static_cast<size_t>(lp_values.shape(0)) != n) {
+                throw py::value_error("apply_round: statuses, lower_bounds and lp_values "
+                                      "must be 1-D with one entry per node");
+            }
+            if ((!branches.empty() && branches.size() != n) ||
+                (!solutions.empty() && solutions.size() != n)) {
+                throw py::value_error("apply_round: branches and solutions must be empty "
+                                      "or have one entry per node");
+            }
+
+            auto status = statuses.unchecked<1>();
+            auto lb = lower_bounds.unchecked<1>();
+            auto lp = lp_values.unchecked<1>();
+            std::vector<NodeResult> results(n);
+            for (size_t k = 0; k < n; ++k) {
+                const auto s = static_cast<NodeStatus>(status(static_cast<py::ssize_t>(k)));
+                if (s != NodeStatus::BRANCHED && s != NodeStatus::INTEGER &&
+                    s != NodeStatus::PRUNED_INFEASIBLE && s != NodeStatus::FATHOMED) {
+                    throw py::value_error("apply_round: status must be BRANCHED, INTEGER, "
+                                          "PRUNED_INFEASIBLE or FATHOMED");
+                }
+                NodeResult& r = results[k];
+                r.status = s;
+                r.lower_bound = lb(static_cast<py::ssize_t>(k));
+                r.lp_value = lp(static_cast<py::ssize_t>(k));
+                if (!branches.empty()) r.branches = std::move(branches[k]);
+                if (!solutions.empty()) r.solution = std::move(solutions[k]);
+            }
+
+            py::gil_scoped_release release;
+            return apply_round(tree, selector, nodes, results);
+        },
+        py::arg("tree"), py::arg("selector"), py::arg("nodes"),
+        py::arg("statuses"), py::arg("lower_bounds"), py::arg("lp_values"),
+        py::arg("branches") = std::vector<std::vector<BranchingDecision>>(),
+        py::arg("solutions") = std::vector<std::vector<double>>(),
+        R"doc(
+Apply a round of node results given as arrays, in node order.
+
+statuses holds NodeStatus values as integers (int(NodeStatus.X)),
+lower_bounds and lp_values one float each; branches (decisions per
+node) and solutions (values per node) may be empty when unused.
+Children are added to the selector; the tree is pruned once if any
+result improved the incumbent. Returns the number of new incumbents.
+
+Example:
+    >>> nodes = select_round(tree, selector, 64)
+    >>> out = [solve(n) for n in nodes]
+    >>> apply_round(tree, selector, nodes,
+    ...             np.array([int(o.status) for o in out], dtype=np.int32),
+    ...             np.array([o.lb for o in out]), np.array([o.lp for o in out]),
+    ...             [o.branches for o in out])
+)doc");
+
+    // ParallelConfig struct
+    py::class_<ParallelConfig>(m, "ParallelConfig", R"doc(
+Configuration of ParallelSolver.
+)doc")
+        .def(py::init<>())
+        .def_readwrite("num_threads", &ParallelConfig::num_threads,
+            "Number of worker threads (default: hardware concurrency)")
+        .def_readwrite("deterministic", &ParallelConfig::deterministic,
+            "Process nodes in synchronised rounds for reproducible runs")
+        .def_readwrite("round_size", &ParallelConfig::round_size,
+            "Nodes per round in deterministic mode (independent of num_threads)")
+        .def_readwrite("max_nodes", &ParallelConfig::max_nodes,
+            "Maximum nodes to process (0 = unlimited)")
+        .def_readwrite("time_limit", &ParallelConfig::time_limit,
+            "Time limit in seconds")
+        .def_readwrite("gap_tolerance", &ParallelConfig::gap_tolerance,
+            "Stop once the relative gap is at most this value");
+
+    // ParallelStatus enum
+    py::enum_<ParallelStatus>(m, "ParallelStatus", "Why ParallelSolver stopped")
+        .value("COMPLETED", ParallelStatus::COMPLETED, "No open nodes left")
+        .value("GAP_LIMIT", ParallelStatus::GAP_LIMIT, "Gap closed to the tolerance")
+        .value("NODE_LIMIT", ParallelStatus::NODE_LIMIT, "Node limit reached")
+        .value("TIME_LIMIT", ParallelStatus::TIME_LIMIT, "Time limit reached")
+        .value("INTERRUPTED", ParallelStatus::INTERRUPTED, "stop() was called")
+        .export_values();
+
+    // ParallelResult struct
+    py::class_<ParallelResult>(m, "ParallelResult", R"doc(
+Summary of a ParallelSolver run.
+)doc")
+        .def_readonly("status", &ParallelResult::status,
+            "Why the run stopped")
+        .def_readonly("nodes_processed", &ParallelResult::nodes_processed,
+            "Nodes evaluated by the processor")
+        .def_readonly("rounds", &ParallelResult::rounds,
+            "Synchronised rounds (deterministic mode only)")
+        .def_readonly("elapsed", &ParallelResult::elapsed,
+            "Wall-clock time in seconds")
+        .def_readonly("nodes_per_worker", &ParallelResult::nodes_per_worker,
+            "Nodes evaluated by each worker")
+        .def("__repr__", [](const ParallelResult& r) {
+            return "<ParallelResult nodes=" + std::to_string(r.nodes_processed) +
+                   " elapsed=" + std::to_string(r.elapsed) + "s>";
+        });
+
+    // IncumbentRegister class
+    py::class_<IncumbentRegister>(m, "IncumbentRegister", R"doc(
+Lock-free register holding the best known upper bound.
+
+offer() lowers the bound with a compare-and-swap and bumps the epoch on
+every improvement. Share one register between solvers (see
+ParallelSolver.share_incumbent) or feed it from a primal heuristic so
+bounds found anywhere reach every worker before its next node.
+)doc")
+        .def(py::init<>())
+        .def("offer", &IncumbentRegister::offer,
+            py::arg("value"), py::arg("source") = -1,
+            py::call_guard<py::gil_scoped_release>(),
+            "Offer a solution value; True if it improved the upper bound")
+        .def_property_readonly("upper_bound", &IncumbentRegister::upper_bound,
+            "Best known upper bound")
+        .def_property_readonly("epoch", &IncumbentRegister::epoch,
+            "Number of improvements so far")
+        .def_property_readonly("source", &IncumbentRegister::source,
+            "Source of the latest improvement, or -1")
+        .def("reset", &IncumbentRegister::reset,
+            "Forget the bound (not while a solve is running)");
+
+    // ParallelSolver class
+    py::class_<ParallelSolver>(m, "ParallelSolver", R"doc(
+Parallel branch-and-price driver over a BPTree and a NodeSelector.
+
+Worker threads take nodes from the selector and call the processor
+``process(node, worker) -> NodeResult`` on them; the driver applies
+each result to the tree. The GIL is released while the solve runs and
+re-acquired only around each processor call, so processors that do
+their heavy lifting in native code (LP solves, pricing) run in
+parallel.
+
+In deterministic mode nodes are processed in synchronised rounds of
+config.round_size nodes and results are applied in node-ID order. The
+tree, incumbent and statistics are then identical for any thread count,
+provided the processor is a pure function of the node (not of the
+worker index) and no time limit is hit. Otherwise workers run
+freely and the exploration order depends on timing.
+
+The processor must not modify the tree. An exception raised by the
+processor stops the solve and is re-raised from run().
+
+Example:
+    >>> def process(node, worker):
+    ...     lb = solve_master(node)
+    ...     return NodeResult.branch(lb, lb, pick_branches(node))
+    >>> solver = ParallelSolver(tree, BestFirstSelector(), config)
+    >>> result = solver.run(process)
+)doc")
+        .def(py::init<BPTree&, NodeSelector&, ParallelConfig>(),
+            py::arg("tree"), py::arg("selector"), py::arg("config") = ParallelConfig(),
+            py::keep_alive<1, 2>(), py::keep_alive<1, 3>())
+        .def_property_readonly("config", &ParallelSolver::config,
+            "Driver configuration")
+        .def("share_incumbent", &ParallelSolver::share_incumbent,
+            py::arg("incumbent"), py::keep_alive<1, 2>(),
+            "Exchange upper bounds through the given IncumbentRegister")
+        .def_property_readonly("incumbent", &ParallelSolver::incumbent,
+            py::return_value_policy::reference_internal,
+            "The IncumbentRegister used for upper bounds")
+        .def("run", [](ParallelSolver& self, const py::function& process) {
+                // Captured by reference: copying a py::function off the GIL
+                // would touch its refcount
+                PythonCallbacks callbacks;
+                ParallelSolver::NodeProcessor wrapped = [&](BPNode* node, int worker) {
+                    return callbacks.call([&] {
+                        return process(py::cast(node, py::return_value_policy::reference), worker)
+                            .cast<NodeResult>();
+                    });
+                };
+                return callbacks.run([&] { return self.run(wrapped); });
+            },
+            py::arg("process"),
+            "Explore the tree with the given processor until done or a limit is reached")
+        .def("stop", &ParallelSolver::stop,
+            py::call_guard<py::gil_scoped_release>(),
+            "Ask a running solve to stop");
+
+    // PortfolioConfig struct
+    py::class_<PortfolioConfig>(m, "PortfolioConfig", R"doc(
+Configuration of PortfolioSolver.
+)doc")
+        .def(py::init<>())
+        .def_readwrite("selectors", &PortfolioConfig::selectors,
+            "One racer per entry, each a create_selector() name")
+        .def_readwrite("max_nodes", &PortfolioConfig::max_nodes,
+            "Maximum nodes per racer (0 = unlimited)")
+        .def_readwrite("time_limit", &PortfolioConfig::time_limit,
+            "Time limit in seconds")
+        .def_readwrite("gap_tolerance", &PortfolioConfig::gap_tolerance,
+            "A racer proves optimality once its relative gap is at most this value");
+
+    // RacerResult struct
+    py::class_<RacerResult>(m, "RacerResult", R"doc(
+Outcome of one portfolio racer.
+)doc")
+        .def_readonly("selector", &RacerResult::selector,
+            "Selector name")
+        .def_readonly("status", &RacerResult::status,
+            "Why the racer stopped")
+        .def_readonly("nodes_processed", &RacerResult::nodes_processed,
+            "Nodes evaluated by the racer")
+        .def_readonly("bounds_imported", &RacerResult::bounds_imported,
+            "Upper bounds received from other racers")
+        .def_readonly("lower_bound", &RacerResult::lower_bound,
+            "Lower bound of the racer's tree");
+
+    // PortfolioResult struct
+    py::class_<PortfolioResult>(m, "PortfolioResult", R"doc(
+Summary of a PortfolioSolver run.
+)doc")
+        .def_readonly("status", &PortfolioResult::status,
+            "COMPLETED or GAP_LIMIT if a racer proved optimality, else the limit hit")
+        .def_readonly("winner", &PortfolioResult::winner,
+            "Racer that proved optimality, or -1")
+        .def_readonly("incumbent_racer", &PortfolioResult::incumbent_racer,
+            "Racer that found the best solution, or -1")
+        .def_readonly("upper_bound", &PortfolioResult::upper_bound,
+            "Best solution value")
+        .def_readonly("lower_bound", &PortfolioResult::lower_bound,
+            "Best proven lower bound")
+        .def_readonly("solution", &PortfolioResult::solution,
+            "Best solution values")
+        .def_readonly("elapsed", &PortfolioResult::elapsed,
+            "Wall-clock time in seconds")
+        .def_readonly("racers", &PortfolioResult::racers,
+            "Per-racer outcomes")
+        .def("__repr__", [](const PortfolioResult& r) {
+            return "<PortfolioResult winner=" + std::to_string(r.winner) +
+                   " ub=" + std::to_string(r.upper_bound) + ">";
+        });
+
+    // PortfolioSolver class
+    py::class_<PortfolioSolver>(m, "PortfolioSolver", R"doc(
+Races several node selection policies on the same problem.
+
+Each racer explores its own tree with its own selector on its own
+thread. Racers share the incumbent: a better solution found by one is
+imported by all others before their next node, so every racer prunes
+with the best known bound. The first racer to close its gap proves
+optimality and stops the race.
+
+The processor ``process(node, racer) -> NodeResult`` is called
+concurrently by different racers; the GIL is held only during the
+call. ``setup_root(root)``, if given, initialises each racer's root.
+
+Example:
+    >>> config = PortfolioConfig()
+    >>> config.selectors = ["best_first", "depth_first", "hybrid"]
+    >>> result = PortfolioSolver(config).run(process)
+    >>> result.racers[result.winner].selector
+)doc")
+        .def(py::init<PortfolioConfig>(),
+            py::arg("config") = PortfolioConfig())
+        .def_property_readonly("config", &PortfolioSolver::config,
+            "Portfolio configuration")
+        .def_property_readonly("num_racers", &PortfolioSolver::num_racers,
+            "Number of racers")
+        .def("run", [](PortfolioSolver& self, const py::function& process, const py::object& setup_root) {
+                PythonCallbacks callbacks;
+                PortfolioSolver::NodeProcessor wrapped = [&](BPNode* node, int racer) {
+                    return callbacks.call([&] {
+                        return process(py::cast(node, py::return_value_policy::reference), racer)
+                            .cast<NodeResult>();
+                    });
+                };
+                std::function<void(BPNode*)> setup;
+                if (!setup_root.is_none()) {
+                    setup = [&](BPNode* root) {
+                        callbacks.call([&] { setup_root(py::cast(root, py::return_value_policy::reference)); });
+                    };
+                }
+                return callbacks.run([&] { return self.run(wrapped, setup); });
+            },
+            py::arg("process"), py::arg("setup_root") = py::none(),
+            "Race all configured selectors until one proves optimality")
+        .def("tree", &PortfolioSolver::tree,
+            py::arg("racer"),
+            py::return_value_policy::reference_internal,
+            "A racer's tree (valid until the next run)")
+        .def("stop", &PortfolioSolver::stop,
+            py::call_guard<py::gil_scoped_release>(),
+            "Ask all racers to stop");
+}
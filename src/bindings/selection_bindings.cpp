@@ -28,34 +28,68 @@ Available implementations:
 - DepthFirstSelector: Explore deepest nodes first
 - BestEstimateSelector: Use bound + depth estimate
 - HybridSelector: Alternate between strategies
+- WorkStealingSelector: Per-worker queues for parallel search
+
+Queue operations release the GIL. Only WorkStealingSelector may be used
+from several Python threads at once; share the others behind a lock.
 )doc")
         .def("add_node", &NodeSelector::add_node,
             py::arg("node"),
+            py::call_guard<py::gil_scoped_release>(),
             "Add a node to the open queue")
         .def("add_nodes", &NodeSelector::add_nodes,
             py::arg("nodes"),
+            py::call_guard<py::gil_scoped_release>(),
             "Add multiple nodes to the open queue")
         .def("select_next", &NodeSelector::select_next,
             py::return_value_policy::reference,
+            py::call_guard<py::gil_scoped_release>(),
             "Select and remove the next node to explore")
         .def("peek_next", &NodeSelector::peek_next,
             py::return_value_policy::reference,
+            py::call_guard<py::gil_scoped_release>(),
             "Peek at the next node without removing")
         .def("empty", &NodeSelector::empty,
             "Check if there are any open nodes")
         .def("size", &NodeSelector::size,
             "Get the number of open nodes")
         .def("prune", &NodeSelector::prune,
+            py::call_guard<py::gil_scoped_release>(),
             "Remove pruned nodes, returns count")
+        .def("remove", &NodeSelector::remove,
+            py::arg("node"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Remove a specific node, returns whether it was held")
+        .def("update_priority", &NodeSelector::update_priority,
+            py::arg("node"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Restore ordering after a held node's lower bound changed")
+        .def("contains", &NodeSelector::contains,
+            py::arg("node"),
+            "Whether the selector holds a node")
         .def("on_bound_update", &NodeSelector::on_bound_update,
             py::arg("new_bound"),
+            py::call_guard<py::gil_scoped_release>(),
             "Called when global upper bound is updated")
         .def("best_bound", &NodeSelector::best_bound,
             "Get the best (lowest) bound among open nodes")
         .def("get_open_node_ids", &NodeSelector::get_open_node_ids,
+            py::call_guard<py::gil_scoped_release>(),
             "Get IDs of all open nodes")
         .def("clear", &NodeSelector::clear,
-            "Clear all nodes from the selector");
+            py::call_guard<py::gil_scoped_release>(),
+            "Clear all nodes from the selector")
+        .def("is_concurrent", &NodeSelector::is_concurrent,
+            "Whether the selector is safe to use from several threads without a lock")
+        .def("select_for_worker", &NodeSelector::select_for_worker,
+            py::arg("worker"),
+            py::return_value_policy::reference,
+            py::call_guard<py::gil_scoped_release>(),
+            "Select the next node on behalf of a parallel worker")
+        .def("add_nodes_for_worker", &NodeSelector::add_nodes_for_worker,
+            py::arg("nodes"), py::arg("worker"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Add nodes created by a parallel worker");
 
     // BestFirstSelector
     py::class_<BestFirstSelector, NodeSelector>(m, "BestFirstSelector", R"doc(
@@ -65,9 +99,23 @@ Always explores the node with the lowest lower bound.
 This minimizes the number of nodes explored but may delay
 finding good integer solutions.
 
+Backed by an indexed 4-ary heap: selection, remove() and
+update_priority() are O(log n). Nodes that stop being explorable are
+dropped lazily when they reach the top; prune() removes the rest and
+compacts the heap in one pass once they exceed compaction_threshold of
+its size. empty() is O(log n) amortized; size() counts open nodes in
+one O(n) pass.
+
+Args:
+    compaction_threshold: Stale fraction that triggers compaction (default 0.5)
+
 Best for: Proving optimality on easy instances.
 )doc")
-        .def(py::init<>())
+        .def(py::init<double>(),
+            py::arg("compaction_threshold") = BestFirstSelector::DEFAULT_COMPACTION_THRESHOLD)
+        .def("compact", &BestFirstSelector::compact,
+            py::call_guard<py::gil_scoped_release>(),
+            "Physically remove all non-explorable nodes, returns count")
         .def("__repr__", [](const BestFirstSelector& s) {
             return "<BestFirstSelector size=" + std::to_string(s.size()) + ">";
         });
@@ -79,9 +127,16 @@ Depth-first node selection (diving).
 Explores deepest nodes first, which tends to find integer
 solutions quickly. Uses best-bound as tiebreaker at same depth.
 
+Args:
+    compaction_threshold: Stale fraction that triggers compaction (default 0.5)
+
 Best for: Finding good solutions on hard instances.
 )doc")
-        .def(py::init<>())
+        .def(py::init<double>(),
+            py::arg("compaction_threshold") = DepthFirstSelector::DEFAULT_COMPACTION_THRESHOLD)
+        .def("compact", &DepthFirstSelector::compact,
+            py::call_guard<py::gil_scoped_release>(),
+            "Physically remove all non-explorable nodes, returns count")
         .def("__repr__", [](const DepthFirstSelector& s) {
             return "<DepthFirstSelector size=" + std::to_string(s.size()) + ">";
         });
@@ -93,12 +148,22 @@ Best-estimate node selection.
 Uses a combination of lower bound and depth-based estimate
 to prioritize nodes likely to lead to good solutions.
 
+Nodes are kept in a heap keyed by estimate (O(log n) selection); the
+heap is re-keyed in one O(n) pass when the incumbent or the maximum
+depth changes.
+
 Args:
     estimate_weight: Weight for depth-based estimate (default 0.5)
                     Higher values favor deeper nodes.
+    compaction_threshold: Stale fraction that triggers a full rebuild in prune()
 )doc")
-        .def(py::init<double>(),
-            py::arg("estimate_weight") = 0.5)
+        .def(py::init<double, double>(),
+            py::arg("estimate_weight") = 0.5,
+            py::arg("compaction_threshold") = BestEstimateSelector::DEFAULT_COMPACTION_THRESHOLD)
+        .def_property_readonly("estimate_weight", &BestEstimateSelector::estimate_weight,
+            "Weight of the depth-based estimate")
+        .def_property_readonly("max_depth", &BestEstimateSelector::max_depth,
+            "Deepest node depth seen so far")
         .def("__repr__", [](const BestEstimateSelector& s) {
             return "<BestEstimateSelector size=" + std::to_string(s.size()) + ">";
         });
@@ -108,19 +173,59 @@ Args:
 Hybrid node selection with periodic diving.
 
 Alternates between best-first and depth-first selection
-to balance bound improvement and solution finding.
+to balance bound improvement and solution finding. Nodes are stored
+once and indexed by both orders, so each selection is O(log n).
 
 Args:
     dive_frequency: How often to start diving (every N nodes)
     dive_depth: How deep to dive before switching back
+    compaction_threshold: Stale fraction that triggers a full rebuild in prune()
 )doc")
-        .def(py::init<int, int>(),
+        .def(py::init<int, int, double>(),
             py::arg("dive_frequency") = 5,
-            py::arg("dive_depth") = 10)
+            py::arg("dive_depth") = 10,
+            py::arg("compaction_threshold") = HybridSelector::DEFAULT_COMPACTION_THRESHOLD)
+        .def_property_readonly("is_diving", &HybridSelector::is_diving,
+            "Whether the selector is currently diving")
         .def("__repr__", [](const HybridSelector& s) {
             return "<HybridSelector size=" + std::to_string(s.size()) + ">";
         });
 
+    // WorkStealingSelector
+    py::class_<WorkStealingSelector, NodeSelector>(m, "WorkStealingSelector", R"doc(
+Work-stealing node selection for parallel workers.
+
+Each worker has its own queue, explored depth-first, where the
+children it creates are added. A worker whose best bound drifts more
+than max_bound_drift (relative) above the global best bound takes the
+global best node instead; an idle worker steals the best node of the
+queue with the lowest bound. All methods are thread-safe.
+
+Args:
+    num_workers: Number of worker queues (default: hardware concurrency)
+    max_bound_drift: Relative bound drift that triggers balancing (default 0.1)
+
+Best for: ParallelSolver with many threads.
+)doc")
+        .def(py::init<int, double>(),
+            py::arg("num_workers") = 0,
+            py::arg("max_bound_drift") = WorkStealingSelector::DEFAULT_MAX_BOUND_DRIFT)
+        .def_property_readonly("num_workers", &WorkStealingSelector::num_workers,
+            "Number of worker queues")
+        .def_property_readonly("max_bound_drift", &WorkStealingSelector::max_bound_drift,
+            "Relative bound drift that triggers balancing")
+        .def_property_readonly("num_steals", &WorkStealingSelector::num_steals,
+            "Nodes taken from another queue by an idle worker")
+        .def_property_readonly("num_balancing_picks", &WorkStealingSelector::num_balancing_picks,
+            "Nodes taken from another queue to follow the global best bound")
+        .def("local_size", &WorkStealingSelector::local_size,
+            py::arg("worker"),
+            "Number of nodes in one worker's queue")
+        .def("__repr__", [](const WorkStealingSelector& s) {
+            return "<WorkStealingSelector workers=" + std::to_string(s.num_workers()) +
+                   " size=" + std::to_string(s.size()) + ">";
+        });
+
     // Factory function
     m.def("create_selector", &create_selector,
         py::arg("name"),
@@ -133,6 +238,7 @@ Args:
         - "depth_first" or "DepthFirst"
         - "best_estimate" or "BestEstimate"
         - "hybrid" or "Hybrid"
+        - "work_stealing" or "WorkStealing"
 
 Returns:
     NodeSelector: The requested selector (defaults to best_first)
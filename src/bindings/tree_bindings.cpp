@@ -6,8 +6,11 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 
 #include "core/tree.hpp"
+#include "core/selection.hpp"
+#include "numpy_util.hpp"
 
 namespace py = pybind11;
 
@@ -37,6 +40,8 @@ Tracks node counts, bounds, and exploration progress.
             "Currently open nodes")
         .def_readwrite("max_depth", &TreeStats::max_depth,
             "Maximum tree depth reached")
+        .def_readwrite("nodes_released", &TreeStats::nodes_released,
+            "Closed nodes released by node recycling")
         .def_readwrite("best_lower_bound", &TreeStats::best_lower_bound,
             "Best lower bound")
         .def_readwrite("best_upper_bound", &TreeStats::best_upper_bound,
@@ -56,6 +61,11 @@ The branch-and-price search tree.
 Manages node storage, tree structure, and global bounds.
 Provides efficient node creation, access, and traversal.
 
+Operations that take the tree lock or touch many nodes (node creation,
+status changes, pruning, open-node queries, reclaiming) release the GIL,
+so Python threads driving workers of the same tree do not serialise on
+it.
+
 Example:
     tree = BPTree(minimize=True)
     root = tree.root()
@@ -92,21 +102,30 @@ Example:
         .def("create_child", &BPTree::create_child,
             py::arg("parent"), py::arg("decision"),
             py::return_value_policy::reference,
+            py::call_guard<py::gil_scoped_release>(),
             "Create a child node with a branching decision")
         .def("create_children", &BPTree::create_children,
             py::arg("parent"), py::arg("decisions"),
             py::return_value_policy::reference,
+            py::call_guard<py::gil_scoped_release>(),
             "Create multiple children with branching decisions")
 
         // Node status
+        .def("begin_processing", &BPTree::begin_processing,
+            py::arg("node"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Claim a pending node for processing; False if it was already "
+            "claimed or closed")
         .def("mark_processed", &BPTree::mark_processed,
             py::arg("node"), py::arg("new_status"),
+            py::call_guard<py::gil_scoped_release>(),
             "Mark a node as processed with new status")
 
         // Bounds
         .def_property("global_lower_bound",
             &BPTree::global_lower_bound, &BPTree::set_global_lower_bound,
-            "Global lower bound")
+            "Global lower bound: lowest open-node bound, kept up to date in O(1). "
+            "Assigning sets a floor.")
         .def_property("global_upper_bound",
             &BPTree::global_upper_bound, &BPTree::set_global_upper_bound,
             "Global upper bound (incumbent)")
@@ -114,26 +133,51 @@ Example:
             "Whether this is a minimization problem")
         .def("update_bounds", &BPTree::update_bounds,
             py::arg("node"),
+            py::call_guard<py::gil_scoped_release>(),
             "Update bounds after processing a node")
         .def("compute_lower_bound", &BPTree::compute_lower_bound,
             py::arg("open_node_ids"),
+            py::call_guard<py::gil_scoped_release>(),
             "Compute lower bound from open nodes")
         .def("prune_by_bound", &BPTree::prune_by_bound,
-            "Prune all nodes by bound, returns count")
+            py::call_guard<py::gil_scoped_release>(),
+            "Prune open nodes whose bound reaches the incumbent, returns count. "
+            "Only the pruned nodes are visited; attached selectors drop them "
+            "in the same pass.")
+        .def("tighten_upper_bound", &BPTree::tighten_upper_bound,
+            py::arg("upper_bound"),
+            "Lower the upper bound to a value found elsewhere, without taking the "
+            "tree lock; pruning is deferred to prune_if_pending(). Returns True "
+            "if the bound improved")
+        .def_property_readonly("prune_pending", &BPTree::prune_pending,
+            "Whether the upper bound improved since the last prune_by_bound()")
+        .def("prune_if_pending", &BPTree::prune_if_pending,
+            py::call_guard<py::gil_scoped_release>(),
+            "Run prune_by_bound() if the upper bound improved since the last pass, "
+            "returns count")
+
+        // Selector notifications
+        .def("attach_selector", [](BPTree& tree, NodeSelector& selector) {
+            tree.add_listener(&selector);
+        }, py::arg("selector"), py::keep_alive<1, 2>(),
+        "Notify a selector of pruned nodes and lower bound changes")
+        .def("detach_selector", [](BPTree& tree, NodeSelector& selector) {
+            tree.remove_listener(&selector);
+        }, py::arg("selector"),
+        "Stop notifying a selector")
         .def("gap", &BPTree::gap,
-            "Current optimality gap")
+            "Current optimality gap (O(1))")
 
         // Open nodes
         .def("get_open_nodes", &BPTree::get_open_nodes,
+            py::call_guard<py::gil_scoped_release>(),
             "Get IDs of all open nodes")
         .def_property_readonly("is_complete", &BPTree::is_complete,
             "Whether tree exploration is complete")
 
         // Statistics
-        .def_property_readonly("stats",
-            static_cast<const TreeStats& (BPTree::*)() const>(&BPTree::stats),
-            py::return_value_policy::reference,
-            "Tree statistics")
+        .def_property_readonly("stats", &BPTree::stats,
+            "Snapshot of the tree statistics")
 
         // Incumbent
         .def("incumbent",
@@ -142,11 +186,55 @@ Example:
             "Get the incumbent node")
         .def("set_incumbent", &BPTree::set_incumbent,
             py::arg("node"),
+            py::call_guard<py::gil_scoped_release>(),
             "Set the incumbent node")
 
+        // Node recycling
+        .def_property("node_recycling",
+            &BPTree::node_recycling, &BPTree::set_node_recycling,
+            "Release closed subtrees (except the incumbent path) on reclaim")
+        .def("reclaim_closed_nodes", &BPTree::reclaim_closed_nodes,
+            py::call_guard<py::gil_scoped_release>(),
+            "Release queued closed nodes, returns count. Call after pruning "
+            "the selector: released nodes must not be referenced anymore.")
+        .def_property_readonly("num_reclaimable", &BPTree::num_reclaimable,
+            "Closed nodes waiting to be released")
+        .def_property_readonly("memory_usage", &BPTree::memory_usage,
+            "Approximate bytes held by node storage and index")
+
+        // Bulk export
+        .def("node_table", [](const BPTree& tree) {
+            NodeTable table;
+            {
+                py::gil_scoped_release release;
+                table = tree.node_table();
+            }
+            py::dict columns;
+            columns["id"] = bindings::to_numpy(std::move(table.id));
+            columns["parent_id"] = bindings::to_numpy(std::move(table.parent_id));
+            columns["depth"] = bindings::to_numpy(std::move(table.depth));
+            columns["lower_bound"] = bindings::to_numpy(std::move(table.lower_bound));
+            columns["lp_value"] = bindings::to_numpy(std::move(table.lp_value));
+            columns["status"] = bindings::to_numpy(std::move(table.status));
+            return columns;
+        },
+        R"doc(
+Export all live nodes as NumPy columns, in ascending ID order.
+
+Returns a dict of equally long arrays: id and parent_id (int64), depth
+(int32), lower_bound and lp_value (float64) and status (uint8, the
+integer value of NodeStatus). The arrays own their memory; no Python
+object is created per node.
+
+Example:
+    >>> t = tree.node_table()
+    >>> pruned = t["id"][t["status"] == int(NodeStatus.PRUNED_BOUND)]
+)doc")
+
         // Path operations
         .def("get_path_to_root", &BPTree::get_path_to_root,
             py::arg("target_id"),
+            py::call_guard<py::gil_scoped_release>(),
             "Get node IDs from root to target")
 
         // Iteration
@@ -0,0 +1,367 @@
+/**
+ * @file column_filter.hpp
+ * @brief Evaluate a node's branching decisions over a ColumnPool.
+ *
+ * Decisions are compiled into bitmask tests on the pool's coverage
+ * bitsets, so a column is checked by reading only the coverage words that
+ * hold branched-on items instead of looking items up decision by decision.
+ */
+
+#pragma once
+
+#include "column_pool.hpp"
+#include "node.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define OPENBP_HAS_AVX2_DISPATCH 1
+#include <immintrin.h>
+#else
+#define OPENBP_HAS_AVX2_DISPATCH 0
+#endif
+
+namespace openbp {
+
+/**
+ * @brief Column filter compiled from branching decisions.
+ *
+ * Handles the decision types that restrict which columns are valid:
+ * - RYAN_FOSTER same(i,j): a column covers both i and j or neither
+ * - RYAN_FOSTER diff(i,j): a column does not cover both i and j
+ * - ARC without a source node: a column must use (required) or must not
+ *   use (forbidden) the arc
+ *
+ * Other types do not restrict the column set and are ignored. ARC
+ * decisions tied to a source node cannot be checked against the pool,
+ * which does not store sources; they are counted in num_skipped() and
+ * must be applied by the caller.
+ *
+ * Each Ryan-Foster decision becomes a test attached to its items. A
+ * column is screened against a bitmask of all branched-on items (with
+ * AVX2 when available and the mask is dense), and only the tests of items
+ * it actually covers are evaluated.
+ */
+class ColumnFilter {
+public:
+    ColumnFilter() = default;
+
+    explicit ColumnFilter(const std::vector<BranchingDecision>& decisions) {
+        for (const auto& d : decisions) add(d);
+    }
+
+    /// Filter enforcing every decision on the path to @p node
+    static ColumnFilter for_node(const BPNode& node) { return ColumnFilter(node.all_decisions()); }
+
+    /**
+     * @brief Add one decision.
+     * @return true if the decision restricts columns and is enforced
+     */
+    bool add(const BranchingDecision& decision) {
+        switch (decision.type()) {
+            case BranchType::RYAN_FOSTER: {
+                int32_t i = decision.item_i(), j = decision.item_j();
+                if (i < 0 || j < 0) return false;
+                if (decision.same_column() && i == j) return true;  // Always satisfied
+                pairs_.push_back({i, j, decision.same_column()});
+                return true;
+            }
+            case BranchType::ARC:
+                if (decision.source_node() >= 0) {
+                    ++skipped_;
+                    return false;
+                }
+                insert_sorted(decision.arc_required() ? required_arcs_ : forbidden_arcs_,
+                              decision.arc_index());
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /// Number of enforced decisions
+    size_t num_tests() const { return pairs_.size() + required_arcs_.size() + forbidden_arcs_.size(); }
+
+    /// Number of ARC decisions left to the caller (source-specific)
+    size_t num_skipped() const { return skipped_; }
+
+    bool empty() const { return num_tests() == 0; }
+
+    /// Use the AVX2 kernel when the CPU supports it (default: true)
+    void set_use_simd(bool use) { use_simd_ = use; }
+
+    static bool simd_available() {
+#if OPENBP_HAS_AVX2_DISPATCH
+        static const bool available = __builtin_cpu_supports("avx2");
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    // =========================================================================
+    // Evaluation
+    // =========================================================================
+
+    bool accepts(const ColumnPool& pool, size_t column) const {
+        uint8_t keep = 1;
+        refine(pool, &keep, column, column + 1);
+        return keep != 0;
+    }
+
+    /**
+     * @brief Clear mask entries of columns that violate a decision.
+     *
+     * mask[k] refers to column begin + k. Entries already 0 are left
+     * alone (and not evaluated), so masks can be refined incrementally.
+     */
+    void refine(const ColumnPool& pool, uint8_t* mask, size_t begin, size_t end) const {
+        end = std::min(end, pool.size());
+        if (begin >= end || empty()) return;
+
+        Compiled program = compile(pool);
+        if (!program.relevant_words.empty()) {
+#if OPENBP_HAS_AVX2_DISPATCH
+            if (use_simd_ && program.dense && simd_available()) {
+                refine_pairs_avx2(pool, program, mask, begin, end);
+            } else {
+                refine_pairs_scalar(pool, program, mask, begin, end);
+            }
+#else
+            refine_pairs_scalar(pool, program, mask, begin, end);
+#endif
+        }
+        if (!required_arcs_.empty() || !forbidden_arcs_.empty()) {
+            refine_arcs(pool, mask, begin, end);
+        }
+    }
+
+    /**
+     * @brief Clear mask entries of listed columns that violate a decision.
+     *
+     * mask[k] refers to column columns[k]; as for refine(), entries
+     * already 0 are skipped. Cost is proportional to @p count, not to the
+     * pool size.
+     */
+    void refine_subset(const ColumnPool& pool, const uint32_t* columns, size_t count,
+                       uint8_t* mask) const {
+        if (count == 0 || empty()) return;
+
+        Compiled program = compile(pool);
+        const bool check_pairs = !program.relevant_words.empty();
+        const bool check_arcs = !required_arcs_.empty() || !forbidden_arcs_.empty();
+        const size_t words = pool.words_per_column();
+        const Word* rows = pool.coverage_data().data();
+        for (size_t k = 0; k < count; ++k) {
+            if (!mask[k]) continue;
+            size_t c = columns[k];
+            if ((check_pairs && !row_passes(program, rows + c * words)) ||
+                (check_arcs && !arcs_pass(pool, c))) {
+                mask[k] = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Selection mask for columns [begin, size()): 1 = valid.
+     */
+    std::vector<uint8_t> mask(const ColumnPool& pool, size_t begin = 0) const {
+        std::vector<uint8_t> result(begin < pool.size() ? pool.size() - begin : 0, 1);
+        refine(pool, result.data(), begin, pool.size());
+        return result;
+    }
+
+    /**
+     * @brief Indices of valid columns in [begin, size()), ascending.
+     */
+    std::vector<int64_t> indices(const ColumnPool& pool, size_t begin = 0) const {
+        auto keep = mask(pool, begin);
+        std::vector<int64_t> result;
+        for (size_t k = 0; k < keep.size(); ++k) {
+            if (keep[k]) result.push_back(static_cast<int64_t>(begin + k));
+        }
+        return result;
+    }
+
+private:
+    using Word = ColumnPool::Word;
+    static constexpr size_t WORD_BITS = ColumnPool::WORD_BITS;
+
+    struct Pair {
+        int32_t i;
+        int32_t j;
+        bool same;
+    };
+
+    /// Test run when a column covers the owning item
+    struct Test {
+        int64_t partner_word;  // -1: partner outside the pool's items
+        Word partner_bit;
+        bool same;             // same: partner must be covered; diff: must not
+    };
+
+    /// Tests laid out for one pool width
+    struct Compiled {
+        std::vector<Word> relevant;            // Items owning a test
+        std::vector<size_t> relevant_words;    // Nonzero words of relevant
+        std::vector<size_t> test_offsets;      // CSR by item, up to the max owner
+        std::vector<Test> tests;
+        bool dense = false;                    // Screen whole rows instead of word list
+    };
+
+    static void insert_sorted(std::vector<int32_t>& values, int32_t value) {
+        auto it = std::lower_bound(values.begin(), values.end(), value);
+        if (it == values.end() || *it != value) values.insert(it, value);
+    }
+
+    Compiled compile(const ColumnPool& pool) const {
+        Compiled program;
+        const size_t words = pool.words_per_column();
+        const int32_t num_items = pool.num_items();
+        program.relevant.assign(words, 0);
+
+        // Owners: same(i,j) on both items, diff(i,j) on i only
+        std::vector<std::pair<int32_t, Test>> owned;
+        auto make_test = [&](int32_t partner, bool same) {
+            if (partner >= num_items) return Test{-1, 0, same};
+            return Test{static_cast<int64_t>(partner / WORD_BITS),
+                        Word(1) << (partner % WORD_BITS), same};
+        };
+        for (const auto& p : pairs_) {
+            owned.push_back({p.i, make_test(p.j, p.same)});
+            if (p.same) owned.push_back({p.j, make_test(p.i, true)});
+        }
+
+        int32_t max_owner = -1;
+        for (const auto& entry : owned) {
+            if (entry.first >= num_items) continue;  // No column covers it
+            max_owner = std::max(max_owner, entry.first);
+            program.relevant[entry.first / WORD_BITS] |= Word(1) << (entry.first % WORD_BITS);
+        }
+        program.test_offsets.assign(static_cast<size_t>(max_owner + 2), 0);
+        for (const auto& entry : owned) {
+            if (entry.first <= max_owner) ++program.test_offsets[entry.first + 1];
+        }
+        for (size_t k = 1; k < program.test_offsets.size(); ++k) {
+            program.test_offsets[k] += program.test_offsets[k - 1];
+        }
+        program.tests.resize(program.test_offsets.back());
+        std::vector<size_t> cursor(program.test_offsets.begin(), program.test_offsets.end() - 1);
+        for (const auto& entry : owned) {
+            if (entry.first <= max_owner) program.tests[cursor[entry.first]++] = entry.second;
+        }
+
+        for (size_t w = 0; w < words; ++w) {
+            if (program.relevant[w] != 0) program.relevant_words.push_back(w);
+        }
+        program.dense = 4 * program.relevant_words.size() >= words;
+        return program;
+    }
+
+    /// Run the tests of the relevant items covered in one word of @p row
+    static bool word_passes(const Compiled& program, const Word* row, size_t w, Word bits) {
+        for (; bits != 0; bits &= bits - 1) {
+            size_t item = w * WORD_BITS + static_cast<size_t>(ColumnPool::count_trailing_zeros(bits));
+            for (size_t t = program.test_offsets[item]; t < program.test_offsets[item + 1]; ++t) {
+                const Test& test = program.tests[t];
+                bool has_partner = test.partner_word >= 0 && (row[test.partner_word] & test.partner_bit);
+                if (has_partner != test.same) return false;
+            }
+        }
+        return true;
+    }
+
+    static bool row_passes(const Compiled& program, const Word* row) {
+        for (size_t w : program.relevant_words) {
+            Word bits = row[w] & program.relevant[w];
+            if (bits != 0 && !word_passes(program, row, w, bits)) return false;
+        }
+        return true;
+    }
+
+    static void refine_pairs_scalar(const ColumnPool& pool, const Compiled& program,
+                                    uint8_t* mask, size_t begin, size_t end) {
+        const size_t words = pool.words_per_column();
+        const Word* rows = pool.coverage_data().data();
+        for (size_t c = begin; c < end; ++c) {
+            uint8_t& keep = mask[c - begin];
+            if (keep && !row_passes(program, rows + c * words)) keep = 0;
+        }
+    }
+
+#if OPENBP_HAS_AVX2_DISPATCH
+    /**
+     * Screen four coverage words per instruction. The nonzero words of a
+     * block of 64 are collected into a bitmask first, so the scan itself
+     * is branch-free and only covered relevant items run their tests.
+     */
+    __attribute__((target("avx2")))
+    static void refine_pairs_avx2(const ColumnPool& pool, const Compiled& program,
+                                  uint8_t* mask, size_t begin, size_t end) {
+        const size_t words = pool.words_per_column();
+        const Word* rows = pool.coverage_data().data();
+        const Word* relevant = program.relevant.data();
+        const __m256i zero = _mm256_setzero_si256();
+
+        for (size_t c = begin; c < end; ++c) {
+            uint8_t& keep = mask[c - begin];
+            if (!keep) continue;
+            const Word* row = rows + c * words;
+            for (size_t block = 0; keep && block < words; block += 64) {
+                const size_t block_end = std::min(words, block + 64);
+                uint64_t nonzero = 0;
+                size_t w = block;
+                for (; w + 4 <= block_end; w += 4) {
+                    __m256i hit = _mm256_and_si256(
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + w)),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(relevant + w)));
+                    auto empty = static_cast<uint64_t>(
+                        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(hit, zero))));
+                    nonzero |= (~empty & 0xFu) << (w - block);
+                }
+                for (; w < block_end; ++w) {
+                    nonzero |= static_cast<uint64_t>((row[w] & relevant[w]) != 0) << (w - block);
+                }
+                for (; nonzero != 0; nonzero &= nonzero - 1) {
+                    size_t word = block + static_cast<size_t>(ColumnPool::count_trailing_zeros(nonzero));
+                    if (!word_passes(program, row, word, row[word] & relevant[word])) {
+                        keep = 0;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+#endif
+
+    bool arcs_pass(const ColumnPool& pool, size_t column) const {
+        const int32_t* arcs = pool.arc_data().data();
+        const int32_t* first = arcs + pool.arc_offsets()[column];
+        const int32_t* last = arcs + pool.arc_offsets()[column + 1];
+        for (const int32_t* a = first; a != last; ++a) {
+            if (std::binary_search(forbidden_arcs_.begin(), forbidden_arcs_.end(), *a)) return false;
+        }
+        for (int32_t required : required_arcs_) {
+            if (std::find(first, last, required) == last) return false;
+        }
+        return true;
+    }
+
+    void refine_arcs(const ColumnPool& pool, uint8_t* mask, size_t begin, size_t end) const {
+        for (size_t c = begin; c < end; ++c) {
+            uint8_t& keep = mask[c - begin];
+            if (keep && !arcs_pass(pool, c)) keep = 0;
+        }
+    }
+
+    std::vector<Pair> pairs_;
+    std::vector<int32_t> required_arcs_;   // Sorted, unique
+    std::vector<int32_t> forbidden_arcs_;  // Sorted, unique
+    size_t skipped_ = 0;
+    bool use_simd_ = true;
+};
+
+}  // namespace openbp
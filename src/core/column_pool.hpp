@@ -0,0 +1,336 @@
+/**
+ * @file column_pool.hpp
+ * @brief Columnar storage for generated columns with hash deduplication.
+ *
+ * Columns are stored structure-of-arrays: one cost array, one fixed-width
+ * coverage bitset per column in a single contiguous buffer, and arc
+ * indices in CSR form. Duplicates are detected in O(1) expected time by
+ * hashing the coverage/arc signature into an open-addressing table.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace openbp {
+
+/**
+ * @brief Append-only pool of columns keyed by coverage and arc sequence.
+ *
+ * Two columns are duplicates when they cover the same items and use the
+ * same arcs in the same order; the first one added is kept. Columns
+ * without arcs are therefore deduplicated on coverage alone.
+ *
+ * The coverage width grows on demand when an item beyond num_items() is
+ * added (all rows are re-laid out once, and the width at least doubles,
+ * so this is amortised). Signature hashes do not depend on the width, so
+ * widening never rehashes.
+ *
+ * The pool is not synchronised; guard it externally if shared.
+ */
+class ColumnPool {
+public:
+    using Word = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+
+    /// Result of add(): the column's index and whether it was new
+    struct AddResult {
+        int64_t index;
+        bool inserted;
+    };
+
+    /**
+     * @param num_items Size of the item universe (coverage width hint)
+     */
+    explicit ColumnPool(int32_t num_items = 0) : arc_offsets_{0} {
+        if (num_items < 0) throw std::invalid_argument("num_items must be non-negative");
+        num_items_ = num_items;
+        words_ = words_for(num_items);
+    }
+
+    // =========================================================================
+    // Insertion and lookup
+    // =========================================================================
+
+    /**
+     * @brief Add a column unless an identical one is already pooled.
+     * @param cost Column cost
+     * @param items Covered item indices (any order, duplicates ignored)
+     * @param arcs Arc indices in path order (may be empty)
+     */
+    AddResult add(double cost, const int32_t* items, size_t num_items,
+                  const int32_t* arcs = nullptr, size_t num_arcs = 0) {
+        int32_t max_item = check_items(items, num_items);
+        if (max_item >= num_items_) reserve_items(max_item + 1);
+
+        encode(items, num_items);
+        uint64_t hash = signature_hash(scratch_.data(), arcs, num_arcs);
+        size_t slot = probe(hash, scratch_.data(), arcs, num_arcs);
+        if (slots_[slot] >= 0) return {slots_[slot], false};
+
+        auto index = static_cast<int64_t>(costs_.size());
+        costs_.push_back(cost);
+        coverage_.insert(coverage_.end(), scratch_.begin(), scratch_.end());
+        if (num_arcs > 0) arcs_.insert(arcs_.end(), arcs, arcs + num_arcs);
+        arc_offsets_.push_back(static_cast<int64_t>(arcs_.size()));
+        hashes_.push_back(hash);
+
+        slots_[slot] = index;
+        if (2 * costs_.size() > slots_.size()) rehash(2 * slots_.size());
+        return {index, true};
+    }
+
+    AddResult add(double cost, const std::vector<int32_t>& items,
+                  const std::vector<int32_t>& arcs = {}) {
+        return add(cost, items.data(), items.size(), arcs.data(), arcs.size());
+    }
+
+    /**
+     * @brief Index of the column with this signature, or -1.
+     */
+    int64_t find(const int32_t* items, size_t num_items,
+                 const int32_t* arcs = nullptr, size_t num_arcs = 0) const {
+        int32_t max_item = check_items(items, num_items);
+        if (max_item >= num_items_ || slots_.empty()) return -1;
+
+        encode(items, num_items);
+        uint64_t hash = signature_hash(scratch_.data(), arcs, num_arcs);
+        return slots_[probe(hash, scratch_.data(), arcs, num_arcs)];
+    }
+
+    int64_t find(const std::vector<int32_t>& items, const std::vector<int32_t>& arcs = {}) const {
+        return find(items.data(), items.size(), arcs.data(), arcs.size());
+    }
+
+    bool contains(const std::vector<int32_t>& items, const std::vector<int32_t>& arcs = {}) const {
+        return find(items, arcs) >= 0;
+    }
+
+    // =========================================================================
+    // Column access
+    // =========================================================================
+
+    size_t size() const { return costs_.size(); }
+    bool empty() const { return costs_.empty(); }
+
+    /// Size of the item universe covered so far
+    int32_t num_items() const { return num_items_; }
+
+    /// Coverage bitset width in 64-bit words
+    size_t words_per_column() const { return words_; }
+
+    double cost(size_t index) const { return costs_.at(index); }
+
+    /// Coverage bitset of column @p index (words_per_column() words)
+    const Word* coverage(size_t index) const {
+        check_index(index);
+        return coverage_.data() + index * words_;
+    }
+
+    bool covers(size_t index, int32_t item) const {
+        if (item < 0 || item >= num_items_) return false;
+        const Word* row = coverage(index);
+        return (row[item / WORD_BITS] >> (item % WORD_BITS)) & 1u;
+    }
+
+    /// Covered items of column @p index in ascending order
+    std::vector<int32_t> items(size_t index) const {
+        const Word* row = coverage(index);
+        std::vector<int32_t> result;
+        for (size_t w = 0; w < words_; ++w) {
+            for (Word bits = row[w]; bits != 0; bits &= bits - 1) {
+                result.push_back(static_cast<int32_t>(w * WORD_BITS + count_trailing_zeros(bits)));
+            }
+        }
+        return result;
+    }
+
+    size_t num_arcs(size_t index) const {
+        check_index(index);
+        return static_cast<size_t>(arc_offsets_[index + 1] - arc_offsets_[index]);
+    }
+
+    std::vector<int32_t> arcs(size_t index) const {
+        check_index(index);
+        return std::vector<int32_t>(arcs_.begin() + arc_offsets_[index],
+                                    arcs_.begin() + arc_offsets_[index + 1]);
+    }
+
+    // Raw columnar arrays (valid until the next add/reserve/clear)
+    const std::vector<double>& costs() const { return costs_; }
+    const std::vector<Word>& coverage_data() const { return coverage_; }
+    const std::vector<int64_t>& arc_offsets() const { return arc_offsets_; }
+    const std::vector<int32_t>& arc_data() const { return arcs_; }
+
+    // =========================================================================
+    // Capacity
+    // =========================================================================
+
+    /**
+     * @brief Pre-allocate for @p num_columns columns and @p num_arcs arcs.
+     */
+    void reserve(size_t num_columns, size_t num_arcs = 0) {
+        costs_.reserve(num_columns);
+        coverage_.reserve(num_columns * words_);
+        arc_offsets_.reserve(num_columns + 1);
+        arcs_.reserve(num_arcs);
+        hashes_.reserve(num_columns);
+        size_t capacity = 16;
+        while (capacity < 2 * num_columns) capacity *= 2;
+        if (capacity > slots_.size()) rehash(capacity);
+    }
+
+    /**
+     * @brief Widen the coverage bitsets to hold items below @p num_items.
+     */
+    void reserve_items(int32_t num_items) {
+        if (num_items <= num_items_) return;
+        size_t words = words_for(num_items);
+        if (words > words_) {
+            words = std::max(words, 2 * words_);
+            std::vector<Word> widened(costs_.size() * words, 0);
+            for (size_t i = 0; i < costs_.size(); ++i) {
+                std::memcpy(widened.data() + i * words, coverage_.data() + i * words_,
+                            words_ * sizeof(Word));
+            }
+            coverage_.swap(widened);
+            words_ = words;
+        }
+        num_items_ = num_items;
+    }
+
+    void clear() {
+        costs_.clear();
+        coverage_.clear();
+        arc_offsets_.assign(1, 0);
+        arcs_.clear();
+        hashes_.clear();
+        slots_.clear();
+    }
+
+    /**
+     * @brief Approximate heap memory held by the pool, in bytes.
+     */
+    size_t memory_usage() const {
+        return costs_.capacity() * sizeof(double) + coverage_.capacity() * sizeof(Word) +
+               arc_offsets_.capacity() * sizeof(int64_t) + arcs_.capacity() * sizeof(int32_t) +
+               hashes_.capacity() * sizeof(uint64_t) + slots_.capacity() * sizeof(int64_t);
+    }
+
+    /// Index of the lowest set bit of a nonzero word
+    static int count_trailing_zeros(Word bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(bits);
+#else
+        int n = 0;
+        while (!(bits & 1u)) { bits >>= 1; ++n; }
+        return n;
+#endif
+    }
+
+private:
+    static size_t words_for(int32_t num_items) {
+        return (static_cast<size_t>(num_items) + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    static uint64_t mix(uint64_t x) {
+        // splitmix64 finaliser
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    /// Max item, or -1 if empty; throws on negative items
+    static int32_t check_items(const int32_t* items, size_t num_items) {
+        int32_t max_item = -1;
+        for (size_t k = 0; k < num_items; ++k) {
+            if (items[k] < 0) {
+                throw std::out_of_range("item index " + std::to_string(items[k]) + " is negative");
+            }
+            max_item = std::max(max_item, items[k]);
+        }
+        return max_item;
+    }
+
+    void check_index(size_t index) const {
+        if (index >= costs_.size()) {
+            throw std::out_of_range("column index " + std::to_string(index) + " out of range");
+        }
+    }
+
+    void encode(const int32_t* items, size_t num_items) const {
+        scratch_.assign(words_, 0);
+        for (size_t k = 0; k < num_items; ++k) {
+            scratch_[items[k] / WORD_BITS] |= Word(1) << (items[k] % WORD_BITS);
+        }
+    }
+
+    /// Hash of nonzero words (with their position) and the arc sequence
+    uint64_t signature_hash(const Word* row, const int32_t* arcs, size_t num_arcs) const {
+        uint64_t h = 0x9e3779b97f4a7c15ULL;
+        for (size_t w = 0; w < words_; ++w) {
+            if (row[w] != 0) h = mix(h ^ mix(row[w] + w));
+        }
+        h = mix(h ^ num_arcs);
+        for (size_t k = 0; k < num_arcs; ++k) {
+            h = mix(h ^ static_cast<uint32_t>(arcs[k]));
+        }
+        return h;
+    }
+
+    bool same_signature(int64_t index, const Word* row, const int32_t* arcs, size_t num_arcs) const {
+        const Word* stored = coverage_.data() + static_cast<size_t>(index) * words_;
+        if (std::memcmp(stored, row, words_ * sizeof(Word)) != 0) return false;
+        int64_t begin = arc_offsets_[index];
+        if (static_cast<size_t>(arc_offsets_[index + 1] - begin) != num_arcs) return false;
+        return num_arcs == 0 || std::memcmp(arcs_.data() + begin, arcs, num_arcs * sizeof(int32_t)) == 0;
+    }
+
+    /// Slot holding the matching column, or the empty slot to insert into
+    size_t probe(uint64_t hash, const Word* row, const int32_t* arcs, size_t num_arcs) {
+        if (slots_.empty()) rehash(16);
+        return static_cast<const ColumnPool*>(this)->probe(hash, row, arcs, num_arcs);
+    }
+
+    size_t probe(uint64_t hash, const Word* row, const int32_t* arcs, size_t num_arcs) const {
+        size_t mask = slots_.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            int64_t index = slots_[slot];
+            if (index < 0) return slot;
+            if (hashes_[index] == hash && same_signature(index, row, arcs, num_arcs)) return slot;
+        }
+    }
+
+    void rehash(size_t capacity) {
+        slots_.assign(capacity, -1);
+        size_t mask = capacity - 1;
+        for (size_t i = 0; i < hashes_.size(); ++i) {
+            size_t slot = hashes_[i] & mask;
+            while (slots_[slot] >= 0) slot = (slot + 1) & mask;
+            slots_[slot] = static_cast<int64_t>(i);
+        }
+    }
+
+    int32_t num_items_ = 0;
+    size_t words_ = 0;
+
+    std::vector<double> costs_;
+    std::vector<Word> coverage_;      // size() * words_, row-major
+    std::vector<int64_t> arc_offsets_;  // CSR offsets, size() + 1
+    std::vector<int32_t> arcs_;
+
+    std::vector<uint64_t> hashes_;  // Signature hash per column
+    std::vector<int64_t> slots_;    // Open addressing, -1 = empty, power of two
+    mutable std::vector<Word> scratch_;
+};
+
+}  // namespace openbp
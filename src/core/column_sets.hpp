@@ -0,0 +1,382 @@
+/**
+ * @file column_sets.hpp
+ * @brief Per-node sets of valid pool columns, derived incrementally.
+ *
+ * A child differs from its parent by its local branching decisions, so
+ * its valid columns are the parent's valid columns minus those violating
+ * the local decisions, plus columns added to the pool since the parent's
+ * set was built (checked against the full decision path). A Ryan-Foster
+ * decision on (i, j) can only reject columns covering i or j, which an
+ * item -> columns index lists directly. Sets are stored as a sorted
+ * index list or a bitmap, whichever is smaller.
+ */
+
+#pragma once
+
+#include "column_filter.hpp"
+#include "column_pool.hpp"
+#include "tree.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace openbp {
+
+/**
+ * @brief Immutable set of pool column indices below limit().
+ *
+ * Sparse sets keep sorted 32-bit indices; sets holding more than one
+ * column in 32 switch to a bitmap over [0, limit()).
+ */
+class ColumnSet {
+public:
+    using Word = ColumnPool::Word;
+    static constexpr size_t WORD_BITS = ColumnPool::WORD_BITS;
+
+    ColumnSet() = default;
+
+    /**
+     * @param sorted Ascending column indices, all below @p limit
+     * @param limit Number of pool columns the set was computed over
+     */
+    ColumnSet(std::vector<uint32_t> sorted, size_t limit) : limit_(limit), count_(sorted.size()) {
+        if (32 * sorted.size() > limit) {
+            bits_.assign((limit + WORD_BITS - 1) / WORD_BITS, 0);
+            for (uint32_t c : sorted) bits_[c / WORD_BITS] |= Word(1) << (c % WORD_BITS);
+        } else {
+            indices_ = std::move(sorted);
+            indices_.shrink_to_fit();
+        }
+    }
+
+    /**
+     * @brief @p base without @p removed, plus @p added, over [0, limit).
+     *
+     * @param removed Ascending columns of @p base
+     * @param added Ascending columns in [base.limit(), limit)
+     */
+    static ColumnSet edited(const ColumnSet& base, const std::vector<uint32_t>& removed,
+                            const std::vector<uint32_t>& added, size_t limit) {
+        size_t count = base.count_ - removed.size() + added.size();
+        if (!base.is_bitmap() || 32 * count <= limit) {
+            std::vector<uint32_t> sorted;
+            sorted.reserve(count);
+            auto skip = removed.begin();
+            base.for_each([&](size_t c) {
+                if (skip != removed.end() && *skip == c) {
+                    ++skip;
+                } else {
+                    sorted.push_back(static_cast<uint32_t>(c));
+                }
+            });
+            sorted.insert(sorted.end(), added.begin(), added.end());
+            return ColumnSet(std::move(sorted), limit);
+        }
+
+        // Still dense: copy the words and patch them
+        ColumnSet result;
+        result.limit_ = limit;
+        result.count_ = count;
+        result.bits_.assign((limit + WORD_BITS - 1) / WORD_BITS, 0);
+        std::copy(base.bits_.begin(), base.bits_.end(), result.bits_.begin());
+        for (uint32_t c : removed) result.bits_[c / WORD_BITS] &= ~(Word(1) << (c % WORD_BITS));
+        for (uint32_t c : added) result.bits_[c / WORD_BITS] |= Word(1) << (c % WORD_BITS);
+        return result;
+    }
+
+    /// Columns [0, limit()) were considered when building the set
+    size_t limit() const { return limit_; }
+    size_t count() const { return count_; }
+    bool is_bitmap() const { return !bits_.empty(); }
+
+    bool contains(size_t column) const {
+        if (column >= limit_) return false;
+        if (is_bitmap()) return (bits_[column / WORD_BITS] >> (column % WORD_BITS)) & 1u;
+        return std::binary_search(indices_.begin(), indices_.end(), static_cast<uint32_t>(column));
+    }
+
+    /// Call @p f(index) for each column, ascending
+    template<typename F>
+    void for_each(F&& f) const {
+        if (!is_bitmap()) {
+            for (uint32_t c : indices_) f(static_cast<size_t>(c));
+            return;
+        }
+        for (size_t w = 0; w < bits_.size(); ++w) {
+            for (Word bits = bits_[w]; bits != 0; bits &= bits - 1) {
+                f(w * WORD_BITS + static_cast<size_t>(ColumnPool::count_trailing_zeros(bits)));
+            }
+        }
+    }
+
+    std::vector<int64_t> indices() const {
+        std::vector<int64_t> result;
+        result.reserve(count_);
+        for_each([&](size_t c) { result.push_back(static_cast<int64_t>(c)); });
+        return result;
+    }
+
+    size_t memory_usage() const {
+        return sizeof(*this) + indices_.capacity() * sizeof(uint32_t) + bits_.capacity() * sizeof(Word);
+    }
+
+private:
+    size_t limit_ = 0;
+    size_t count_ = 0;
+    std::vector<uint32_t> indices_;  // Sparse form
+    std::vector<Word> bits_;         // Dense form
+};
+
+/**
+ * @brief Cache of valid-column sets for the open nodes of a tree.
+ *
+ * get() returns a node's set, building it from the cached parent set
+ * when there is one and from the whole pool otherwise. For Ryan-Foster
+ * children the cost is proportional to the columns covering the branched
+ * items plus new columns; other enforced decisions rescan the parent's
+ * set. An item -> columns index (4 bytes per covered item) is kept for
+ * this and extended as the pool grows. branch() derives all
+ * children at once and drops the parent's set, so normally only open
+ * nodes hold a set. Attached to a tree (add_listener), the cache also
+ * drops the sets of nodes the tree closes by pruning; nodes that are
+ * processed without branching should be released by the caller.
+ *
+ * The cache is internally locked and sets are shared immutable objects,
+ * so a returned set stays valid after it is evicted. The pool must not
+ * be modified while a set is being built, and clear() must be called
+ * after the pool is cleared.
+ */
+class NodeColumnSets : public TreeListener {
+public:
+    using SetPtr = std::shared_ptr<const ColumnSet>;
+
+    explicit NodeColumnSets(const ColumnPool& pool) : pool_(pool) {}
+
+    NodeColumnSets(const NodeColumnSets&) = delete;
+    NodeColumnSets& operator=(const NodeColumnSets&) = delete;
+
+    /**
+     * @brief Valid columns of @p node, covering the whole current pool.
+     *
+     * A cached set that predates new pool columns is extended with them.
+     */
+    SetPtr get(const BPNode& node) {
+        SetPtr cached = find(node.id());
+        if (cached && cached->limit() == pool_.size()) return cached;
+
+        SetPtr set;
+        if (cached) {
+            set = extend(*cached, node);
+        } else if (SetPtr parent = node.parent_id() >= 0 ? find(node.parent_id()) : nullptr) {
+            set = derive(*parent, node);
+        } else {
+            set = build(node);
+        }
+        store(node.id(), set);
+        return set;
+    }
+
+    /**
+     * @brief Build the sets of @p children from @p parent's, then drop it.
+     */
+    void branch(const BPNode& parent, const std::vector<BPNode*>& children) {
+        SetPtr base = get(parent);
+        for (const BPNode* child : children) {
+            if (child) store(child->id(), derive(*base, *child));
+        }
+        release(parent.id());
+    }
+
+    void release(BPNode::NodeId id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sets_.erase(id);
+    }
+
+    bool is_cached(BPNode::NodeId id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sets_.count(id) != 0;
+    }
+
+    /// Number of cached sets
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sets_.size();
+    }
+
+    /// Drop all sets and the item index
+    void clear() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sets_.clear();
+        }
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        postings_.clear();
+        indexed_ = 0;
+    }
+
+    /// Approximate bytes held by cached sets and the item index
+    size_t memory_usage() const {
+        size_t total = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& entry : sets_) total += entry.second->memory_usage();
+        }
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        for (const auto& list : postings_) total += sizeof(list) + list.capacity() * sizeof(uint32_t);
+        return total;
+    }
+
+    // TreeListener
+    void on_node_closed(BPNode* node) override { release(node->id()); }
+
+private:
+    SetPtr find(BPNode::NodeId id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sets_.find(id);
+        return it == sets_.end() ? nullptr : it->second;
+    }
+
+    void store(BPNode::NodeId id, SetPtr set) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sets_[id] = std::move(set);
+    }
+
+    /// Full filter over the whole pool
+    SetPtr build(const BPNode& node) const {
+        return std::make_shared<const ColumnSet>(new_columns(ColumnFilter::for_node(node), 0),
+                                                 pool_.size());
+    }
+
+    /// Same node, new pool columns appended
+    SetPtr extend(const ColumnSet& base, const BPNode& node) const {
+        auto added = new_columns(ColumnFilter::for_node(node), base.limit());
+        return std::make_shared<const ColumnSet>(ColumnSet::edited(base, {}, added, pool_.size()));
+    }
+
+    /// Parent's set minus columns rejected by the child's local decisions, plus new columns
+    SetPtr derive(const ColumnSet& parent, const BPNode& child) const {
+        std::vector<uint32_t> removed;
+        if (!local_rejects(parent, child, removed)) {
+            // Decisions the index cannot answer: rescan the parent's set
+            removed.clear();
+            std::vector<uint32_t> candidates;
+            candidates.reserve(parent.count());
+            parent.for_each([&](size_t c) { candidates.push_back(static_cast<uint32_t>(c)); });
+            std::vector<uint8_t> keep(candidates.size(), 1);
+            ColumnFilter(child.local_decisions())
+                .refine_subset(pool_, candidates.data(), candidates.size(), keep.data());
+            for (size_t k = 0; k < candidates.size(); ++k) {
+                if (!keep[k]) removed.push_back(candidates[k]);
+            }
+        }
+        std::vector<uint32_t> added;
+        if (parent.limit() < pool_.size()) added = new_columns(ColumnFilter::for_node(child), parent.limit());
+        return std::make_shared<const ColumnSet>(ColumnSet::edited(parent, removed, added, pool_.size()));
+    }
+
+    /**
+     * @brief Columns of @p parent rejected by @p child's local Ryan-Foster decisions.
+     *
+     * Fills @p removed in ascending order. Returns false, leaving @p removed
+     * unspecified, if a local decision needs a scan (enforced ARC).
+     */
+    bool local_rejects(const ColumnSet& parent, const BPNode& child, std::vector<uint32_t>& removed) const {
+        const auto& decisions = child.local_decisions();
+        for (const auto& d : decisions) {
+            if (d.type() == BranchType::ARC && d.source_node() < 0) return false;
+        }
+
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        sync_index();
+        const uint32_t limit = static_cast<uint32_t>(parent.limit());
+        auto postings = [&](int32_t item) -> const std::vector<uint32_t>& {
+            static const std::vector<uint32_t> none;
+            return static_cast<size_t>(item) < postings_.size() ? postings_[item] : none;
+        };
+        auto reject = [&](uint32_t c) {
+            if (parent.contains(c)) removed.push_back(c);
+        };
+
+        for (const auto& d : decisions) {
+            if (d.type() != BranchType::RYAN_FOSTER) continue;
+            int32_t i = d.item_i(), j = d.item_j();
+            if (i < 0 || j < 0 || (d.same_column() && i == j)) continue;
+            const auto& covers_i = postings(i);
+            const auto& covers_j = postings(j);
+            if (d.same_column()) {
+                // Columns covering exactly one of the pair
+                auto a = covers_i.begin(), b = covers_j.begin();
+                while (a != covers_i.end() || b != covers_j.end()) {
+                    uint32_t c;
+                    if (b == covers_j.end() || (a != covers_i.end() && *a < *b)) {
+                        c = *a++;
+                    } else if (a == covers_i.end() || *b < *a) {
+                        c = *b++;
+                    } else {
+                        ++a, ++b;
+                        continue;
+                    }
+                    if (c >= limit) break;
+                    reject(c);
+                }
+            } else {
+                // Columns covering both: walk the shorter list
+                bool i_shorter = covers_i.size() <= covers_j.size();
+                const auto& walk = i_shorter ? covers_i : covers_j;
+                int32_t other = i_shorter ? j : i;
+                for (uint32_t c : walk) {
+                    if (c >= limit) break;
+                    if (pool_.covers(c, other)) reject(c);
+                }
+            }
+        }
+        if (decisions.size() > 1) {  // Each decision's rejects are ascending on their own
+            std::sort(removed.begin(), removed.end());
+            removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+        }
+        return true;
+    }
+
+    /// Extend the item index over columns added since the last call (index_mutex_ held)
+    void sync_index() const {
+        size_t size = pool_.size();
+        if (size < indexed_) {  // Pool was cleared without clear()
+            postings_.clear();
+            indexed_ = 0;
+        }
+        size_t words = pool_.words_per_column();
+        if (postings_.size() < words * ColumnSet::WORD_BITS) postings_.resize(words * ColumnSet::WORD_BITS);
+        for (size_t c = indexed_; c < size; ++c) {
+            const auto* row = pool_.coverage(c);
+            for (size_t w = 0; w < words; ++w) {
+                for (auto bits = row[w]; bits != 0; bits &= bits - 1) {
+                    size_t bit = static_cast<size_t>(ColumnPool::count_trailing_zeros(bits));
+                    postings_[w * ColumnSet::WORD_BITS + bit].push_back(static_cast<uint32_t>(c));
+                }
+            }
+        }
+        indexed_ = size;
+    }
+
+    std::vector<uint32_t> new_columns(const ColumnFilter& filter, size_t begin) const {
+        std::vector<uint32_t> valid;
+        auto keep = filter.mask(pool_, begin);
+        for (size_t k = 0; k < keep.size(); ++k) {
+            if (keep[k]) valid.push_back(static_cast<uint32_t>(begin + k));
+        }
+        return valid;
+    }
+
+    const ColumnPool& pool_;
+    mutable std::mutex mutex_;
+    std::unordered_map<BPNode::NodeId, SetPtr> sets_;
+
+    mutable std::mutex index_mutex_;
+    mutable std::vector<std::vector<uint32_t>> postings_;  // Item -> ascending columns
+    mutable size_t indexed_ = 0;                           // Columns in postings_
+};
+
+}  // namespace openbp
@@ -0,0 +1,134 @@
+/**
+ * @file incumbent.hpp
+ * @brief Lock-free shared incumbent value for parallel search.
+ *
+ * Workers publish improved solution values with a compare-and-swap and
+ * learn about improvements found elsewhere by polling an epoch counter,
+ * so neither side ever blocks.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace openbp {
+
+/**
+ * @brief Lock-free register holding the best known upper bound.
+ *
+ * offer() lowers the bound with a compare-and-swap loop and bumps the
+ * epoch on every successful improvement. Readers compare the epoch with
+ * the last one they saw (see BoundSubscription) instead of re-reading
+ * and comparing doubles, and never take a lock.
+ *
+ * Only the value is shared; the solution itself stays with the worker
+ * that found it (e.g. as the incumbent node of its BPTree).
+ */
+class IncumbentRegister {
+public:
+    IncumbentRegister() = default;
+
+    // Shared by reference between workers
+    IncumbentRegister(const IncumbentRegister&) = delete;
+    IncumbentRegister& operator=(const IncumbentRegister&) = delete;
+
+    /**
+     * @brief Offer a solution value.
+     * @param value Objective value of the solution
+     * @param source Identifier of the offering worker (for reporting)
+     * @return true if @p value improved the upper bound
+     */
+    bool offer(double value, int32_t source = -1) {
+        double current = upper_bound_.load(std::memory_order_acquire);
+        while (value < current) {
+            if (upper_bound_.compare_exchange_weak(current, value, std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {
+                source_.store(source, std::memory_order_relaxed);
+                epoch_.fetch_add(1, std::memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    double upper_bound() const { return upper_bound_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Number of improvements so far.
+     */
+    uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Source of the latest improvement, or -1.
+     */
+    int32_t source() const { return source_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Forget the bound (not safe while workers are running).
+     */
+    void reset() {
+        upper_bound_.store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+        source_.store(-1, std::memory_order_relaxed);
+        epoch_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<double> upper_bound_{std::numeric_limits<double>::infinity()};
+    std::atomic<uint64_t> epoch_{0};
+    std::atomic<int32_t> source_{-1};
+};
+
+
+/**
+ * @brief A consumer's view of an IncumbentRegister.
+ *
+ * poll() runs the callback on the polling thread whenever the register
+ * improved since the last delivery. Several improvements between two
+ * polls are delivered as one call with the latest bound, which batches
+ * the work done in response (e.g. pruning).
+ *
+ * A subscription may be polled by several threads: each improvement is
+ * claimed by exactly one poller with a compare-and-swap on the seen
+ * epoch, so a shared selector is notified once rather than once per
+ * worker. Callbacks of different pollers can still overlap.
+ */
+class BoundSubscription {
+public:
+    using Callback = std::function<void(double upper_bound)>;
+
+    BoundSubscription(const IncumbentRegister& reg, Callback on_improve)
+        : register_(&reg)
+        , on_improve_(std::move(on_improve))
+        , seen_epoch_(reg.epoch())
+    {}
+
+    BoundSubscription(const BoundSubscription&) = delete;
+    BoundSubscription& operator=(const BoundSubscription&) = delete;
+
+    /**
+     * @brief Deliver a pending improvement, if any.
+     * @return true if the callback ran
+     */
+    bool poll() {
+        uint64_t seen = seen_epoch_.load(std::memory_order_relaxed);
+        uint64_t epoch = register_->epoch();
+        if (epoch == seen) return false;
+        if (!seen_epoch_.compare_exchange_strong(seen, epoch, std::memory_order_acq_rel)) {
+            return false;  // Claimed by another poller
+        }
+        if (on_improve_) on_improve_(register_->upper_bound());
+        return true;
+    }
+
+    uint64_t seen_epoch() const { return seen_epoch_.load(std::memory_order_relaxed); }
+
+private:
+    const IncumbentRegister* register_;
+    Callback on_improve_;
+    std::atomic<uint64_t> seen_epoch_;
+};
+
+}  // namespace openbp
@@ -0,0 +1,327 @@
+/**
+ * @file indexed_heap.hpp
+ * @brief Addressable d-ary heap of tree nodes.
+ *
+ * Supports O(log n) removal and priority updates of arbitrary nodes by
+ * tracking each node's heap position, keyed by its NodeId.
+ */
+
+#pragma once
+
+#include "node.hpp"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+#include <utility>
+
+namespace openbp {
+
+/**
+ * @brief Heap positions in a dense table indexed by NodeId.
+ *
+ * O(1) lookups with no hashing. The table grows to the largest NodeId the
+ * heap ever held and never shrinks, so use it for heaps that see most of
+ * the tree's nodes.
+ */
+class DensePositions {
+public:
+    static constexpr uint32_t NPOS = std::numeric_limits<uint32_t>::max();
+
+    uint32_t get(BPNode::NodeId id) const {
+        auto k = static_cast<size_t>(id);
+        return k < pos_.size() ? pos_[k] : NPOS;
+    }
+
+    void set(BPNode::NodeId id, uint32_t pos) {
+        auto k = static_cast<size_t>(id);
+        if (k >= pos_.size()) pos_.resize(std::max(k + 1, pos_.size() * 2), NPOS);
+        pos_[k] = pos;
+    }
+
+    void erase(BPNode::NodeId id) {
+        auto k = static_cast<size_t>(id);
+        if (k < pos_.size()) pos_[k] = NPOS;
+    }
+
+private:
+    std::vector<uint32_t> pos_;
+};
+
+/**
+ * @brief Heap positions in an open-addressing hash map keyed by NodeId.
+ *
+ * Memory is proportional to the number of held nodes, not to the largest
+ * NodeId: the table doubles above half full and halves below one eighth.
+ * Linear probing with backward-shift deletion, so there are no tombstones.
+ * Use it for heaps that only ever hold a small part of the tree.
+ */
+class HashedPositions {
+public:
+    static constexpr uint32_t NPOS = std::numeric_limits<uint32_t>::max();
+
+    uint32_t get(BPNode::NodeId id) const {
+        if (size_ == 0) return NPOS;
+        for (size_t slot = home(id);; slot = next(slot)) {
+            if (slots_[slot].id == id) return slots_[slot].pos;
+            if (slots_[slot].id == EMPTY) return NPOS;
+        }
+    }
+
+    void set(BPNode::NodeId id, uint32_t pos) {
+        if (2 * (size_ + 1) > slots_.size()) rehash(std::max(MIN_CAPACITY, 2 * slots_.size()));
+        size_t slot = home(id);
+        while (slots_[slot].id != id && slots_[slot].id != EMPTY) slot = next(slot);
+        if (slots_[slot].id == EMPTY) {
+            slots_[slot].id = id;
+            ++size_;
+        }
+        slots_[slot].pos = pos;
+    }
+
+    void erase(BPNode::NodeId id) {
+        if (size_ == 0) return;
+        size_t hole = home(id);
+        while (slots_[hole].id != id) {
+            if (slots_[hole].id == EMPTY) return;
+            hole = next(hole);
+        }
+        // Shift later entries of the probe run back into the hole
+        for (size_t slot = next(hole); slots_[slot].id != EMPTY; slot = next(slot)) {
+            size_t want = home(slots_[slot].id);
+            if (((slot - want) & mask()) >= ((slot - hole) & mask())) {
+                slots_[hole] = slots_[slot];
+                hole = slot;
+            }
+        }
+        slots_[hole].id = EMPTY;
+        --size_;
+        if (slots_.size() > MIN_CAPACITY && 8 * size_ < slots_.size()) rehash(slots_.size() / 2);
+    }
+
+private:
+    static constexpr BPNode::NodeId EMPTY = BPNode::INVALID_ID;
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    struct Slot {
+        BPNode::NodeId id = EMPTY;
+        uint32_t pos = NPOS;
+    };
+
+    size_t mask() const { return slots_.size() - 1; }
+    size_t next(size_t slot) const { return (slot + 1) & mask(); }
+
+    // IDs are sequential, so nodes created together land in neighbouring slots
+    size_t home(BPNode::NodeId id) const { return static_cast<size_t>(id) & mask(); }
+
+    void rehash(size_t capacity) {
+        std::vector<Slot> old(capacity);
+        old.swap(slots_);
+        for (const Slot& entry : old) {
+            if (entry.id == EMPTY) continue;
+            size_t slot = home(entry.id);
+            while (slots_[slot].id != EMPTY) slot = next(slot);
+            slots_[slot] = entry;
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Indexed d-ary heap of BPNode pointers.
+ *
+ * Positions are kept in a per-heap side map keyed by NodeId, so several
+ * heaps can hold the same node independently. A 4-ary layout keeps the
+ * tree shallow and sift-down cache-friendly.
+ *
+ * @tparam Before Strict ordering: Before(a, b) is true if a must be
+ *         selected before b (i.e. a sits closer to the top)
+ * @tparam Arity Number of children per heap node
+ * @tparam Positions Position map: DensePositions (default) or HashedPositions
+ */
+template<typename Before, size_t Arity = 4, typename Positions = DensePositions>
+class IndexedHeap {
+    static_assert(Arity >= 2, "IndexedHeap needs at least two children per node");
+
+public:
+    static constexpr uint32_t NPOS = std::numeric_limits<uint32_t>::max();
+
+    explicit IndexedHeap(Before before = Before())
+        : before_(std::move(before))
+    {}
+
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+
+    BPNode* top() const { return heap_.empty() ? nullptr : heap_.front(); }
+
+    /**
+     * @brief Underlying array in heap order (for scans, not for mutation).
+     */
+    const std::vector<BPNode*>& items() const { return heap_; }
+
+    bool contains(const BPNode* node) const {
+        return position(node) != NPOS;
+    }
+
+    /**
+     * @brief Insert a node, or reposition it if already present.
+     */
+    void push(BPNode* node) {
+        if (contains(node)) {
+            update(node);
+            return;
+        }
+        set_position(node, static_cast<uint32_t>(heap_.size()));
+        heap_.push_back(node);
+        sift_up(heap_.size() - 1);
+    }
+
+    /**
+     * @brief Remove and return the top node (nullptr if empty).
+     */
+    BPNode* pop() {
+        if (heap_.empty()) return nullptr;
+        BPNode* node = heap_.front();
+        erase_at(0);
+        return node;
+    }
+
+    /**
+     * @brief Remove an arbitrary node in O(log n).
+     * @return true if the node was in the heap
+     */
+    bool remove(const BPNode* node) {
+        uint32_t pos = position(node);
+        if (pos == NPOS) return false;
+        erase_at(pos);
+        return true;
+    }
+
+    /**
+     * @brief Restore heap order after the node's key changed, in O(log n).
+     * @return true if the node was in the heap
+     */
+    bool update(const BPNode* node) {
+        uint32_t pos = position(node);
+        if (pos == NPOS) return false;
+        size_t at = sift_up(pos);
+        if (at == pos) sift_down(pos);
+        return true;
+    }
+
+    /**
+     * @brief Remove all nodes matching @p pred in a single O(n) pass.
+     * @return Number of nodes removed
+     */
+    template<typename Pred>
+    size_t remove_if(Pred&& pred) {
+        size_t kept = 0;
+        for (size_t k = 0; k < heap_.size(); ++k) {
+            BPNode* node = heap_[k];
+            if (pred(node)) {
+                set_position(node, NPOS);
+            } else {
+                heap_[kept++] = node;
+            }
+        }
+        size_t removed = heap_.size() - kept;
+        heap_.resize(kept);
+        rebuild();
+        return removed;
+    }
+
+    /**
+     * @brief Re-establish heap order for all nodes in O(n).
+     *
+     * Use after keys changed in bulk (e.g. when the ordering depends on
+     * external state that was updated).
+     */
+    void rebuild() {
+        for (size_t k = 0; k < heap_.size(); ++k) {
+            set_position(heap_[k], static_cast<uint32_t>(k));
+        }
+        if (heap_.size() < 2) return;
+        for (size_t k = parent_of(heap_.size() - 1) + 1; k-- > 0;) {
+            sift_down(k);
+        }
+    }
+
+    void clear() {
+        for (BPNode* node : heap_) set_position(node, NPOS);
+        heap_.clear();
+    }
+
+    Before& ordering() { return before_; }
+    const Before& ordering() const { return before_; }
+
+private:
+    static size_t parent_of(size_t k) { return (k - 1) / Arity; }
+
+    uint32_t position(const BPNode* node) const {
+        return positions_.get(node->id());
+    }
+
+    void set_position(const BPNode* node, uint32_t pos) {
+        if (pos == NPOS) {
+            positions_.erase(node->id());
+        } else {
+            positions_.set(node->id(), pos);
+        }
+    }
+
+    void place(size_t k, BPNode* node) {
+        heap_[k] = node;
+        set_position(node, static_cast<uint32_t>(k));
+    }
+
+    void erase_at(size_t k) {
+        set_position(heap_[k], NPOS);
+        BPNode* last = heap_.back();
+        heap_.pop_back();
+        if (k == heap_.size()) return;
+        place(k, last);
+        size_t at = sift_up(k);
+        if (at == k) sift_down(k);
+    }
+
+    size_t sift_up(size_t k) {
+        BPNode* node = heap_[k];
+        while (k > 0) {
+            size_t parent = parent_of(k);
+            if (!before_(node, heap_[parent])) break;
+            place(k, heap_[parent]);
+            k = parent;
+        }
+        place(k, node);
+        return k;
+    }
+
+    void sift_down(size_t k) {
+        BPNode* node = heap_[k];
+        const size_t n = heap_.size();
+        while (true) {
+            size_t first = k * Arity + 1;
+            if (first >= n) break;
+            size_t last = std::min(first + Arity, n);
+            size_t best = first;
+            for (size_t c = first + 1; c < last; ++c) {
+                if (before_(heap_[c], heap_[best])) best = c;
+            }
+            if (!before_(heap_[best], node)) break;
+            place(k, heap_[best]);
+            k = best;
+        }
+        place(k, node);
+    }
+
+    Before before_;
+    std::vector<BPNode*> heap_;
+    Positions positions_;
+};
+
+}  // namespace openbp
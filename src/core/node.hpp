@@ -15,6 +15,14 @@
 #include <string>
 #include <optional>
 #include <variant>
+#include <iterator>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <stdexcept>
+#include <new>
 
 namespace openbp {
 
@@ -42,76 +50,675 @@ enum class BranchType : uint8_t {
     CUSTOM          // User-defined branching
 };
 
+/**
+ * @brief Read-only view over a contiguous array (minimal span).
+ */
+template<typename T>
+struct ArrayView {
+    const T* data = nullptr;
+    size_t size = 0;
+
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    const T& operator[](size_t i) const { return data[i]; }
+    bool empty() const { return size == 0; }
+    std::vector<T> to_vector() const { return std::vector<T>(begin(), end()); }
+};
+
+/**
+ * @brief Reference-counted, immutable storage for a CUSTOM branching payload.
+ *
+ * CUSTOM decisions hold a single pointer to a block, which keeps
+ * BranchingDecision at 32 bytes. Copies of a decision share the block and
+ * it is freed together with the last decision that refers to it. The
+ * header and both arrays live in one allocation.
+ */
+class alignas(double) CustomPayloadBlock {
+public:
+    /// New block with one reference; nullptr when both arrays are empty
+    static CustomPayloadBlock* create(const int32_t* ints, size_t num_ints,
+                                      const double* floats, size_t num_floats) {
+        if (num_ints == 0 && num_floats == 0) return nullptr;
+        if (num_ints > std::numeric_limits<uint32_t>::max() ||
+            num_floats > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("custom branching payload exceeds 2^32 - 1 entries");
+        }
+        void* memory = ::operator new(sizeof(CustomPayloadBlock) +
+                                      num_floats * sizeof(double) + num_ints * sizeof(int32_t));
+        auto* block = new (memory) CustomPayloadBlock(static_cast<uint32_t>(num_ints),
+                                                      static_cast<uint32_t>(num_floats));
+        std::copy(floats, floats + num_floats, block->float_data());
+        std::copy(ints, ints + num_ints, block->int_data());
+        return block;
+    }
+
+    void retain() const { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+    void release() const {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            this->~CustomPayloadBlock();
+            ::operator delete(const_cast<CustomPayloadBlock*>(this));
+        }
+    }
+
+    ArrayView<int32_t> ints() const {
+        return {const_cast<CustomPayloadBlock*>(this)->int_data(), int_size_};
+    }
+    ArrayView<double> floats() const {
+        return {const_cast<CustomPayloadBlock*>(this)->float_data(), float_size_};
+    }
+
+private:
+    CustomPayloadBlock(uint32_t int_size, uint32_t float_size)
+        : int_size_(int_size), float_size_(float_size) {}
+
+    // Doubles first so both arrays are naturally aligned after the header
+    double* float_data() { return reinterpret_cast<double*>(this + 1); }
+    int32_t* int_data() { return reinterpret_cast<int32_t*>(float_data() + float_size_); }
+
+    mutable std::atomic<uint32_t> refs_{1};
+    uint32_t int_size_;
+    uint32_t float_size_;
+};
+
+static_assert(sizeof(CustomPayloadBlock) % alignof(double) == 0,
+              "CustomPayloadBlock header must keep the trailing doubles aligned");
+
 /**
  * @brief A single branching decision.
  *
  * Branching decisions are polymorphic - the interpretation depends on
- * the branch type. This allows different branching strategies to store
- * their decisions in a uniform container.
+ * the branch type. The layout is a tagged union of per-type payloads
+ * (32 bytes), so decisions can be stored densely. CUSTOM payloads live in
+ * a shared CustomPayloadBlock; copying any other type is a plain copy.
+ *
+ * Field accessors return the type's default value when the decision is
+ * of a different type; setters re-tag the decision to the field's type.
  */
 struct BranchingDecision {
-    BranchType type;
+    struct VariablePayload {
+        int32_t variable_index;
+        bool is_upper_bound;  // true = x <= k, false = x >= k
+        double bound_value;
+    };
+
+    struct RyanFosterPayload {
+        int32_t item_i;
+        int32_t item_j;
+        bool same_column;  // true = must be together, false = must be apart
+    };
+
+    struct ArcPayload {
+        int32_t arc_index;
+        int32_t source_node;
+        bool arc_required;  // true = arc must be used, false = forbidden
+    };
+
+    struct ResourcePayload {
+        int32_t resource_index;
+        double lower_bound;
+        double upper_bound;
+    };
+
+    struct CustomPayload {
+        const CustomPayloadBlock* block;  // nullptr when both arrays are empty
+    };
+
+    BranchingDecision() : type_(BranchType::VARIABLE) { reset(BranchType::VARIABLE); }
+
+    BranchingDecision(const BranchingDecision& other)
+        : type_(other.type_), payload_(other.payload_) {
+        retain();
+    }
+
+    BranchingDecision(BranchingDecision&& other) noexcept
+        : type_(other.type_), payload_(other.payload_) {
+        other.reset(BranchType::VARIABLE);
+    }
 
-    // For VARIABLE branching
-    int32_t variable_index = -1;
-    double bound_value = 0.0;
-    bool is_upper_bound = false;  // true = x <= k, false = x >= k
+    BranchingDecision& operator=(const BranchingDecision& other) {
+        other.retain();
+        release();
+        type_ = other.type_;
+        payload_ = other.payload_;
+        return *this;
+    }
+
+    BranchingDecision& operator=(BranchingDecision&& other) noexcept {
+        if (this != &other) {
+            release();
+            type_ = other.type_;
+            payload_ = other.payload_;
+            other.reset(BranchType::VARIABLE);
+        }
+        return *this;
+    }
+
+    ~BranchingDecision() { release(); }
+
+    BranchType type() const { return type_; }
+
+    /**
+     * @brief Change the type; the payload is reset to that type's defaults.
+     */
+    void set_type(BranchType type) {
+        if (type == type_) return;
+        release();
+        reset(type);
+    }
 
-    // For RYAN_FOSTER branching
-    int32_t item_i = -1;
-    int32_t item_j = -1;
-    bool same_column = false;  // true = must be together, false = must be apart
+    // VARIABLE branching
+    int32_t variable_index() const { return is(BranchType::VARIABLE) ? payload_.variable.variable_index : -1; }
+    double bound_value() const { return is(BranchType::VARIABLE) ? payload_.variable.bound_value : 0.0; }
+    bool is_upper_bound() const { return is(BranchType::VARIABLE) && payload_.variable.is_upper_bound; }
+    void set_variable_index(int32_t v) { retag(BranchType::VARIABLE).variable.variable_index = v; }
+    void set_bound_value(double v) { retag(BranchType::VARIABLE).variable.bound_value = v; }
+    void set_is_upper_bound(bool v) { retag(BranchType::VARIABLE).variable.is_upper_bound = v; }
 
-    // For ARC branching
-    int32_t arc_index = -1;
-    int32_t source_node = -1;
-    bool arc_required = false;  // true = arc must be used, false = forbidden
+    // RYAN_FOSTER branching
+    int32_t item_i() const { return is(BranchType::RYAN_FOSTER) ? payload_.ryan_foster.item_i : -1; }
+    int32_t item_j() const { return is(BranchType::RYAN_FOSTER) ? payload_.ryan_foster.item_j : -1; }
+    bool same_column() const { return is(BranchType::RYAN_FOSTER) && payload_.ryan_foster.same_column; }
+    void set_item_i(int32_t v) { retag(BranchType::RYAN_FOSTER).ryan_foster.item_i = v; }
+    void set_item_j(int32_t v) { retag(BranchType::RYAN_FOSTER).ryan_foster.item_j = v; }
+    void set_same_column(bool v) { retag(BranchType::RYAN_FOSTER).ryan_foster.same_column = v; }
 
-    // For RESOURCE branching
-    int32_t resource_index = -1;
-    double lower_bound = 0.0;
-    double upper_bound = std::numeric_limits<double>::infinity();
+    // ARC branching
+    int32_t arc_index() const { return is(BranchType::ARC) ? payload_.arc.arc_index : -1; }
+    int32_t source_node() const { return is(BranchType::ARC) ? payload_.arc.source_node : -1; }
+    bool arc_required() const { return is(BranchType::ARC) && payload_.arc.arc_required; }
+    void set_arc_index(int32_t v) { retag(BranchType::ARC).arc.arc_index = v; }
+    void set_source_node(int32_t v) { retag(BranchType::ARC).arc.source_node = v; }
+    void set_arc_required(bool v) { retag(BranchType::ARC).arc.arc_required = v; }
 
-    // For CUSTOM branching - opaque data that strategies can interpret
-    std::vector<int32_t> custom_int_data;
-    std::vector<double> custom_float_data;
+    // RESOURCE branching
+    int32_t resource_index() const { return is(BranchType::RESOURCE) ? payload_.resource.resource_index : -1; }
+    double lower_bound() const { return is(BranchType::RESOURCE) ? payload_.resource.lower_bound : 0.0; }
+    double upper_bound() const {
+        return is(BranchType::RESOURCE) ? payload_.resource.upper_bound
+                                        : std::numeric_limits<double>::infinity();
+    }
+    void set_resource_index(int32_t v) { retag(BranchType::RESOURCE).resource.resource_index = v; }
+    void set_lower_bound(double v) { retag(BranchType::RESOURCE).resource.lower_bound = v; }
+    void set_upper_bound(double v) { retag(BranchType::RESOURCE).resource.upper_bound = v; }
+
+    // CUSTOM branching - opaque data that strategies can interpret
+    ArrayView<int32_t> custom_int_data() const {
+        if (!is(BranchType::CUSTOM) || !payload_.custom.block) return {};
+        return payload_.custom.block->ints();
+    }
+    ArrayView<double> custom_float_data() const {
+        if (!is(BranchType::CUSTOM) || !payload_.custom.block) return {};
+        return payload_.custom.block->floats();
+    }
+    // Blocks are shared between copies, so setters build a new block
+    void set_custom_int_data(const std::vector<int32_t>& data) {
+        ArrayView<double> floats = custom_float_data();
+        adopt_custom(CustomPayloadBlock::create(data.data(), data.size(), floats.data, floats.size));
+    }
+    void set_custom_float_data(const std::vector<double>& data) {
+        ArrayView<int32_t> ints = custom_int_data();
+        adopt_custom(CustomPayloadBlock::create(ints.data, ints.size, data.data(), data.size()));
+    }
 
     // Factory methods
     static BranchingDecision variable_branch(int32_t var_idx, double value, bool upper) {
         BranchingDecision d;
-        d.type = BranchType::VARIABLE;
-        d.variable_index = var_idx;
-        d.bound_value = value;
-        d.is_upper_bound = upper;
+        d.payload_.variable = {var_idx, upper, value};
         return d;
     }
 
     static BranchingDecision ryan_foster(int32_t i, int32_t j, bool same) {
         BranchingDecision d;
-        d.type = BranchType::RYAN_FOSTER;
-        d.item_i = i;
-        d.item_j = j;
-        d.same_column = same;
+        d.type_ = BranchType::RYAN_FOSTER;
+        d.payload_.ryan_foster = {i, j, same};
         return d;
     }
 
     static BranchingDecision arc_branch(int32_t arc, int32_t source, bool required) {
         BranchingDecision d;
-        d.type = BranchType::ARC;
-        d.arc_index = arc;
-        d.source_node = source;
-        d.arc_required = required;
+        d.type_ = BranchType::ARC;
+        d.payload_.arc = {arc, source, required};
         return d;
     }
 
     static BranchingDecision resource_branch(int32_t res_idx, double lb, double ub) {
         BranchingDecision d;
-        d.type = BranchType::RESOURCE;
-        d.resource_index = res_idx;
-        d.lower_bound = lb;
-        d.upper_bound = ub;
+        d.type_ = BranchType::RESOURCE;
+        d.payload_.resource = {res_idx, lb, ub};
         return d;
     }
+
+    static BranchingDecision custom(const std::vector<int32_t>& int_data,
+                                    const std::vector<double>& float_data) {
+        BranchingDecision d;
+        d.adopt_custom(CustomPayloadBlock::create(int_data.data(), int_data.size(),
+                                                  float_data.data(), float_data.size()));
+        return d;
+    }
+
+private:
+    union Payload {
+        VariablePayload variable;
+        RyanFosterPayload ryan_foster;
+        ArcPayload arc;
+        ResourcePayload resource;
+        CustomPayload custom;
+    };
+
+    bool is(BranchType type) const { return type_ == type; }
+
+    Payload& retag(BranchType type) {
+        set_type(type);
+        return payload_;
+    }
+
+    void retain() const {
+        if (is(BranchType::CUSTOM) && payload_.custom.block) payload_.custom.block->retain();
+    }
+
+    void release() {
+        if (is(BranchType::CUSTOM) && payload_.custom.block) {
+            payload_.custom.block->release();
+            payload_.custom.block = nullptr;
+        }
+    }
+
+    /// Take ownership of @p block (one reference) as this decision's payload
+    void adopt_custom(const CustomPayloadBlock* block) {
+        release();
+        type_ = BranchType::CUSTOM;
+        payload_.custom.block = block;
+    }
+
+    void reset(BranchType type) {
+        type_ = type;
+        switch (type) {
+            case BranchType::VARIABLE:
+                payload_.variable = {-1, false, 0.0};
+                break;
+            case BranchType::RYAN_FOSTER:
+                payload_.ryan_foster = {-1, -1, false};
+                break;
+            case BranchType::ARC:
+                payload_.arc = {-1, -1, false};
+                break;
+            case BranchType::RESOURCE:
+                payload_.resource = {-1, 0.0, std::numeric_limits<double>::infinity()};
+                break;
+            case BranchType::CUSTOM:
+                payload_.custom = {nullptr};
+                break;
+        }
+    }
+
+    BranchType type_;
+    Payload payload_;
+};
+
+static_assert(std::is_nothrow_move_constructible<BranchingDecision>::value,
+              "BranchingDecision moves must not allocate or throw");
+static_assert(sizeof(BranchingDecision) <= 32,
+              "BranchingDecision grew beyond its compact layout");
+
+/**
+ * @brief Persistent, structurally shared sequence of branching decisions.
+ *
+ * A DecisionPath is an immutable singly-linked list where each link holds
+ * one decision and points at the link for the previous decision on the
+ * root-to-node path. Children extend their parent's path by one link, so
+ * every prefix is shared between a node, its siblings and its descendants
+ * instead of being copied. Appending is O(1); iteration walks from the
+ * most recent decision back toward the root.
+ */
+class DecisionPath {
+    struct Link {
+        BranchingDecision decision;
+        std::shared_ptr<const Link> prev;
+        size_t size;  // Decisions up to and including this one
+    };
+
+public:
+    /**
+     * @brief Forward iterator over decisions, most recent first.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = BranchingDecision;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const BranchingDecision*;
+        using reference = const BranchingDecision&;
+
+        const_iterator() = default;
+        explicit const_iterator(const Link* link) : link_(link) {}
+
+        reference operator*() const { return link_->decision; }
+        pointer operator->() const { return &link_->decision; }
+
+        const_iterator& operator++() {
+            link_ = link_->prev.get();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const { return link_ == other.link_; }
+        bool operator!=(const const_iterator& other) const { return link_ != other.link_; }
+
+    private:
+        const Link* link_ = nullptr;
+    };
+
+    DecisionPath() = default;
+    DecisionPath(const DecisionPath&) = default;
+    DecisionPath(DecisionPath&&) noexcept = default;
+    DecisionPath& operator=(const DecisionPath&) = default;
+
+    DecisionPath& operator=(DecisionPath&& other) noexcept {
+        if (this != &other) {
+            release();
+            tail_ = std::move(other.tail_);
+        }
+        return *this;
+    }
+
+    ~DecisionPath() { release(); }
+
+    /**
+     * @brief Build a path from decisions given in root-to-node order.
+     */
+    static DecisionPath from_vector(const std::vector<BranchingDecision>& decisions) {
+        DecisionPath path;
+        for (const auto& d : decisions) {
+            path = path.push(d);
+        }
+        return path;
+    }
+
+    size_t size() const { return tail_ ? tail_->size : 0; }
+    bool empty() const { return !tail_; }
+
+    /**
+     * @brief Return a new path extended by one decision (this path is unchanged).
+     */
+    DecisionPath push(const BranchingDecision& decision) const {
+        DecisionPath extended;
+        extended.tail_ = std::make_shared<const Link>(Link{decision, tail_, size() + 1});
+        return extended;
+    }
+
+    /**
+     * @brief Return the path without its last @p count decisions.
+     */
+    DecisionPath drop_back(size_t count) const {
+        DecisionPath prefix;
+        const std::shared_ptr<const Link>* link = &tail_;
+        for (size_t k = 0; k < count && *link; ++k) {
+            link = &(*link)->prev;
+        }
+        prefix.tail_ = *link;
+        return prefix;
+    }
+
+    /**
+     * @brief Most recent decision (path must not be empty).
+     */
+    const BranchingDecision& back() const { return tail_->decision; }
+
+    const_iterator begin() const { return const_iterator(tail_.get()); }
+    const_iterator end() const { return const_iterator(); }
+
+    /**
+     * @brief Materialise the path as a vector in root-to-node order.
+     */
+    std::vector<BranchingDecision> to_vector() const {
+        std::vector<BranchingDecision> out(size());
+        size_t k = out.size();
+        for (const auto& d : *this) {
+            out[--k] = d;
+        }
+        return out;
+    }
+
+    /**
+     * @brief Whether two paths share the same last link (and thus are identical).
+     */
+    bool same_as(const DecisionPath& other) const { return tail_ == other.tail_; }
+
+private:
+    // Unlink iteratively so that dropping the last owner of a very deep
+    // path does not recurse once per decision in shared_ptr destructors.
+    void release() noexcept {
+        std::shared_ptr<const Link> link = std::move(tail_);
+        while (link && link.use_count() == 1) {
+            std::shared_ptr<const Link> prev = std::move(const_cast<Link&>(*link).prev);
+            link = std::move(prev);
+        }
+    }
+
+    std::shared_ptr<const Link> tail_;
+};
+
+/**
+ * @brief Transitive closure of Ryan-Foster decisions on a path.
+ *
+ * "Same" decisions are merged with union-find (union by size), so items
+ * fall into classes that must share a column; "different" decisions link
+ * two classes that must be apart. A pair of items is implied when both
+ * lie in one class (together) or in two linked classes (apart). The
+ * closure is infeasible once a class must be apart from itself, e.g.
+ * same(i,j), same(j,k), diff(i,k); no column set can then satisfy the
+ * path, so the node can be closed without solving its LP.
+ *
+ * Only items named by decisions are stored, in flat arrays, so copying a
+ * closure is a few memcpys. Each class keeps its "apart" links in an
+ * intrusive list that a union splices in O(1). Queries are const and
+ * O(log n) (plus the smaller class's links for apart()).
+ */
+class RyanFosterClosure {
+public:
+    RyanFosterClosure() = default;
+
+    explicit RyanFosterClosure(const std::vector<BranchingDecision>& decisions) {
+        entries_.reserve(2 * decisions.size());
+        lookup_.reserve(2 * decisions.size());
+        for (const auto& d : decisions) add(d);
+    }
+
+    /**
+     * @brief Merge one decision (non Ryan-Foster decisions are ignored).
+     * @return false if the closure is infeasible afterwards
+     */
+    bool add(const BranchingDecision& decision) {
+        if (decision.type() != BranchType::RYAN_FOSTER) return feasible_;
+        int32_t i = decision.item_i(), j = decision.item_j();
+        if (i < 0 || j < 0) return feasible_;
+
+        uint32_t a = find(intern(i));
+        uint32_t b = find(intern(j));
+        if (decision.same_column()) {
+            if (a == b) return feasible_;
+            if (classes_apart(a, b)) feasible_ = false;
+            if (entries_[a].size < entries_[b].size) std::swap(a, b);
+            Entry& root = entries_[a];
+            const Entry& child = entries_[b];
+            entries_[b].parent = a;
+            root.size += child.size;
+            if (child.head != NONE) {
+                (root.head == NONE ? root.head : links_[root.tail].next) = child.head;
+                root.tail = child.tail;
+                root.num_links += child.num_links;
+            }
+        } else {
+            if (a == b) feasible_ = false;  // Includes diff(i, i)
+            link(a, b);
+            if (a != b) link(b, a);
+        }
+        return feasible_;
+    }
+
+    bool feasible() const { return feasible_; }
+
+    /// Number of distinct items named by the decisions
+    size_t num_items() const { return entries_.size(); }
+
+    /// Item that represents @p item's class (@p item itself if undecided)
+    int32_t representative(int32_t item) const {
+        int64_t k = position(item);
+        return k < 0 ? item : entries_[find(static_cast<uint32_t>(k))].item;
+    }
+
+    /// Whether the decisions force @p i and @p j into the same column
+    bool together(int32_t i, int32_t j) const {
+        if (i == j) return true;
+        int64_t a = position(i), b = position(j);
+        return a >= 0 && b >= 0 && find(static_cast<uint32_t>(a)) == find(static_cast<uint32_t>(b));
+    }
+
+    /// Whether the decisions force @p i and @p j into different columns
+    bool apart(int32_t i, int32_t j) const {
+        int64_t a = position(i), b = position(j);
+        if (a < 0 || b < 0) return false;
+        uint32_t ra = find(static_cast<uint32_t>(a)), rb = find(static_cast<uint32_t>(b));
+        return ra != rb && classes_apart(ra, rb);
+    }
+
+    /// Whether branching on (i, j) is redundant: the pair is already decided
+    bool implied(int32_t i, int32_t j) const { return together(i, j) || apart(i, j); }
+
+    /**
+     * @brief All decided pairs (i < j) of the requested kind, sorted.
+     *
+     * Sizes are products of class sizes, which stay small in practice
+     * (bounded by the square of the number of decisions).
+     */
+    std::vector<std::pair<int32_t, int32_t>> implied_pairs(bool same) const {
+        std::vector<std::vector<int32_t>> members(entries_.size());
+        for (uint32_t k = 0; k < entries_.size(); ++k) members[find(k)].push_back(entries_[k].item);
+
+        std::vector<std::pair<int32_t, int32_t>> pairs;
+        auto emit = [&](int32_t x, int32_t y) { pairs.push_back({std::min(x, y), std::max(x, y)}); };
+        for (uint32_t r = 0; r < entries_.size(); ++r) {
+            if (entries_[r].parent != r) continue;
+            if (same) {
+                const auto& cls = members[r];
+                for (size_t x = 0; x < cls.size(); ++x) {
+                    for (size_t y = x + 1; y < cls.size(); ++y) emit(cls[x], cls[y]);
+                }
+                continue;
+            }
+            for (uint32_t e = entries_[r].head; e != NONE; e = links_[e].next) {
+                uint32_t other = find(links_[e].to);
+                if (other <= r) continue;  // Each pair of classes once
+                for (int32_t x : members[r]) {
+                    for (int32_t y : members[other]) emit(x, y);
+                }
+            }
+        }
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+        return pairs;
+    }
+
+private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t UNSORTED_LIMIT = 32;  // Lookup entries appended since the last sort
+
+    struct Entry {
+        int32_t item;
+        uint32_t parent;     // Union-find link
+        uint32_t size;       // Class size, valid at roots
+        uint32_t head, tail; // Apart-link list, valid at roots
+        uint32_t num_links;
+    };
+
+    struct Link {
+        uint32_t to;    // Position in the other class
+        uint32_t next;
+    };
+
+    /// Position of @p item in entries_, or -1
+    int64_t position(int32_t item) const {
+        auto sorted_end = lookup_.begin() + static_cast<std::ptrdiff_t>(num_sorted_);
+        auto it = std::lower_bound(lookup_.begin(), sorted_end, std::make_pair(item, uint32_t(0)));
+        if (it != sorted_end && it->first == item) return it->second;
+        for (it = sorted_end; it != lookup_.end(); ++it) {
+            if (it->first == item) return it->second;
+        }
+        return -1;
+    }
+
+    uint32_t intern(int32_t item) {
+        int64_t k = position(item);
+        if (k >= 0) return static_cast<uint32_t>(k);
+
+        auto pos = static_cast<uint32_t>(entries_.size());
+        entries_.push_back({item, pos, 1, NONE, NONE, 0});
+        lookup_.push_back({item, pos});
+        if (lookup_.size() - num_sorted_ > UNSORTED_LIMIT) {
+            auto middle = lookup_.begin() + static_cast<std::ptrdiff_t>(num_sorted_);
+            std::sort(middle, lookup_.end());
+            std::inplace_merge(lookup_.begin(), middle, lookup_.end());
+            num_sorted_ = lookup_.size();
+        }
+        return pos;
+    }
+
+    /// Root of @p k (depth O(log n) by union by size; no compression, so const)
+    uint32_t find(uint32_t k) const {
+        while (entries_[k].parent != k) k = entries_[k].parent;
+        return k;
+    }
+
+    void link(uint32_t root, uint32_t other) {
+        auto e = static_cast<uint32_t>(links_.size());
+        links_.push_back({other, NONE});
+        Entry& r = entries_[root];
+        (r.head == NONE ? r.head : links_[r.tail].next) = e;
+        r.tail = e;
+        r.num_links++;
+    }
+
+    /// Whether roots @p a and @p b are linked (walks the shorter list)
+    bool classes_apart(uint32_t a, uint32_t b) const {
+        if (entries_[a].num_links > entries_[b].num_links) std::swap(a, b);
+        for (uint32_t e = entries_[a].head; e != NONE; e = links_[e].next) {
+            if (find(links_[e].to) == b) return true;
+        }
+        return false;
+    }
+
+    std::vector<Entry> entries_;                         // One per item, by position
+    std::vector<std::pair<int32_t, uint32_t>> lookup_;  // (item, position): sorted prefix + recent tail
+    size_t num_sorted_ = 0;
+    std::vector<Link> links_;
+    bool feasible_ = true;
+};
+
+class BPTree;
+class BPNode;
+
+/**
+ * @brief Receives notifications when a node's search priority changes.
+ *
+ * Installed by BPTree on the nodes it owns so that bound-ordered
+ * indexes stay consistent when the lower bound is set directly on the
+ * node (e.g. from Python). The observer performs the store itself, so a
+ * concurrent tree can serialise it with the index update.
+ */
+class NodeObserver {
+public:
+    virtual ~NodeObserver() = default;
+
+    /**
+     * @brief Store @p lb as the node's lower bound and re-key the node.
+     */
+    virtual void update_lower_bound(BPNode* node, double lb) = 0;
 };
 
 /**
@@ -120,7 +727,8 @@ struct BranchingDecision {
  * BPNode is a lightweight, cache-efficient structure optimized for
  * tree traversal and node management. It stores:
  * - Bounds (lower/upper from LP relaxation)
- * - Branching decisions accumulated from root
+ * - Branching decisions accumulated from root (shared with the parent
+ *   through a DecisionPath, so each node only owns its local decisions)
  * - Solution information
  * - Tree structure (parent/children)
  */
@@ -160,8 +768,45 @@ public:
         , lp_value_(INF)
         , status_(NodeStatus::PENDING)
         , is_integer_(false)
+        , path_(DecisionPath().push(decision))
+        , num_local_(1)
+        , rf_items_(item_bits(decision))
+        , rf_feasible_(!contradicts(nullptr, decision))
+    {}
+
+    /**
+     * @brief Construct a child node that shares its parent's decision path.
+     * @param id Unique node identifier
+     * @param parent_id Parent node ID
+     * @param depth Depth in tree (parent depth + 1)
+     * @param inherited The parent's full decision path
+     * @param decision The branching decision leading to this node
+     * @param parent Parent node (path @p inherited); Ryan-Foster
+     *        feasibility is recomputed from the whole path when null
+     * @param contradicts_parent Whether @p decision contradicts the
+     *        Ryan-Foster decisions in @p inherited (see
+     *        BPNode::contradicted_decisions)
+     */
+    BPNode(NodeId id, NodeId parent_id, int32_t depth,
+           const DecisionPath& inherited, const BranchingDecision& decision,
+           const BPNode* parent = nullptr, bool contradicts_parent = false)
+        : id_(id)
+        , parent_id_(parent_id)
+        , depth_(depth)
+        , lower_bound_(-INF)
+        , upper_bound_(INF)
+        , lp_value_(INF)
+        , status_(NodeStatus::PENDING)
+        , is_integer_(false)
+        , path_(inherited.push(decision))
+        , num_local_(1)
     {
-        local_decisions_.push_back(decision);
+        if (parent) {
+            rf_items_ = parent->rf_items_ | item_bits(decision);
+            rf_feasible_ = parent->rf_feasible_ && !contradicts_parent && !contradicts(nullptr, decision);
+        } else {
+            rebuild_closure();
+        }
     }
 
     // Accessors
@@ -169,44 +814,100 @@ public:
     NodeId parent_id() const { return parent_id_; }
     int32_t depth() const { return depth_; }
 
-    double lower_bound() const { return lower_bound_; }
+    double lower_bound() const { return lower_bound_.load(std::memory_order_relaxed); }
     double upper_bound() const { return upper_bound_; }
     double lp_value() const { return lp_value_; }
     double gap() const {
-        if (upper_bound_ == INF || lower_bound_ == -INF) return INF;
-        if (upper_bound_ == 0.0) return (lower_bound_ == 0.0) ? 0.0 : INF;
-        return (upper_bound_ - lower_bound_) / std::abs(upper_bound_);
+        double lb = lower_bound();
+        if (upper_bound_ == INF || lb == -INF) return INF;
+        if (upper_bound_ == 0.0) return (lb == 0.0) ? 0.0 : INF;
+        return (upper_bound_ - lb) / std::abs(upper_bound_);
     }
 
-    NodeStatus status() const { return status_; }
+    NodeStatus status() const { return status_.load(std::memory_order_relaxed); }
     bool is_integer() const { return is_integer_; }
     bool is_processed() const {
-        return status_ != NodeStatus::PENDING && status_ != NodeStatus::PROCESSING;
+        NodeStatus s = status();
+        return s != NodeStatus::PENDING && s != NodeStatus::PROCESSING;
     }
     bool is_pruned() const {
-        return status_ == NodeStatus::PRUNED_BOUND ||
-               status_ == NodeStatus::PRUNED_INFEASIBLE ||
-               status_ == NodeStatus::FATHOMED;
+        NodeStatus s = status();
+        return s == NodeStatus::PRUNED_BOUND ||
+               s == NodeStatus::PRUNED_INFEASIBLE ||
+               s == NodeStatus::FATHOMED;
     }
     bool can_be_explored() const {
-        return status_ == NodeStatus::PENDING;
+        return status() == NodeStatus::PENDING;
     }
 
     // Branching decisions
-    const std::vector<BranchingDecision>& local_decisions() const { return local_decisions_; }
-    const std::vector<BranchingDecision>& inherited_decisions() const { return inherited_decisions_; }
+    /**
+     * @brief Full decision path (inherited + local), shared with ancestors.
+     *
+     * Iterating the path visits decisions from this node back to the root
+     * without materialising a vector.
+     */
+    const DecisionPath& decision_path() const { return path_; }
+
+    /**
+     * @brief Decision path of the parent (this node's inherited decisions).
+     */
+    DecisionPath inherited_path() const { return path_.drop_back(num_local_); }
+
+    std::vector<BranchingDecision> local_decisions() const {
+        std::vector<BranchingDecision> local(num_local_);
+        auto it = path_.begin();
+        for (size_t k = num_local_; k > 0; --k, ++it) {
+            local[k - 1] = *it;
+        }
+        return local;
+    }
+
+    std::vector<BranchingDecision> inherited_decisions() const {
+        return inherited_path().to_vector();
+    }
 
     /**
      * @brief Get all branching decisions (inherited + local).
+     *
+     * Compatibility shim that materialises decision_path() in
+     * root-to-node order; prefer iterating decision_path() directly.
      */
     std::vector<BranchingDecision> all_decisions() const {
-        std::vector<BranchingDecision> all = inherited_decisions_;
-        all.insert(all.end(), local_decisions_.begin(), local_decisions_.end());
-        return all;
+        return path_.to_vector();
     }
 
-    size_t num_decisions() const {
-        return inherited_decisions_.size() + local_decisions_.size();
+    size_t num_decisions() const { return path_.size(); }
+    size_t num_local_decisions() const { return num_local_; }
+
+    /**
+     * @brief Whether the Ryan-Foster decisions on the path are consistent.
+     *
+     * O(1): checked against the parent's closure when the node is
+     * created. BPTree closes children that fail it as PRUNED_INFEASIBLE.
+     */
+    bool ryan_foster_feasible() const { return rf_feasible_; }
+
+    /**
+     * @brief Closure of the Ryan-Foster decisions on the path to this node.
+     *
+     * Built from the path on first use and cached. Query the result for
+     * many pairs rather than calling this per pair.
+     */
+    std::shared_ptr<const RyanFosterClosure> ryan_foster_closure() const {
+        if (rf_items_ == 0) return empty_closure();
+        {
+            std::lock_guard<std::mutex> lock(closure_mutex(this));
+            if (rf_closure_) {
+                rf_closure_shared_ = true;
+                return rf_closure_;
+            }
+        }
+        auto closure = std::make_shared<RyanFosterClosure>(path_.to_vector());
+        std::lock_guard<std::mutex> lock(closure_mutex(this));
+        if (!rf_closure_) rf_closure_ = std::move(closure);
+        rf_closure_shared_ = true;
+        return rf_closure_;
     }
 
     // Children
@@ -215,68 +916,268 @@ public:
 
     // Modifiers
     void set_id(NodeId id) { id_ = id; }
-    void set_lower_bound(double lb) { lower_bound_ = lb; }
+    void set_lower_bound(double lb) {
+        if (observer_) {
+            observer_->update_lower_bound(this, lb);
+        } else {
+            store_lower_bound(lb);
+        }
+    }
     void set_upper_bound(double ub) { upper_bound_ = ub; }
     void set_lp_value(double val) { lp_value_ = val; }
-    void set_status(NodeStatus status) { status_ = status; }
+    void set_status(NodeStatus status) { status_.store(status, std::memory_order_relaxed); }
     void set_is_integer(bool is_int) { is_integer_ = is_int; }
 
     void add_local_decision(const BranchingDecision& decision) {
-        local_decisions_.push_back(decision);
+        if (rf_feasible_ && is_ryan_foster(decision)) {
+            rf_feasible_ = !contradicts(ryan_foster_closure().get(), decision);
+        }
+        path_ = path_.push(decision);
+        num_local_++;
+        rf_items_ |= item_bits(decision);
+        std::lock_guard<std::mutex> lock(closure_mutex(this));
+        rf_closure_.reset();
+        rf_closure_shared_ = false;
+    }
+
+    /**
+     * @brief Replace the inherited prefix, keeping local decisions.
+     */
+    void set_inherited_path(const DecisionPath& inherited) {
+        DecisionPath path = inherited;
+        for (const auto& d : local_decisions()) {
+            path = path.push(d);
+        }
+        path_ = std::move(path);
+        rebuild_closure();
     }
 
     void set_inherited_decisions(std::vector<BranchingDecision>&& decisions) {
-        inherited_decisions_ = std::move(decisions);
+        set_inherited_path(DecisionPath::from_vector(decisions));
     }
 
     void add_child(NodeId child_id) {
         children_.push_back(child_id);
     }
 
+    /**
+     * @brief Append @p count children with consecutive IDs from @p first_id.
+     */
+    void add_children(NodeId first_id, size_t count) {
+        children_.reserve(children_.size() + count);
+        for (size_t k = 0; k < count; ++k) {
+            children_.push_back(first_id + static_cast<NodeId>(k));
+        }
+    }
+
     /**
      * @brief Mark node as pruned by bound.
      * @param global_upper Current global upper bound
      * @return true if pruned, false otherwise
      */
     bool try_prune_by_bound(double global_upper) {
-        if (lower_bound_ >= global_upper - 1e-6) {
-            status_ = NodeStatus::PRUNED_BOUND;
+        if (lower_bound() >= global_upper - 1e-6) {
+            set_status(NodeStatus::PRUNED_BOUND);
             return true;
         }
         return false;
     }
 
-    // Solution storage (optional - only for integer nodes)
-    void set_solution(std::vector<double>&& sol) { solution_ = std::move(sol); }
-    const std::vector<double>& solution() const { return solution_; }
-    bool has_solution() const { return !solution_.empty(); }
+    // Solution storage (optional - only for integer nodes). Buffers are
+    // immutable and shared, so a reader can hold on to one after the node
+    // replaces it or is recycled.
+    void set_solution(std::vector<double>&& sol) { solution_ = share(std::move(sol)); }
+    const std::vector<double>& solution() const { return solution_ ? *solution_ : no_values<double>(); }
+    std::shared_ptr<const std::vector<double>> shared_solution() const { return solution_; }
+    bool has_solution() const { return solution_ != nullptr; }
 
     // Column indices in the solution (for sparse representation)
-    void set_solution_columns(std::vector<int32_t>&& cols) { solution_columns_ = std::move(cols); }
-    const std::vector<int32_t>& solution_columns() const { return solution_columns_; }
+    void set_solution_columns(std::vector<int32_t>&& cols) { solution_columns_ = share(std::move(cols)); }
+    const std::vector<int32_t>& solution_columns() const {
+        return solution_columns_ ? *solution_columns_ : no_values<int32_t>();
+    }
+    std::shared_ptr<const std::vector<int32_t>> shared_solution_columns() const { return solution_columns_; }
+
+    /**
+     * @brief Number of children whose subtrees are not yet closed.
+     */
+    uint32_t num_open_children() const { return open_children_; }
 
 private:
+    friend class BPTree;
+
+    void store_lower_bound(double lb) { lower_bound_.store(lb, std::memory_order_relaxed); }
+
+    template<typename T>
+    static std::shared_ptr<const std::vector<T>> share(std::vector<T>&& values) {
+        if (values.empty()) return nullptr;
+        return std::make_shared<const std::vector<T>>(std::move(values));
+    }
+
+    template<typename T>
+    static const std::vector<T>& no_values() {
+        static const std::vector<T> empty;
+        return empty;
+    }
+
+    static const std::shared_ptr<const RyanFosterClosure>& empty_closure() {
+        static const auto empty = std::make_shared<const RyanFosterClosure>();
+        return empty;
+    }
+
+    static bool is_ryan_foster(const BranchingDecision& decision) {
+        return decision.type() == BranchType::RYAN_FOSTER;
+    }
+
+    static uint64_t item_bit(int32_t item) {
+        return uint64_t(1) << ((static_cast<uint32_t>(item) * 0x9E3779B9u) >> 26);
+    }
+
+    /// Hashed items of a Ryan-Foster decision (one bit each, 0 for others)
+    static uint64_t item_bits(const BranchingDecision& decision) {
+        if (!is_ryan_foster(decision) || decision.item_i() < 0 || decision.item_j() < 0) return 0;
+        return item_bit(decision.item_i()) | item_bit(decision.item_j());
+    }
+
+    /**
+     * @brief Whether checking @p decision below @p parent needs the
+     * parent's closure.
+     *
+     * Only a Ryan-Foster decision on two items that both already occur on
+     * a consistent path can contradict it; rf_items_ rules out most fresh
+     * items without building the closure.
+     */
+    static bool needs_closure(const BPNode& parent, const BranchingDecision& decision) {
+        if (!parent.rf_feasible_ || !is_ryan_foster(decision)) return false;
+        int32_t i = decision.item_i(), j = decision.item_j();
+        if (i < 0 || j < 0 || i == j) return false;
+        uint64_t bits = item_bit(i) | item_bit(j);
+        return (parent.rf_items_ & bits) == bits;
+    }
+
+    /**
+     * @brief Whether @p decision contradicts a consistent path with closure
+     * @p closure (nullptr: no Ryan-Foster decisions).
+     *
+     * same(i,j) contradicts when i and j are already apart, diff(i,j) when
+     * they are already together (including diff(i,i)).
+     */
+    static bool contradicts(const RyanFosterClosure* closure, const BranchingDecision& decision) {
+        if (!is_ryan_foster(decision)) return false;
+        int32_t i = decision.item_i(), j = decision.item_j();
+        if (i < 0 || j < 0) return false;
+        if (i == j) return !decision.same_column();
+        if (!closure) return false;
+        return decision.same_column() ? closure->apart(i, j) : closure->together(i, j);
+    }
+
+    /**
+     * @brief For each of @p decisions, whether it contradicts the
+     * Ryan-Foster decisions on this node's path (written to @p out).
+     *
+     * Uses the cached closure, or derives it from @p parent's cached
+     * closure plus this node's local decisions and caches it. The
+     * parent's closure is taken over rather than copied unless
+     * ryan_foster_closure() handed it out, so a dive extends one closure
+     * in place, one decision per level. A node whose closure was taken
+     * rebuilds it from its path if it needs it again.
+     * @param parent This node's parent, or nullptr if unknown
+     */
+    void contradicted_decisions(BPNode* parent, const BranchingDecision* decisions, size_t count, uint8_t* out) {
+        auto check = [&](const RyanFosterClosure* closure) {
+            for (size_t k = 0; k < count; ++k) out[k] = contradicts(closure, decisions[k]);
+        };
+        if (rf_items_ == 0) return check(nullptr);
+        {
+            std::lock_guard<std::mutex> lock(closure_mutex(this));
+            if (rf_closure_) return check(rf_closure_.get());
+        }
+
+        // Only one of the closure locks is held at a time: nodes may share one
+        std::shared_ptr<RyanFosterClosure> closure;
+        bool shared = false;
+        if (parent && parent->rf_items_ != 0 && path_.drop_back(num_local_).same_as(parent->path_)) {
+            std::lock_guard<std::mutex> lock(closure_mutex(parent));
+            shared = parent->rf_closure_shared_;
+            closure = shared ? parent->rf_closure_ : std::move(parent->rf_closure_);
+        }
+        if (closure) {
+            // A closure handed out by ryan_foster_closure() is never modified
+            if (shared) closure = std::make_shared<RyanFosterClosure>(*closure);
+            // The closure of a set of decisions does not depend on their order
+            uint32_t n = 0;
+            for (auto it = path_.begin(); n < num_local_; ++it, ++n) closure->add(*it);
+        } else {
+            closure = std::make_shared<RyanFosterClosure>(path_.to_vector());
+        }
+
+        std::lock_guard<std::mutex> lock(closure_mutex(this));
+        if (!rf_closure_) {
+            rf_closure_ = std::move(closure);
+            rf_closure_shared_ = false;
+        }
+        check(rf_closure_.get());
+    }
+
+    void rebuild_closure() {
+        rf_items_ = 0;
+        for (const auto& d : path_) rf_items_ |= item_bits(d);
+        std::shared_ptr<RyanFosterClosure> closure;
+        if (rf_items_ != 0) closure = std::make_shared<RyanFosterClosure>(path_.to_vector());
+        rf_feasible_ = !closure || closure->feasible();
+        std::lock_guard<std::mutex> lock(closure_mutex(this));
+        rf_closure_ = std::move(closure);
+        rf_closure_shared_ = false;
+    }
+
+    /**
+     * @brief Lock guarding @p node's cached closure; nodes share a fixed
+     * set of locks rather than each carrying one.
+     */
+    static std::mutex& closure_mutex(const BPNode* node) {
+        static constexpr size_t NUM_CLOSURE_LOCKS = 64;
+        static std::mutex locks[NUM_CLOSURE_LOCKS];
+        return locks[(reinterpret_cast<uintptr_t>(node) / sizeof(BPNode)) % NUM_CLOSURE_LOCKS];
+    }
+
     NodeId id_;
     NodeId parent_id_;
     int32_t depth_;
 
-    double lower_bound_;
+    // Atomic (relaxed) so that selectors and the tree may read the bound
+    // and status of nodes being processed by other threads.
+    std::atomic<double> lower_bound_;
     double upper_bound_;
     double lp_value_;
 
-    NodeStatus status_;
+    std::atomic<NodeStatus> status_;
     bool is_integer_;
 
-    // Branching decisions leading to this node
-    std::vector<BranchingDecision> inherited_decisions_;  // From ancestors
-    std::vector<BranchingDecision> local_decisions_;      // At this node
+    // Tree bookkeeping (maintained by BPTree)
+    NodeObserver* observer_ = nullptr;
+    uint16_t pool_shard_ = 0;      // BPTree pool shard the node was allocated from
+    bool pinned_ = false;          // On the path to the incumbent: never recycled
+    bool release_queued_ = false;  // Waiting in BPTree's reclaim queue
+    uint32_t open_children_ = 0;   // Children with an open subtree
+
+    // Branching decisions leading to this node: the last num_local_ links
+    // of path_ are local, the rest is shared with the ancestors.
+    DecisionPath path_;
+    uint32_t num_local_ = 0;
+
+    // Ryan-Foster state of the whole path. The closure is a cache, built
+    // on demand and guarded by closure_mutex(this).
+    uint64_t rf_items_ = 0;  // Hashed items of the Ryan-Foster decisions on path_
+    bool rf_feasible_ = true;
+    mutable std::shared_ptr<RyanFosterClosure> rf_closure_;
+    mutable bool rf_closure_shared_ = false;  // Handed out: copy, never modify
 
     // Tree structure
     std::vector<NodeId> children_;
 
     // Solution (sparse)
-    std::vector<double> solution_;
-    std::vector<int32_t> solution_columns_;
+    std::shared_ptr<const std::vector<double>> solution_;          // nullptr if empty
+    std::shared_ptr<const std::vector<int32_t>> solution_columns_;  // nullptr if empty
 };
 
 /**
@@ -0,0 +1,241 @@
+/**
+ * @file node_index.hpp
+ * @brief Dense ID-to-node index for the B&P tree.
+ *
+ * Node IDs are allocated sequentially, so the index is a chunked array
+ * addressed directly by ID instead of a hash map.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace openbp {
+
+/**
+ * @brief Chunked array mapping dense integer IDs to node pointers.
+ *
+ * Lookup is three array reads (page, chunk, slot) with no hashing.
+ * Chunks are allocated on demand and never move, so growing the index
+ * does not copy existing entries. Erased entries become tombstones
+ * (nullptr) and are skipped by iteration, which always proceeds in
+ * ascending ID order.
+ *
+ * The index is lock-free: pages and chunks are published with a
+ * compare-and-swap, and slots are atomic, so threads may insert, find
+ * and erase distinct IDs concurrently. clear() is not thread-safe.
+ *
+ * @tparam T The node type being indexed
+ */
+template<typename T>
+class NodeIndex {
+public:
+    using Id = int64_t;
+
+    static constexpr size_t CHUNK_BITS = 12;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+    static constexpr size_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+    static constexpr size_t PAGE_BITS = 10;  // Chunks per page
+    static constexpr size_t PAGE_SIZE = size_t(1) << PAGE_BITS;
+    static constexpr size_t PAGE_MASK = PAGE_SIZE - 1;
+
+    static constexpr size_t NUM_PAGES = 1024;
+    static constexpr size_t MAX_IDS = NUM_PAGES * PAGE_SIZE * CHUNK_SIZE;  // 2^32
+
+    NodeIndex() {
+        for (auto& page : pages_) page.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~NodeIndex() { release(); }
+
+    // Non-copyable, non-movable (concurrent readers hold no lock)
+    NodeIndex(const NodeIndex&) = delete;
+    NodeIndex& operator=(const NodeIndex&) = delete;
+
+    /**
+     * @brief Store @p node under @p id (overwrites an existing entry).
+     * @throws std::out_of_range if @p id is negative
+     * @throws std::length_error if @p id is not below MAX_IDS
+     */
+    void insert(Id id, T* node) {
+        check_range(id, 1);
+        auto uid = static_cast<size_t>(id);
+        std::atomic<T*>& slot = chunk_for(uid)[uid & CHUNK_MASK];
+        T* old = slot.exchange(node, std::memory_order_acq_rel);
+        if (!old && node) live_.fetch_add(1, std::memory_order_relaxed);
+        if (old && !node) live_.fetch_sub(1, std::memory_order_relaxed);
+
+        size_t limit = id_limit_.load(std::memory_order_relaxed);
+        while (uid >= limit &&
+               !id_limit_.compare_exchange_weak(limit, uid + 1, std::memory_order_release,
+                                                std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * @brief Store @p count nodes under the consecutive IDs from @p first_id.
+     *
+     * Resolves each chunk once and publishes the new ID limit once, so a
+     * batch of siblings costs one insertion rather than @p count.
+     * @throws std::out_of_range if @p first_id is negative
+     * @throws std::length_error if the range extends past MAX_IDS
+     */
+    void insert_range(Id first_id, T* const* nodes, size_t count) {
+        if (count == 0) return;
+        check_range(first_id, count);
+        auto uid = static_cast<size_t>(first_id);
+        const size_t end = uid + count;
+        int64_t added = 0;
+        while (uid < end) {
+            std::atomic<T*>* slots = chunk_for(uid);
+            size_t chunk_end = (uid | CHUNK_MASK) + 1;
+            if (chunk_end > end) chunk_end = end;
+            for (; uid < chunk_end; ++uid, ++nodes) {
+                T* old = slots[uid & CHUNK_MASK].exchange(*nodes, std::memory_order_acq_rel);
+                added += (*nodes != nullptr) - (old != nullptr);
+            }
+        }
+        if (added > 0) live_.fetch_add(static_cast<size_t>(added), std::memory_order_relaxed);
+        if (added < 0) live_.fetch_sub(static_cast<size_t>(-added), std::memory_order_relaxed);
+
+        size_t limit = id_limit_.load(std::memory_order_relaxed);
+        while (end > limit &&
+               !id_limit_.compare_exchange_weak(limit, end, std::memory_order_release,
+                                                std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * @brief Look up a node by ID.
+     * @return The node, or nullptr if the ID is unknown or was erased
+     */
+    T* find(Id id) const {
+        if (id < 0 || static_cast<size_t>(id) >= MAX_IDS) return nullptr;
+        auto uid = static_cast<size_t>(id);
+        Page* page = pages_[uid >> (CHUNK_BITS + PAGE_BITS)].load(std::memory_order_acquire);
+        if (!page) return nullptr;
+        Chunk* chunk = page->chunks[(uid >> CHUNK_BITS) & PAGE_MASK].load(std::memory_order_acquire);
+        if (!chunk) return nullptr;
+        return chunk->slots[uid & CHUNK_MASK].load(std::memory_order_acquire);
+    }
+
+    bool contains(Id id) const { return find(id) != nullptr; }
+
+    /**
+     * @brief Replace the entry with a tombstone.
+     */
+    void erase(Id id) {
+        if (find(id)) insert(id, nullptr);
+    }
+
+    /**
+     * @brief Number of live (non-tombstone) entries.
+     */
+    size_t size() const { return live_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief One past the largest ID ever inserted.
+     */
+    size_t id_limit() const { return id_limit_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Approximate memory used by the index itself.
+     */
+    size_t memory_usage() const {
+        return sizeof(pages_) +
+               num_pages_.load(std::memory_order_relaxed) * sizeof(Page) +
+               num_chunks_.load(std::memory_order_relaxed) * sizeof(Chunk);
+    }
+
+    /**
+     * @brief Visit live entries in ascending ID order.
+     */
+    template<typename Func>
+    void for_each(Func&& callback) const {
+        const size_t limit = id_limit();
+        for (size_t base = 0; base < limit; base += CHUNK_SIZE) {
+            Page* page = pages_[base >> (CHUNK_BITS + PAGE_BITS)].load(std::memory_order_acquire);
+            if (!page) continue;
+            Chunk* chunk = page->chunks[(base >> CHUNK_BITS) & PAGE_MASK].load(std::memory_order_acquire);
+            if (!chunk) continue;
+            size_t n = limit - base < CHUNK_SIZE ? limit - base : CHUNK_SIZE;
+            for (size_t k = 0; k < n; ++k) {
+                T* node = chunk->slots[k].load(std::memory_order_acquire);
+                if (node) callback(node);
+            }
+        }
+    }
+
+    void clear() {
+        release();
+        live_.store(0, std::memory_order_relaxed);
+        id_limit_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct Chunk {
+        std::atomic<T*> slots[CHUNK_SIZE];
+        Chunk() { for (auto& s : slots) s.store(nullptr, std::memory_order_relaxed); }
+    };
+
+    struct Page {
+        std::atomic<Chunk*> chunks[PAGE_SIZE];
+        Page() { for (auto& c : chunks) c.store(nullptr, std::memory_order_relaxed); }
+    };
+
+    /**
+     * @brief Install @p fresh into @p cell unless another thread was first.
+     * @return The published pointer (ours or the winner's)
+     */
+    template<typename U>
+    static U* publish(std::atomic<U*>& cell, std::atomic<size_t>& counter) {
+        U* current = cell.load(std::memory_order_acquire);
+        if (current) return current;
+        U* fresh = new U();
+        if (cell.compare_exchange_strong(current, fresh, std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+            counter.fetch_add(1, std::memory_order_relaxed);
+            return fresh;
+        }
+        delete fresh;  // Lost the race
+        return current;
+    }
+
+    static void check_range(Id first_id, size_t count) {
+        if (first_id < 0) {
+            throw std::out_of_range("node id " + std::to_string(first_id) + " is negative");
+        }
+        if (static_cast<size_t>(first_id) >= MAX_IDS || count > MAX_IDS - static_cast<size_t>(first_id)) {
+            throw std::length_error("node index holds at most 2^32 ids");
+        }
+    }
+
+    // Callers must check_range() first: pages_ is indexed unchecked
+    std::atomic<T*>* chunk_for(size_t uid) {
+        Page* page = publish(pages_[uid >> (CHUNK_BITS + PAGE_BITS)], num_pages_);
+        Chunk* chunk = publish(page->chunks[(uid >> CHUNK_BITS) & PAGE_MASK], num_chunks_);
+        return chunk->slots;
+    }
+
+    void release() {
+        for (auto& cell : pages_) {
+            Page* page = cell.exchange(nullptr, std::memory_order_relaxed);
+            if (!page) continue;
+            for (auto& chunk : page->chunks) delete chunk.load(std::memory_order_relaxed);
+            delete page;
+        }
+        num_pages_.store(0, std::memory_order_relaxed);
+        num_chunks_.store(0, std::memory_order_relaxed);
+    }
+
+    std::atomic<Page*> pages_[NUM_PAGES];
+    std::atomic<size_t> num_pages_{0};
+    std::atomic<size_t> num_chunks_{0};
+    std::atomic<size_t> live_{0};
+    std::atomic<size_t> id_limit_{0};
+};
+
+}  // namespace openbp
@@ -10,17 +10,23 @@
 
 #include <vector>
 #include <memory>
+#include <new>
+#include <utility>
+#include <cstring>
 #include <cstdint>
+#include <cstddef>
 
 namespace openbp {
 
 /**
- * @brief Simple object pool for node allocation.
+ * @brief Object pool with chunked storage and an intrusive free list.
  *
- * Allocates nodes in chunks to reduce allocation overhead
- * and improve cache locality. Nodes are never individually
- * freed during tree construction - the entire pool is
- * released when the tree is destroyed.
+ * Allocates nodes in chunks to reduce allocation overhead and improve
+ * cache locality. Objects are constructed in place on allocate() and
+ * destroyed on deallocate(); the freed slot stores the free-list link
+ * in its own storage, so recycling needs no extra memory and the next
+ * allocate() reuses the most recently freed slot. Chunks themselves are
+ * only returned to the system when the pool is cleared or destroyed.
  *
  * @tparam T The node type to pool
  */
@@ -29,40 +35,139 @@ class NodePool {
 public:
     static constexpr size_t DEFAULT_CHUNK_SIZE = 1024;
 
+    /**
+     * @brief Create an empty pool; the first chunk is allocated on first use.
+     */
     explicit NodePool(size_t chunk_size = DEFAULT_CHUNK_SIZE)
         : chunk_size_(chunk_size)
-        , next_in_chunk_(0)
+        , next_in_chunk_(chunk_size)
+        , num_live_(0)
         , total_allocated_(0)
-    {
-        allocate_chunk();
-    }
+        , free_list_(nullptr)
+    {}
+
+    ~NodePool() { destroy_all(); }
 
     // Non-copyable
     NodePool(const NodePool&) = delete;
     NodePool& operator=(const NodePool&) = delete;
 
     // Movable
-    NodePool(NodePool&&) = default;
-    NodePool& operator=(NodePool&&) = default;
+    NodePool(NodePool&& other) noexcept
+        : chunk_size_(other.chunk_size_)
+        , next_in_chunk_(other.next_in_chunk_)
+        , num_live_(other.num_live_)
+        , total_allocated_(other.total_allocated_)
+        , free_list_(std::exchange(other.free_list_, nullptr))
+        , chunks_(std::move(other.chunks_))
+    {
+        other.chunks_.clear();
+        other.next_in_chunk_ = other.chunk_size_;
+        other.num_live_ = 0;
+    }
+
+    NodePool& operator=(NodePool&& other) noexcept {
+        if (this != &other) {
+            destroy_all();
+            chunk_size_ = other.chunk_size_;
+            next_in_chunk_ = other.next_in_chunk_;
+            num_live_ = std::exchange(other.num_live_, 0);
+            total_allocated_ = other.total_allocated_;
+            free_list_ = std::exchange(other.free_list_, nullptr);
+            chunks_ = std::move(other.chunks_);
+            other.chunks_.clear();
+            other.next_in_chunk_ = other.chunk_size_;
+        }
+        return *this;
+    }
 
     /**
-     * @brief Allocate a new node.
+     * @brief Allocate and construct a new node.
+     *
+     * Reuses a recycled slot if one is available.
+     * @param args Constructor arguments for T
      * @return Pointer to the allocated node
      */
-    T* allocate() {
-        if (next_in_chunk_ >= chunk_size_) {
-            allocate_chunk();
+    template<typename... Args>
+    T* allocate(Args&&... args) {
+        Slot* slot;
+        if (free_list_) {
+            slot = free_list_;
+            free_list_ = next_free(slot);
+        } else {
+            if (next_in_chunk_ >= chunk_size_) {
+                allocate_chunk();
+            }
+            slot = &chunks_.back()[next_in_chunk_++];
         }
 
-        T* node = &chunks_.back()[next_in_chunk_++];
+        T* node = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+        slot->live = true;
+        num_live_++;
         total_allocated_++;
         return node;
     }
 
     /**
-     * @brief Get the total number of allocated nodes.
+     * @brief Allocate @p count nodes at once (e.g. all children of a branching).
+     *
+     * Recycled slots are reused first, so memory stays bounded when nodes
+     * are released. The rest are carved consecutively from one chunk: if
+     * the current chunk is too short, its tail goes onto the free list and
+     * a fresh chunk is started (unless @p count exceeds the chunk size).
+     *
+     * @param out Receives the @p count nodes
+     * @param construct Called as construct(storage, k) to placement-new
+     *        the k-th node into @p storage; returns the node
+     */
+    template<typename Construct>
+    void allocate_batch(size_t count, T** out, Construct&& construct) {
+        size_t k = 0;
+        for (; k < count && free_list_; ++k) {
+            Slot* slot = free_list_;
+            free_list_ = next_free(slot);
+            out[k] = construct(static_cast<void*>(slot->storage), k);
+            slot->live = true;
+            num_live_++;
+        }
+        if (k < count && count - k <= chunk_size_ && chunk_size_ - next_in_chunk_ < count - k) {
+            retire_chunk_tail();
+        }
+        for (; k < count; ++k) {
+            if (next_in_chunk_ >= chunk_size_) {
+                allocate_chunk();
+            }
+            Slot* slot = &chunks_.back()[next_in_chunk_++];
+            out[k] = construct(static_cast<void*>(slot->storage), k);
+            slot->live = true;
+            num_live_++;
+        }
+        total_allocated_ += count;
+    }
+
+    /**
+     * @brief Destroy a node and push its slot onto the free list.
+     * @param node Pointer previously returned by allocate()
      */
-    size_t size() const { return total_allocated_; }
+    void deallocate(T* node) {
+        if (!node) return;
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        node->~T();
+        slot->live = false;
+        set_next_free(slot, free_list_);
+        free_list_ = slot;
+        num_live_--;
+    }
+
+    /**
+     * @brief Get the number of live (allocated, not recycled) nodes.
+     */
+    size_t size() const { return num_live_; }
+
+    /**
+     * @brief Get the total number of allocations ever served (including reuse).
+     */
+    size_t total_allocated() const { return total_allocated_; }
 
     /**
      * @brief Get the number of chunks allocated.
@@ -73,31 +178,77 @@ public:
      * @brief Get the total memory used (approximate).
      */
     size_t memory_usage() const {
-        return chunks_.size() * chunk_size_ * sizeof(T);
+        return chunks_.size() * chunk_size_ * sizeof(Slot);
     }
 
     /**
-     * @brief Clear all allocated nodes.
-     *
-     * This doesn't free memory but resets the pool for reuse.
+     * @brief Destroy all nodes and release all chunks.
      */
     void clear() {
+        destroy_all();
         chunks_.clear();
-        next_in_chunk_ = 0;
+        next_in_chunk_ = chunk_size_;
+        num_live_ = 0;
         total_allocated_ = 0;
-        allocate_chunk();
+        free_list_ = nullptr;
     }
 
 private:
+    // The node must start at the slot address so deallocate() can map a
+    // T* back to its slot; while free, the storage holds the next link.
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        bool live;
+    };
+
+    static_assert(sizeof(T) >= sizeof(Slot*), "Pooled type too small for free-list link");
+
+    static Slot* next_free(Slot* slot) {
+        Slot* next;
+        std::memcpy(&next, slot->storage, sizeof(Slot*));
+        return next;
+    }
+
+    static void set_next_free(Slot* slot, Slot* next) {
+        std::memcpy(slot->storage, &next, sizeof(Slot*));
+    }
+
     void allocate_chunk() {
-        chunks_.emplace_back(std::make_unique<T[]>(chunk_size_));
+        // Value-initialized, so every slot starts with live == false
+        chunks_.emplace_back(std::make_unique<Slot[]>(chunk_size_));
         next_in_chunk_ = 0;
     }
 
+    /**
+     * @brief Move the unused tail of the current chunk onto the free list.
+     */
+    void retire_chunk_tail() {
+        while (!chunks_.empty() && next_in_chunk_ < chunk_size_) {
+            Slot* slot = &chunks_.back()[next_in_chunk_++];
+            set_next_free(slot, free_list_);
+            free_list_ = slot;
+        }
+        next_in_chunk_ = chunk_size_;
+    }
+
+    void destroy_all() {
+        for (auto& chunk : chunks_) {
+            for (size_t k = 0; k < chunk_size_; ++k) {
+                if (chunk[k].live) {
+                    std::launder(reinterpret_cast<T*>(chunk[k].storage))->~T();
+                    chunk[k].live = false;
+                }
+            }
+        }
+        num_live_ = 0;
+    }
+
     size_t chunk_size_;
     size_t next_in_chunk_;
+    size_t num_live_;
     size_t total_allocated_;
-    std::vector<std::unique_ptr<T[]>> chunks_;
+    Slot* free_list_;
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
 };
 
 }  // namespace openbp
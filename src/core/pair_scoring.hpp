@@ -0,0 +1,294 @@
+/**
+ * @file pair_scoring.hpp
+ * @brief Ryan-Foster branching pair scoring over CSR column coverage.
+ *
+ * For every pair of items covered together by some fractional column,
+ * the "together" mass is the sum of the LP values of those columns. The
+ * pairs are accumulated in a flat buffer instead of one dictionary
+ * update per pair in Python: a dense upper-triangular array when the
+ * item universe is small relative to the pairs seen (crew pairing,
+ * vehicle routing), else an open-addressing table keyed by the packed
+ * pair.
+ */
+
+#pragma once
+
+#include "node.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace openbp {
+
+/**
+ * @brief Top branching pairs, as parallel arrays sorted by descending score.
+ *
+ * together is the LP mass of the columns covering both items, apart the
+ * mass of the columns covering exactly one of them, and score is
+ * 1 - 2 |together - 0.5| (1 for a perfectly balanced split).
+ */
+struct PairScores {
+    std::vector<int32_t> item_i;
+    std::vector<int32_t> item_j;
+    std::vector<double> together;
+    std::vector<double> apart;
+    std::vector<double> score;
+
+    size_t size() const { return score.size(); }
+};
+
+/**
+ * @brief Scores Ryan-Foster branching pairs from an LP solution.
+ *
+ * Columns are given in CSR form: the items of column c are
+ * items[offsets[c]..offsets[c+1]) in any order (duplicates are ignored),
+ * and values[c] is its LP value. Columns with a value of at most
+ * min_column_value do not contribute.
+ *
+ * A pair is a candidate when its together mass is fractional, within
+ * [min_pair_value, 1 - min_pair_value], and it is not already decided
+ * by the node's RyanFosterClosure. Ties on the score are broken by the
+ * smaller (item_i, item_j), so results are deterministic.
+ *
+ * The scorer keeps its table between calls, so reusing one instance
+ * across nodes avoids reallocating. Not thread-safe.
+ */
+class RyanFosterPairScorer {
+public:
+    explicit RyanFosterPairScorer(double min_pair_value = 0.01, double min_column_value = 1e-9)
+        : min_pair_value_(min_pair_value), min_column_value_(min_column_value) {}
+
+    /**
+     * @brief Score all pairs and return the best @p k candidates.
+     * @param offsets CSR offsets (num_columns + 1 entries)
+     * @param items Covered item indices (non-negative)
+     * @param values LP value of each column
+     * @param k Maximum number of pairs returned
+     * @param closure Decisions of the node; implied pairs are skipped
+     */
+    PairScores score(const int64_t* offsets, size_t num_columns, const int32_t* items,
+                     const double* values, size_t k, const RyanFosterClosure* closure = nullptr) {
+        accumulate(offsets, num_columns, items, values);
+        return select(k, closure);
+    }
+
+    PairScores score(const std::vector<int64_t>& offsets, const std::vector<int32_t>& items,
+                     const std::vector<double>& values, size_t k,
+                     const RyanFosterClosure* closure = nullptr) {
+        if (offsets.size() != values.size() + 1 || offsets.front() != 0 ||
+            offsets.back() != static_cast<int64_t>(items.size())) {
+            throw std::invalid_argument("offsets must have len(values) + 1 entries, start at 0 "
+                                        "and end at the number of items");
+        }
+        for (size_t c = 0; c < values.size(); ++c) {
+            if (offsets[c] > offsets[c + 1]) throw std::invalid_argument("offsets must be non-decreasing");
+        }
+        return score(offsets.data(), values.size(), items.data(), values.data(), k, closure);
+    }
+
+    /// Distinct pairs seen by the last call (fractional or not)
+    size_t num_pairs() const { return num_pairs_; }
+
+    /// Whether the last call used the dense triangular buffer
+    bool used_dense() const { return dense_; }
+
+    double min_pair_value() const { return min_pair_value_; }
+    double min_column_value() const { return min_column_value_; }
+
+private:
+    struct Slot {
+        uint64_t key;
+        double mass;
+    };
+
+    static constexpr uint64_t EMPTY = UINT64_MAX;
+
+    /// Triangles up to this many pairs are always dense
+    static constexpr size_t MIN_DENSE_PAIRS = size_t(1) << 16;
+
+    static uint64_t pack(int32_t i, int32_t j) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(i)) << 32) | static_cast<uint32_t>(j);
+    }
+
+    size_t slot_of(uint64_t key) const {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift_);
+    }
+
+    void reset(size_t expected_pairs) {
+        for (size_t s : used_) slots_[s].key = EMPTY;
+        used_.clear();
+
+        size_t capacity = 16;
+        while (capacity < 2 * expected_pairs) capacity *= 2;
+        if (capacity > slots_.size()) resize(capacity);
+    }
+
+    void resize(size_t capacity) {
+        std::vector<Slot> old;
+        old.swap(slots_);
+        slots_.assign(capacity, Slot{EMPTY, 0.0});
+        shift_ = 64;
+        for (size_t c = capacity; c > 1; c >>= 1) --shift_;
+
+        std::vector<size_t> used;
+        used.swap(used_);
+        used_.reserve(used.size());
+        for (size_t s : used) insert(old[s].key, old[s].mass);
+    }
+
+    void insert(uint64_t key, double mass) {
+        const size_t mask = slots_.size() - 1;
+        size_t s = slot_of(key);
+        while (slots_[s].key != EMPTY && slots_[s].key != key) s = (s + 1) & mask;
+        if (slots_[s].key == EMPTY) {
+            if (2 * (used_.size() + 1) > slots_.size()) {  // Keep the load under 1/2
+                resize(2 * slots_.size());
+                insert(key, mass);
+                return;
+            }
+            slots_[s] = Slot{key, 0.0};
+            used_.push_back(s);
+        }
+        slots_[s].mass += mass;
+    }
+
+    void accumulate(const int64_t* offsets, size_t num_columns, const int32_t* items,
+                    const double* values) {
+        // Per-item mass (for "apart") and a table sized for the pairs present
+        int32_t max_item = -1;
+        size_t expected = 0;
+        for (size_t c = 0; c < num_columns; ++c) {
+            if (values[c] <= min_column_value_) continue;
+            auto n = static_cast<size_t>(offsets[c + 1] - offsets[c]);
+            expected += n * (n - (n > 0)) / 2;
+            for (int64_t p = offsets[c]; p < offsets[c + 1]; ++p) {
+                if (items[p] < 0) {
+                    throw std::out_of_range("item index " + std::to_string(items[p]) + " is negative");
+                }
+                max_item = std::max(max_item, items[p]);
+            }
+        }
+        const auto num_items = static_cast<size_t>(max_item + 1);
+        const size_t triangle = num_items * (num_items - (num_items > 0)) / 2;
+        item_mass_.assign(num_items, 0.0);
+
+        // Dense when zeroing and scanning the triangle costs less than
+        // probing a table sized for the pairs: no hashing, no key compares
+        dense_ = triangle <= std::max(4 * expected, MIN_DENSE_PAIRS);
+        if (dense_) {
+            pair_mass_.assign(triangle, 0.0);
+        } else {
+            reset(std::min(expected, triangle));
+        }
+        num_items_ = num_items;
+
+        for (size_t c = 0; c < num_columns; ++c) {
+            const double value = values[c];
+            if (value <= min_column_value_) continue;
+
+            column_.assign(items + offsets[c], items + offsets[c + 1]);
+            if (!std::is_sorted(column_.begin(), column_.end())) std::sort(column_.begin(), column_.end());
+            column_.erase(std::unique(column_.begin(), column_.end()), column_.end());
+
+            const size_t n = column_.size();
+            for (size_t a = 0; a < n; ++a) {
+                const auto i = static_cast<size_t>(column_[a]);
+                item_mass_[i] += value;
+                if (dense_) {
+                    double* row = pair_mass_.data() + row_start(i) - i - 1;  // row[j] is (i, j)
+                    for (size_t b = a + 1; b < n; ++b) row[column_[b]] += value;
+                } else {
+                    for (size_t b = a + 1; b < n; ++b) insert(pack(column_[a], column_[b]), value);
+                }
+            }
+        }
+    }
+
+    /// Index of pair (i, i + 1) in the dense triangle
+    size_t row_start(size_t i) const { return i * num_items_ - i * (i + 1) / 2; }
+
+    PairScores select(size_t k, const RyanFosterClosure* closure) {
+        struct Candidate {
+            double score;
+            uint64_t key;
+            double together;
+        };
+        // Bounded heap of the best k, worst on top
+        auto better = [](const Candidate& a, const Candidate& b) {
+            return a.score != b.score ? a.score > b.score : a.key < b.key;
+        };
+        std::vector<Candidate> best;
+        best.reserve(std::min<size_t>(k, 1024));
+        auto consider = [&](int32_t i, int32_t j, double mass) {
+            if (k == 0 || mass < min_pair_value_ || mass > 1.0 - min_pair_value_) return;
+            Candidate cand{1.0 - std::abs(mass - 0.5) * 2.0, pack(i, j), mass};
+            if (best.size() == k && !better(cand, best.front())) return;
+            if (closure && closure->implied(i, j)) return;
+            if (best.size() == k) {
+                std::pop_heap(best.begin(), best.end(), better);
+                best.back() = cand;
+            } else {
+                best.push_back(cand);
+            }
+            std::push_heap(best.begin(), best.end(), better);
+        };
+        if (dense_) {
+            num_pairs_ = 0;
+            const double* mass = pair_mass_.data();
+            for (size_t i = 0; i < num_items_; ++i) {
+                for (size_t j = i + 1; j < num_items_; ++j, ++mass) {
+                    if (*mass == 0.0) continue;
+                    ++num_pairs_;
+                    consider(static_cast<int32_t>(i), static_cast<int32_t>(j), *mass);
+                }
+            }
+        } else {
+            num_pairs_ = used_.size();
+            for (size_t s : used_) {
+                consider(static_cast<int32_t>(slots_[s].key >> 32),
+                         static_cast<int32_t>(slots_[s].key & 0xFFFFFFFFu), slots_[s].mass);
+            }
+        }
+        std::sort_heap(best.begin(), best.end(), better);
+        k = best.size();
+
+        PairScores result;
+        result.item_i.reserve(k);
+        result.item_j.reserve(k);
+        result.together.reserve(k);
+        result.apart.reserve(k);
+        result.score.reserve(k);
+        for (size_t r = 0; r < k; ++r) {
+            const Candidate& cand = best[r];
+            auto i = static_cast<int32_t>(cand.key >> 32);
+            auto j = static_cast<int32_t>(cand.key & 0xFFFFFFFFu);
+            result.item_i.push_back(i);
+            result.item_j.push_back(j);
+            result.together.push_back(cand.together);
+            result.apart.push_back(item_mass_[static_cast<size_t>(i)] + item_mass_[static_cast<size_t>(j)] -
+                                   2.0 * cand.together);
+            result.score.push_back(cand.score);
+        }
+        return result;
+    }
+
+    double min_pair_value_;
+    double min_column_value_;
+
+    bool dense_ = false;
+    size_t num_items_ = 0;
+    size_t num_pairs_ = 0;
+    std::vector<double> pair_mass_;  // Dense: upper triangle, row by row
+    std::vector<Slot> slots_;        // Sparse: linear probing, power-of-two size
+    std::vector<size_t> used_;       // Sparse: occupied slots, in insertion order
+    unsigned shift_ = 64;            // 64 - log2(slots_.size())
+    std::vector<double> item_mass_;
+    std::vector<int32_t> column_;    // Sorted, deduplicated items of one column
+};
+
+}  // namespace openbp
@@ -0,0 +1,876 @@
+/**
+ * @file parallel.hpp
+ * @brief Parallel branch-and-price driver.
+ *
+ * Runs several workers that pull nodes from a NodeSelector, evaluate them
+ * with a user-supplied callback (e.g. column generation) and feed the
+ * outcome back into the BPTree: bounds, children, incumbents and pruning.
+ * PortfolioSolver instead races several selection policies, each on its
+ * own tree, with a shared incumbent. Upper bounds travel between workers
+ * through an IncumbentRegister, without locks.
+ */
+
+#pragma once
+
+#include "node.hpp"
+#include "tree.hpp"
+#include "selection.hpp"
+#include "incumbent.hpp"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <stdexcept>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <memory>
+#include <string>
+
+namespace openbp {
+
+/**
+ * @brief Fixed set of threads running jobs submitted by one caller.
+ *
+ * run_on_all() runs a function once on every worker; run_tasks() hands
+ * out task indices dynamically. Both block until all work is done and
+ * rethrow the first exception raised by a worker.
+ */
+class WorkerPool {
+public:
+    explicit WorkerPool(int num_threads) {
+        num_threads = std::max(1, num_threads);
+        threads_.reserve(static_cast<size_t>(num_threads));
+        for (int w = 0; w < num_threads; ++w) {
+            threads_.emplace_back([this, w] { loop(w); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : threads_) t.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const { return static_cast<int>(threads_.size()); }
+
+    /**
+     * @brief Run fn(worker) once on each worker and wait for all of them.
+     */
+    void run_on_all(const std::function<void(int)>& fn) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        job_ = &fn;
+        error_ = nullptr;
+        pending_ = size();
+        generation_++;
+        wake_.notify_all();
+        done_.wait(lock, [this] { return pending_ == 0; });
+        job_ = nullptr;
+        if (error_) std::rethrow_exception(error_);
+    }
+
+    /**
+     * @brief Run fn(task, worker) for every task in [0, num_tasks).
+     */
+    void run_tasks(size_t num_tasks, const std::function<void(size_t, int)>& fn) {
+        if (num_tasks == 0) return;
+        std::atomic<size_t> next{0};
+        run_on_all([&](int worker) {
+            for (size_t task = next.fetch_add(1); task < num_tasks; task = next.fetch_add(1)) {
+                fn(task, worker);
+            }
+        });
+    }
+
+private:
+    void loop(int worker) {
+        uint64_t seen = 0;
+        while (true) {
+            const std::function<void(int)>* job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                job = job_;
+            }
+            try {
+                (*job)(worker);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) done_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(int)>* job_ = nullptr;
+    uint64_t generation_ = 0;
+    int pending_ = 0;
+    bool stop_ = false;
+    std::exception_ptr error_;
+};
+
+
+/**
+ * @brief Outcome of evaluating one node, returned by the node processor.
+ *
+ * The processor only computes; the driver applies the result to the
+ * tree. Use the factory functions for the common cases.
+ */
+struct NodeResult {
+    /// BRANCHED, INTEGER, PRUNED_INFEASIBLE or FATHOMED
+    NodeStatus status = NodeStatus::BRANCHED;
+    double lower_bound = -std::numeric_limits<double>::infinity();
+    double lp_value = std::numeric_limits<double>::infinity();
+    std::vector<BranchingDecision> branches;  // One child per decision
+    std::vector<double> solution;             // Integer solutions only
+
+    static NodeResult branch(double lower_bound, double lp_value,
+                             std::vector<BranchingDecision> branches) {
+        NodeResult r;
+        r.status = NodeStatus::BRANCHED;
+        r.lower_bound = lower_bound;
+        r.lp_value = lp_value;
+        r.branches = std::move(branches);
+        return r;
+    }
+
+    static NodeResult integer(double lp_value, std::vector<double> solution = {}) {
+        NodeResult r;
+        r.status = NodeStatus::INTEGER;
+        r.lower_bound = lp_value;
+        r.lp_value = lp_value;
+        r.solution = std::move(solution);
+        return r;
+    }
+
+    static NodeResult infeasible() {
+        NodeResult r;
+        r.status = NodeStatus::PRUNED_INFEASIBLE;
+        return r;
+    }
+
+    static NodeResult fathomed(double lower_bound) {
+        NodeResult r;
+        r.status = NodeStatus::FATHOMED;
+        r.lower_bound = lower_bound;
+        r.lp_value = lower_bound;
+        return r;
+    }
+};
+
+
+/**
+ * @brief Apply an evaluated node to its tree.
+ *
+ * Bounds only tighten (a node is never better than its parent). Integer
+ * results update the incumbent; other nodes are pruned against the
+ * incumbent, closed, or branched. Pruning the rest of the tree against a
+ * new incumbent is left to the caller (BPTree::prune_if_pending()), so
+ * several improvements can share one pass.
+ *
+ * @param[out] children Children created by branching
+ * @return true if the node became the new incumbent
+ */
+inline bool apply_node_result(BPTree& tree, BPNode* node, NodeResult& r,
+                              std::vector<BPNode*>& children) {
+    children.clear();
+    if (r.status == NodeStatus::PRUNED_INFEASIBLE) {
+        tree.mark_processed(node, NodeStatus::PRUNED_INFEASIBLE);
+        return false;
+    }
+
+    if (r.lower_bound > node->lower_bound()) node->set_lower_bound(r.lower_bound);
+    node->set_lp_value(r.lp_value);
+
+    if (r.status == NodeStatus::INTEGER) {
+        node->set_is_integer(true);
+        node->set_solution(std::move(r.solution));
+        tree.mark_processed(node, NodeStatus::INTEGER);
+        return tree.update_incumbent(node);
+    }
+
+    if (node->lower_bound() >= tree.global_upper_bound() - BPTree::PRUNE_TOLERANCE) {
+        tree.mark_processed(node, NodeStatus::PRUNED_BOUND);
+    } else if (r.status != NodeStatus::BRANCHED || r.branches.empty()) {
+        tree.mark_processed(node, NodeStatus::FATHOMED);
+    } else {
+        children = tree.create_children(node, r.branches);
+    }
+    return false;
+}
+
+
+/**
+ * @brief Take up to @p max_nodes explorable nodes from @p selector and claim them.
+ *
+ * Nodes pruned since they were queued are skipped. Meant for callers
+ * that run their own round loop (e.g. from Python), where one call
+ * replaces a select_next() and begin_processing() pair per node.
+ *
+ * @param[out] batch Receives the claimed nodes (appended)
+ * @return Number of nodes claimed
+ */
+inline size_t select_round(BPTree& tree, NodeSelector& selector, size_t max_nodes,
+                           std::vector<BPNode*>& batch) {
+    size_t claimed = 0;
+    while (claimed < max_nodes) {
+        BPNode* node = selector.select_next();
+        if (!node) break;
+        if (!tree.begin_processing(node)) continue;  // Pruned after queuing
+        batch.push_back(node);
+        claimed++;
+    }
+    return claimed;
+}
+
+/**
+ * @brief Apply a round of results to the tree, in the given order.
+ *
+ * Children are added to @p selector. If any result improved the
+ * incumbent, the selector is notified and the tree pruned once, after
+ * the whole round.
+ *
+ * @param results One result per node (solutions are moved out)
+ * @return Number of results that improved the incumbent
+ */
+inline size_t apply_round(BPTree& tree, NodeSelector& selector, const std::vector<BPNode*>& nodes,
+                          std::vector<NodeResult>& results) {
+    if (nodes.size() != results.size()) {
+        throw std::invalid_argument("apply_round: one result per node required");
+    }
+    size_t improved = 0;
+    std::vector<BPNode*> children;
+    for (size_t k = 0; k < nodes.size(); ++k) {
+        if (apply_node_result(tree, nodes[k], results[k], children)) improved++;
+        selector.add_nodes(children);
+    }
+    if (improved > 0) selector.on_bound_update(tree.global_upper_bound());
+    tree.prune_if_pending();
+    return improved;
+}
+
+
+/**
+ * @brief Configuration of the parallel driver.
+ */
+struct ParallelConfig {
+    static constexpr int DEFAULT_ROUND_SIZE = 32;
+
+    int num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    bool deterministic = false;  // Synchronised rounds, results merged in node-ID order
+    int round_size = DEFAULT_ROUND_SIZE;  // Deterministic mode: nodes per round
+    int64_t max_nodes = 0;       // 0 = unlimited
+    double time_limit = std::numeric_limits<double>::infinity();  // seconds
+    double gap_tolerance = 1e-6;
+};
+
+/**
+ * @brief Why the parallel driver stopped.
+ */
+enum class ParallelStatus : uint8_t {
+    COMPLETED,    // No open nodes left
+    GAP_LIMIT,    // Gap closed to gap_tolerance
+    NODE_LIMIT,
+    TIME_LIMIT,
+    INTERRUPTED   // stop() was called
+};
+
+/**
+ * @brief Summary of a parallel run.
+ */
+struct ParallelResult {
+    ParallelStatus status = ParallelStatus::COMPLETED;
+    int64_t nodes_processed = 0;
+    int64_t rounds = 0;  // Deterministic mode only
+    double elapsed = 0.0;  // seconds
+    std::vector<int64_t> nodes_per_worker;
+};
+
+
+/**
+ * @brief Parallel branch-and-price driver over a BPTree and a NodeSelector.
+ *
+ * Non-deterministic mode: every worker repeatedly takes the next node
+ * from the selector (under a selector lock, unless the selector is
+ * concurrent, see NodeSelector::is_concurrent()), claims it in the tree,
+ * evaluates it with the processor outside any lock, applies the result
+ * and hands the children back to the selector. Workers never wait for
+ * each other except on the selector lock, so the node order depends on
+ * timing.
+ *
+ * Deterministic mode: nodes are processed in synchronised rounds. Each
+ * round takes the next round_size nodes from the selector, evaluates them
+ * in parallel and applies the results on the calling thread in node-ID
+ * order. Selection and merging happen on one thread and the round size
+ * does not depend on num_threads, so the tree, incumbent and statistics
+ * are identical for any thread count, provided the processor is a pure
+ * function of the node (it must not depend on the worker index) and no
+ * time limit is hit. Throughput grows with min(round_size, num_threads);
+ * a larger round gives more parallelism at the cost of processing nodes
+ * that an earlier node in the same round would have pruned.
+ *
+ * While running, the driver detaches the selector from the tree's
+ * listeners (tree notifications would race with selection) and relies
+ * on the selector's lazy removal of pruned nodes instead.
+ *
+ * New incumbents are offered to an IncumbentRegister (the solver's own,
+ * or one shared with other solvers or heuristics via share_incumbent()).
+ * Improvements in the register, local or not, reach the tree and the
+ * selector through a subscription polled by the workers before each
+ * node: the tree's upper bound is tightened lock-free, the selector gets
+ * on_bound_update() once per improvement, and the tree is pruned in one
+ * pass per batch of improvements (once per round in deterministic mode).
+ * Bounds from a shared register arrive at timing-dependent points, so
+ * deterministic runs are only reproducible with the solver's own.
+ */
+class ParallelSolver {
+public:
+    /**
+     * @brief Node evaluation callback: (node, worker index) -> result.
+     *
+     * Called concurrently from several threads. The node is PROCESSING
+     * and owned by the caller until the result is returned; the callback
+     * must not modify the tree.
+     */
+    using NodeProcessor = std::function<NodeResult(BPNode*, int)>;
+
+    ParallelSolver(BPTree& tree, NodeSelector& selector, ParallelConfig config = ParallelConfig())
+        : tree_(tree)
+        , selector_(selector)
+        , config_(config)
+    {
+        config_.num_threads = std::max(1, config_.num_threads);
+        config_.round_size = std::max(1, config_.round_size);
+    }
+
+    const ParallelConfig& config() const { return config_; }
+
+    /**
+     * @brief Exchange upper bounds through @p incumbent instead of the
+     * solver's own register (it must outlive the solver's runs).
+     */
+    void share_incumbent(IncumbentRegister& incumbent) { incumbent_ = &incumbent; }
+
+    const IncumbentRegister& incumbent() const { return *incumbent_; }
+
+    /**
+     * @brief Explore the tree until it is complete or a limit is reached.
+     *
+     * If the selector is empty, the root is added when it is still open.
+     */
+    ParallelResult run(const NodeProcessor& process) {
+        start_ = Clock::now();
+        stop_requested_.store(false);
+        stop_status_ = ParallelStatus::COMPLETED;
+        result_ = ParallelResult();
+        result_.nodes_per_worker.assign(static_cast<size_t>(config_.num_threads), 0);
+        nodes_started_.store(0);
+
+        bool attached = tree_.has_listener(&selector_);
+        if (attached) tree_.remove_listener(&selector_);
+        struct Reattach {
+            BPTree& tree; NodeSelector& selector; bool attached;
+            ~Reattach() { if (attached) tree.add_listener(&selector); }
+        } reattach{tree_, selector_, attached};
+
+        incumbent_->offer(tree_.global_upper_bound());
+        BoundSubscription bounds(*incumbent_, [this](double ub) { import_bound(ub); });
+        import_bound(incumbent_->upper_bound());
+
+        if (selector_.empty() && tree_.root()->can_be_explored()) {
+            selector_.add_node(tree_.root());
+        }
+
+        WorkerPool pool(config_.num_threads);
+        if (config_.deterministic) {
+            run_rounds(pool, process, bounds);
+        } else {
+            in_flight_ = 0;
+            pool.run_on_all([&](int worker) { work(worker, process, bounds); });
+        }
+        tree_.prune_if_pending();
+
+        for (int64_t n : result_.nodes_per_worker) result_.nodes_processed += n;
+        result_.status = stop_status_;
+        result_.elapsed = elapsed();
+        return result_;
+    }
+
+    /**
+     * @brief Ask a running solve to stop (callable from any thread).
+     */
+    void stop() {
+        request_stop(ParallelStatus::INTERRUPTED);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed() const {
+        return std::chrono::duration<double>(Clock::now() - start_).count();
+    }
+
+    void request_stop(ParallelStatus status) {
+        std::lock_guard<std::mutex> lock(selector_mutex_);
+        if (!stop_requested_.load()) {
+            stop_status_ = status;
+            stop_requested_.store(true);
+        }
+        wake_.notify_all();
+    }
+
+    /**
+     * @brief Stop if the gap is closed or the time limit is reached.
+     */
+    bool check_limits() {
+        if (tree_.gap() <= config_.gap_tolerance) {
+            request_stop(ParallelStatus::GAP_LIMIT);
+        } else if (elapsed() >= config_.time_limit) {
+            request_stop(ParallelStatus::TIME_LIMIT);
+        }
+        return stop_requested_.load();
+    }
+
+    /**
+     * @brief Reserve one node from the node limit.
+     */
+    bool reserve_node() {
+        if (config_.max_nodes <= 0) return true;
+        return nodes_started_.fetch_add(1) < config_.max_nodes;
+    }
+
+    /**
+     * @brief Apply a result; a new incumbent is offered to the register.
+     */
+    void apply(BPNode* node, NodeResult& r, std::vector<BPNode*>& children, int worker) {
+        if (apply_node_result(tree_, node, r, children)) {
+            incumbent_->offer(node->lp_value(), worker);
+        }
+    }
+
+    /**
+     * @brief Subscription callback: adopt an improved upper bound.
+     *
+     * Runs on whichever worker claimed the improvement. Takes the
+     * selector lock (for non-concurrent selectors) but not the tree lock;
+     * pruning is flagged and done later by prune_if_pending().
+     */
+    void import_bound(double ub) {
+        tree_.tighten_upper_bound(ub);
+        ub = tree_.global_upper_bound();
+        if (ub == std::numeric_limits<double>::infinity()) return;
+        if (selector_.is_concurrent() || config_.deterministic) {
+            selector_.on_bound_update(ub);
+        } else {
+            std::lock_guard<std::mutex> lock(selector_mutex_);
+            selector_.on_bound_update(ub);
+        }
+    }
+
+    /**
+     * @brief Take the next node for @p worker, or nullptr when done.
+     *
+     * The node is counted in in_flight_ before the selector is asked, so
+     * "selector empty and nothing in flight" reliably means the tree is
+     * exhausted even when a concurrent selector is used without the lock.
+     */
+    BPNode* acquire(int worker) {
+        const bool concurrent = selector_.is_concurrent();
+        std::unique_lock<std::mutex> lock(selector_mutex_);
+        while (!stop_requested_.load()) {
+            in_flight_++;
+            BPNode* node;
+            if (concurrent) {
+                lock.unlock();
+                node = selector_.select_for_worker(worker);
+                lock.lock();
+            } else {
+                node = selector_.select_for_worker(worker);
+            }
+            if (node) {
+                if (reserve_node()) return node;
+                selector_.add_nodes_for_worker({node}, worker);  // Left open for a later run
+                in_flight_--;
+                if (!stop_requested_.load()) stop_status_ = ParallelStatus::NODE_LIMIT;
+                stop_requested_.store(true);
+                wake_.notify_all();
+                return nullptr;
+            }
+            in_flight_--;
+            if (in_flight_ == 0 && selector_.empty()) {
+                stop_requested_.store(true);  // Tree exhausted
+                wake_.notify_all();
+                return nullptr;
+            }
+            // Children may still arrive from nodes in flight
+            wake_.wait(lock, [&] {
+                return stop_requested_.load() || !selector_.empty() || in_flight_ == 0;
+            });
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Non-deterministic worker loop.
+     */
+    void work(int worker, const NodeProcessor& process, BoundSubscription& bounds) {
+        const bool concurrent = selector_.is_concurrent();
+        std::vector<BPNode*> children;
+        while (true) {
+            bounds.poll();
+            tree_.prune_if_pending();
+            BPNode* node = acquire(worker);
+            if (!node) break;
+            try {
+                if (tree_.begin_processing(node)) {
+                    NodeResult r = process(node, worker);
+                    apply(node, r, children, worker);
+                    result_.nodes_per_worker[static_cast<size_t>(worker)]++;
+                } else {
+                    children.clear();  // Pruned after selection
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(selector_mutex_);
+                in_flight_--;
+                stop_requested_.store(true);
+                stop_status_ = ParallelStatus::INTERRUPTED;
+                wake_.notify_all();
+                throw;
+            }
+
+            if (concurrent) selector_.add_nodes_for_worker(children, worker);
+            {
+                std::lock_guard<std::mutex> lock(selector_mutex_);
+                if (!concurrent) selector_.add_nodes_for_worker(children, worker);
+                in_flight_--;
+            }
+            wake_.notify_all();
+            check_limits();
+        }
+    }
+
+    /**
+     * @brief Deterministic mode: synchronised rounds merged in ID order.
+     */
+    void run_rounds(WorkerPool& pool, const NodeProcessor& process, BoundSubscription& bounds) {
+        const size_t round_size = static_cast<size_t>(config_.round_size);
+        std::vector<BPNode*> batch;
+        std::vector<NodeResult> results;
+        std::vector<size_t> order;
+        std::vector<BPNode*> children;
+
+        while (true) {
+            bounds.poll();
+            tree_.prune_if_pending();
+            if (check_limits()) break;
+
+            batch.clear();
+            while (batch.size() < round_size) {
+                BPNode* node = selector_.select_next();
+                if (!node) break;
+                if (!node->can_be_explored()) continue;  // Pruned after queuing
+                if (!reserve_node()) {
+                    selector_.add_node(node);  // Left open for a later run
+                    request_stop(ParallelStatus::NODE_LIMIT);
+                    break;
+                }
+                tree_.begin_processing(node);
+                batch.push_back(node);
+            }
+            if (batch.empty()) break;  // Completed, or node limit hit
+
+            results.assign(batch.size(), NodeResult());
+            pool.run_tasks(batch.size(), [&](size_t k, int worker) {
+                results[k] = process(batch[k], worker);
+                result_.nodes_per_worker[static_cast<size_t>(worker)]++;
+            });
+            result_.rounds++;
+
+            order.resize(batch.size());
+            for (size_t k = 0; k < order.size(); ++k) order[k] = k;
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                return batch[a]->id() < batch[b]->id();
+            });
+            for (size_t k : order) {
+                apply(batch[k], results[k], children, 0);
+                selector_.add_nodes(children);
+            }
+            if (stop_requested_.load()) break;
+        }
+    }
+
+    BPTree& tree_;
+    NodeSelector& selector_;
+    ParallelConfig config_;
+    IncumbentRegister own_incumbent_;
+    IncumbentRegister* incumbent_ = &own_incumbent_;
+
+    std::mutex selector_mutex_;  // Guards selector_, in_flight_, stop_status_
+    std::condition_variable wake_;
+    int64_t in_flight_ = 0;
+    std::atomic<bool> stop_requested_{false};
+    ParallelStatus stop_status_ = ParallelStatus::COMPLETED;
+    std::atomic<int64_t> nodes_started_{0};
+
+    Clock::time_point start_;
+    ParallelResult result_;
+};
+
+
+/**
+ * @brief Configuration of the portfolio (racing) driver.
+ */
+struct PortfolioConfig {
+    /// One racer per entry, each a create_selector() name
+    std::vector<std::string> selectors = {"best_first", "depth_first", "best_estimate", "hybrid"};
+    int64_t max_nodes = 0;  // Per racer, 0 = unlimited
+    double time_limit = std::numeric_limits<double>::infinity();  // seconds
+    double gap_tolerance = 1e-6;
+};
+
+/**
+ * @brief Outcome of one racer.
+ */
+struct RacerResult {
+    std::string selector;
+    ParallelStatus status = ParallelStatus::INTERRUPTED;
+    int64_t nodes_processed = 0;
+    int64_t bounds_imported = 0;  // Upper bounds received from other racers
+    double lower_bound = -std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief Summary of a portfolio run.
+ */
+struct PortfolioResult {
+    /// COMPLETED or GAP_LIMIT if a racer proved optimality (or infeasibility)
+    ParallelStatus status = ParallelStatus::INTERRUPTED;
+    int winner = -1;            // Racer that closed the gap, -1 if none did
+    int incumbent_racer = -1;   // Racer that found the best solution, -1 if none
+    double upper_bound = std::numeric_limits<double>::infinity();
+    double lower_bound = -std::numeric_limits<double>::infinity();
+    std::vector<double> solution;
+    double elapsed = 0.0;  // seconds
+    std::vector<RacerResult> racers;
+};
+
+
+/**
+ * @brief Races several node selection policies on the same problem.
+ *
+ * Each racer explores its own BPTree with its own selector on its own
+ * thread, calling the processor sequentially. Racers share one incumbent:
+ * whenever a racer finds a better integer solution its value is offered
+ * to a lock-free IncumbentRegister, and every other racer picks up the
+ * new upper bound through its subscription before its next node,
+ * tightens and prunes its tree and notifies its selector. The first racer to close
+ * its gap (or to exhaust its tree) has proven the shared incumbent
+ * optimal, and all racers stop.
+ *
+ * The processor is called concurrently by different racers (the worker
+ * index is the racer index), each time on a node of that racer's tree.
+ */
+class PortfolioSolver {
+public:
+    using NodeProcessor = ParallelSolver::NodeProcessor;
+
+    explicit PortfolioSolver(PortfolioConfig config = PortfolioConfig())
+        : config_(std::move(config))
+    {
+        if (config_.selectors.empty()) config_.selectors.push_back("best_first");
+    }
+
+    const PortfolioConfig& config() const { return config_; }
+
+    int num_racers() const { return static_cast<int>(config_.selectors.size()); }
+
+    /**
+     * @brief Race all configured selectors until one proves optimality
+     * or every racer hits a limit.
+     *
+     * @param setup_root Optional hook to initialise each racer's root
+     *        (e.g. its lower bound) before the race starts
+     */
+    PortfolioResult run(const NodeProcessor& process,
+                        const std::function<void(BPNode*)>& setup_root = nullptr) {
+        start_ = Clock::now();
+        stop_requested_.store(false);
+        racers_.clear();
+        {
+            std::lock_guard<std::mutex> lock(incumbent_mutex_);
+            best_ = PortfolioResult();
+        }
+        incumbent_.reset();
+
+        for (const std::string& name : config_.selectors) {
+            auto racer = std::make_unique<Racer>();
+            racer->selector = create_selector(name);
+            racer->result.selector = name;
+            if (setup_root) setup_root(racer->tree.root());
+            racers_.push_back(std::move(racer));
+        }
+
+        WorkerPool pool(num_racers());
+        pool.run_on_all([&](int r) {
+            try {
+                race(r, process);
+            } catch (...) {
+                stop();
+                throw;
+            }
+        });
+
+        std::lock_guard<std::mutex> lock(incumbent_mutex_);
+        PortfolioResult result = best_;
+        result.elapsed = elapsed();
+        result.status = ParallelStatus::NODE_LIMIT;
+        for (const auto& racer : racers_) {
+            result.racers.push_back(racer->result);
+            result.lower_bound = std::max(result.lower_bound, racer->result.lower_bound);
+            ParallelStatus s = racer->result.status;
+            if (s == ParallelStatus::TIME_LIMIT || s == ParallelStatus::INTERRUPTED) {
+                result.status = s;
+            }
+        }
+        if (result.winner >= 0) {
+            result.status = racers_[static_cast<size_t>(result.winner)]->result.status;
+        }
+        result.lower_bound = std::min(result.lower_bound, result.upper_bound);
+        return result;
+    }
+
+    /**
+     * @brief Ask all racers to stop (callable from any thread).
+     */
+    void stop() { stop_requested_.store(true); }
+
+    /**
+     * @brief A racer's tree (valid until the next run()).
+     */
+    const BPTree& tree(int racer) const { return racers_.at(static_cast<size_t>(racer))->tree; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Racer {
+        BPTree tree;
+        std::unique_ptr<NodeSelector> selector;
+        RacerResult result;
+    };
+
+    double elapsed() const {
+        return std::chrono::duration<double>(Clock::now() - start_).count();
+    }
+
+    /**
+     * @brief Sequential branch-and-price loop of one racer.
+     */
+    void race(int r, const NodeProcessor& process) {
+        Racer& racer = *racers_[static_cast<size_t>(r)];
+        BPTree& tree = racer.tree;
+        NodeSelector& selector = *racer.selector;
+        RacerResult& result = racer.result;
+        std::vector<BPNode*> children;
+        BoundSubscription bounds(incumbent_, [&](double ub) {
+            if (!tree.tighten_upper_bound(ub)) return;  // Own bound, or already known
+            selector.on_bound_update(ub);
+            result.bounds_imported++;
+        });
+
+        if (tree.root()->can_be_explored()) selector.add_node(tree.root());
+
+        while (true) {
+            bounds.poll();
+            tree.prune_if_pending();
+            result.lower_bound = tree.global_lower_bound();
+
+            if (stop_requested_.load()) {
+                result.status = ParallelStatus::INTERRUPTED;
+                return;
+            }
+            if (tree.gap() <= config_.gap_tolerance) {
+                finish(r, ParallelStatus::GAP_LIMIT);
+                return;
+            }
+            if (elapsed() >= config_.time_limit) {
+                result.status = ParallelStatus::TIME_LIMIT;
+                return;
+            }
+            if (config_.max_nodes > 0 && result.nodes_processed >= config_.max_nodes) {
+                result.status = ParallelStatus::NODE_LIMIT;
+                return;
+            }
+
+            BPNode* node = selector.select_next();
+            if (!node) {
+                result.lower_bound = tree.global_lower_bound();
+                finish(r, ParallelStatus::COMPLETED);
+                return;
+            }
+            if (!tree.begin_processing(node)) continue;  // Pruned after queuing
+
+            NodeResult res = process(node, r);
+            result.nodes_processed++;
+            if (apply_node_result(tree, node, res, children)) {
+                selector.on_bound_update(tree.global_upper_bound());
+                publish(r, node);
+            }
+            selector.add_nodes(children);
+        }
+    }
+
+    /**
+     * @brief Offer a racer's new incumbent to the portfolio.
+     *
+     * The bound goes through the register; the lock only guards the
+     * solution copy, which is kept if no better one got there first.
+     */
+    void publish(int r, const BPNode* node) {
+        if (!incumbent_.offer(node->lp_value(), r)) return;
+        std::lock_guard<std::mutex> lock(incumbent_mutex_);
+        if (!(node->lp_value() < best_.upper_bound)) return;
+        best_.upper_bound = node->lp_value();
+        best_.solution = node->solution();
+        best_.incumbent_racer = r;
+    }
+
+    /**
+     * @brief A racer proved optimality: record it and stop everyone.
+     */
+    void finish(int r, ParallelStatus status) {
+        racers_[static_cast<size_t>(r)]->result.status = status;
+        std::lock_guard<std::mutex> lock(incumbent_mutex_);
+        if (best_.winner < 0) {
+            best_.winner = r;
+            stop_requested_.store(true);
+        }
+    }
+
+    PortfolioConfig config_;
+    std::vector<std::unique_ptr<Racer>> racers_;
+
+    IncumbentRegister incumbent_;  // Shared upper bound
+    std::mutex incumbent_mutex_;   // Guards best_
+    PortfolioResult best_;         // Best solution and winner
+    std::atomic<bool> stop_requested_{false};
+    Clock::time_point start_;
+};
+
+}  // namespace openbp
@@ -10,12 +10,18 @@
 
 #include "node.hpp"
 #include "tree.hpp"
+#include "indexed_heap.hpp"
 
 #include <queue>
+#include <type_traits>
 #include <functional>
 #include <algorithm>
 #include <cmath>
 #include <random>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace openbp {
 
@@ -23,9 +29,11 @@ namespace openbp {
  * @brief Abstract base class for node selection policies.
  *
  * Subclasses implement different strategies for selecting the next
- * node to explore in the B&P tree.
+ * node to explore in the B&P tree. A selector attached to a tree with
+ * BPTree::add_listener() drops nodes the tree prunes and re-orders
+ * nodes whose lower bound changes as soon as it happens.
  */
-class NodeSelector {
+class NodeSelector : public TreeListener {
 public:
     virtual ~NodeSelector() = default;
 
@@ -73,6 +81,38 @@ public:
      */
     virtual size_t prune() = 0;
 
+    /**
+     * @brief Remove a specific node from the selector.
+     * @param node The node to remove
+     * @return true if the node was held by the selector
+     */
+    virtual bool remove(BPNode* node) {
+        (void)node;
+        return false;
+    }
+
+    /**
+     * @brief Restore ordering after a held node's lower bound changed.
+     *
+     * Must be called whenever the lower bound of a node inside the
+     * selector is modified, otherwise heap-based selectors lose their
+     * ordering invariant.
+     * @param node The node whose priority changed
+     * @return true if the node was held by the selector
+     */
+    virtual bool update_priority(BPNode* node) {
+        (void)node;
+        return false;
+    }
+
+    /**
+     * @brief Check whether the selector currently holds a node.
+     */
+    virtual bool contains(const BPNode* node) const {
+        (void)node;
+        return false;
+    }
+
     /**
      * @brief Update after global bound improvement.
      * Called when the global upper bound is updated.
@@ -80,6 +120,7 @@ public:
      */
     virtual void on_bound_update(double new_bound) {
         // Default: do nothing. Subclasses can override.
+        (void)new_bound;
     }
 
     /**
@@ -96,98 +137,247 @@ public:
      * @brief Clear all nodes from the selector.
      */
     virtual void clear() = 0;
+
+    /**
+     * @brief Whether the selector may be used from several threads at
+     * once without external locking.
+     */
+    virtual bool is_concurrent() const { return false; }
+
+    /**
+     * @brief Select the next node on behalf of a parallel worker.
+     *
+     * Per-worker selectors use @p worker to prefer the worker's own
+     * nodes; the default ignores it.
+     */
+    virtual BPNode* select_for_worker(int worker) {
+        (void)worker;
+        return select_next();
+    }
+
+    /**
+     * @brief Add nodes created by a parallel worker.
+     */
+    virtual void add_nodes_for_worker(const std::vector<BPNode*>& nodes, int worker) {
+        (void)worker;
+        add_nodes(nodes);
+    }
+
+    // TreeListener
+    void on_node_closed(BPNode* node) override { remove(node); }
+    void on_node_bound_changed(BPNode* node) override { update_priority(node); }
 };
 
 
 /**
- * @brief Best-first (best-bound) node selection.
+ * @brief Heap ordering for best-first selection (lowest lower bound first).
+ */
+struct ByLowerBound {
+    bool operator()(const BPNode* a, const BPNode* b) const {
+        if (a->lower_bound() != b->lower_bound()) {
+            return a->lower_bound() < b->lower_bound();
+        }
+        // Tiebreaker: older node first, for a deterministic order
+        return a->id() < b->id();
+    }
+};
+
+/**
+ * @brief Heap ordering for depth-first selection (deepest first).
+ */
+struct ByDepthThenBound {
+    bool operator()(const BPNode* a, const BPNode* b) const {
+        // Deeper is better
+        if (a->depth() != b->depth()) {
+            return a->depth() > b->depth();
+        }
+        // Tiebreaker: lower bound, then ID
+        if (a->lower_bound() != b->lower_bound()) {
+            return a->lower_bound() < b->lower_bound();
+        }
+        return a->id() < b->id();
+    }
+};
+
+
+/**
+ * @brief Common implementation for selectors backed by an IndexedHeap.
  *
- * Always explores the node with the lowest lower bound.
- * This minimizes the number of nodes explored but may delay
- * finding good integer solutions.
+ * Nodes that stop being explorable are dropped lazily when they reach
+ * the top of the heap, so select_next() is O(log n) amortized. prune()
+ * finds stale entries in one O(n) pass and removes them individually in
+ * O(log n) each, or compacts the whole heap in O(n) once they exceed
+ * compaction_threshold of its size. remove() and update_priority() are
+ * O(log n) for any held node.
+ *
+ * When the selection order is not by bound, the same nodes are also kept
+ * in a lower-bound heap so that best_bound() stays O(1) amortized.
+ *
+ * @tparam Before Heap ordering (see IndexedHeap)
+ * @tparam TrackBound Maintain the secondary lower-bound heap
+ * @tparam Positions Heap position map (see IndexedHeap)
  */
-class BestFirstSelector : public NodeSelector {
+template<typename Before, bool TrackBound = !std::is_same<Before, ByLowerBound>::value,
+         typename Positions = DensePositions>
+class HeapSelector : public NodeSelector {
 public:
-    BestFirstSelector() = default;
+    static constexpr double DEFAULT_COMPACTION_THRESHOLD = 0.5;
+
+    explicit HeapSelector(double compaction_threshold = DEFAULT_COMPACTION_THRESHOLD)
+        : compaction_threshold_(compaction_threshold)
+    {}
 
     void add_node(BPNode* node) override {
         if (node && node->can_be_explored()) {
-            queue_.push(node);
+            heap_.push(node);
+            if constexpr (TrackBound) by_bound_.push(node);
         }
     }
 
     BPNode* select_next() override {
-        prune();
-        if (queue_.empty()) return nullptr;
-
-        BPNode* node = queue_.top();
-        queue_.pop();
+        discard_stale_top();
+        BPNode* node = heap_.pop();
+        if constexpr (TrackBound) {
+            if (node) by_bound_.remove(node);
+        }
         return node;
     }
 
     BPNode* peek_next() const override {
-        if (queue_.empty()) return nullptr;
-        return queue_.top();
+        discard_stale_top();
+        return heap_.top();
     }
 
+    /**
+     * @brief Whether no explorable node is held, O(log n) amortized.
+     */
     bool empty() const override {
-        return queue_.empty();
+        discard_stale_top();
+        return heap_.empty();
     }
 
+    /**
+     * @brief Number of explorable nodes held, counted in one O(n) pass.
+     *
+     * Nodes can be closed without the selector being told, so a running
+     * count would include them until they surface; use empty() in loops.
+     */
     size_t size() const override {
-        return queue_.size();
+        return static_cast<size_t>(std::count_if(heap_.items().begin(), heap_.items().end(),
+            [](const BPNode* n) { return n->can_be_explored(); }));
     }
 
+    /**
+     * @brief Remove all non-explorable nodes.
+     * @return Number of nodes removed
+     */
     size_t prune() override {
-        // Remove nodes that are no longer explorable
-        std::vector<BPNode*> valid;
-        size_t removed = 0;
-
-        while (!queue_.empty()) {
-            BPNode* node = queue_.top();
-            queue_.pop();
-            if (node->can_be_explored()) {
-                valid.push_back(node);
-            } else {
-                removed++;
-            }
+        stale_.clear();
+        for (BPNode* node : heap_.items()) {
+            if (!node->can_be_explored()) stale_.push_back(node);
         }
-
-        for (auto* node : valid) {
-            queue_.push(node);
+        if (static_cast<double>(stale_.size()) > compaction_threshold_ * static_cast<double>(heap_.size())) {
+            return compact();
+        }
+        for (BPNode* node : stale_) {
+            heap_.remove(node);
+            if constexpr (TrackBound) by_bound_.remove(node);
         }
+        return stale_.size();
+    }
 
-        return removed;
+    /**
+     * @brief Remove all non-explorable nodes in one O(n) pass.
+     * @return Number of nodes removed
+     */
+    size_t compact() {
+        auto stale = [](const BPNode* n) { return !n->can_be_explored(); };
+        if constexpr (TrackBound) by_bound_.remove_if(stale);
+        return heap_.remove_if(stale);
+    }
+
+    bool remove(BPNode* node) override {
+        if (!node) return false;
+        if constexpr (TrackBound) by_bound_.remove(node);
+        return heap_.remove(node);
     }
 
+    bool update_priority(BPNode* node) override {
+        if (!node) return false;
+        if constexpr (TrackBound) by_bound_.update(node);
+        return heap_.update(node);
+    }
+
+    bool contains(const BPNode* node) const override {
+        return node && heap_.contains(node);
+    }
+
+    /**
+     * @brief Lowest lower bound among held nodes, O(1) amortized.
+     */
     double best_bound() const override {
-        if (queue_.empty()) return std::numeric_limits<double>::infinity();
-        return queue_.top()->lower_bound();
+        if constexpr (TrackBound) {
+            discard_stale_bound_top();
+            return by_bound_.empty() ? std::numeric_limits<double>::infinity()
+                                     : by_bound_.top()->lower_bound();
+        } else {
+            discard_stale_top();
+            return heap_.empty() ? std::numeric_limits<double>::infinity()
+                                 : heap_.top()->lower_bound();
+        }
     }
 
     std::vector<BPNode::NodeId> get_open_node_ids() const override {
         std::vector<BPNode::NodeId> ids;
-        auto copy = queue_;
-        while (!copy.empty()) {
-            ids.push_back(copy.top()->id());
-            copy.pop();
+        ids.reserve(heap_.size());
+        for (const BPNode* node : heap_.items()) {
+            if (node->can_be_explored()) ids.push_back(node->id());
         }
         return ids;
     }
 
     void clear() override {
-        while (!queue_.empty()) queue_.pop();
+        heap_.clear();
+        by_bound_.clear();
     }
 
-private:
-    struct CompareByBound {
-        bool operator()(const BPNode* a, const BPNode* b) const {
-            // Min-heap: lower bound is better
-            return a->lower_bound() > b->lower_bound();
+    double compaction_threshold() const { return compaction_threshold_; }
+
+protected:
+    // Lazy deletion: drop stale entries only once they reach the top.
+    // Logically const - only entries that are no longer open are removed.
+    void discard_stale_top() const {
+        while (!heap_.empty() && !heap_.top()->can_be_explored()) {
+            BPNode* node = heap_.pop();
+            if constexpr (TrackBound) by_bound_.remove(node);
         }
-    };
+    }
 
-    std::priority_queue<BPNode*, std::vector<BPNode*>, CompareByBound> queue_;
+    void discard_stale_bound_top() const {
+        while (!by_bound_.empty() && !by_bound_.top()->can_be_explored()) {
+            heap_.remove(by_bound_.pop());
+        }
+    }
+
+    mutable IndexedHeap<Before, 4, Positions> heap_;
+    mutable IndexedHeap<ByLowerBound, 4, Positions> by_bound_;  // Only used if TrackBound
+    double compaction_threshold_;
+    std::vector<BPNode*> stale_;  // Scratch buffer for prune()
+};
+
+
+/**
+ * @brief Best-first (best-bound) node selection.
+ *
+ * Always explores the node with the lowest lower bound.
+ * This minimizes the number of nodes explored but may delay
+ * finding good integer solutions.
+ */
+class BestFirstSelector : public HeapSelector<ByLowerBound> {
+public:
+    explicit BestFirstSelector(double compaction_threshold = DEFAULT_COMPACTION_THRESHOLD)
+        : HeapSelector(compaction_threshold)
+    {}
 };
 
 
@@ -197,98 +387,45 @@ private:
  * Explores deepest nodes first, which tends to find integer
  * solutions quickly. Uses best-bound as tiebreaker.
  */
-class DepthFirstSelector : public NodeSelector {
+class DepthFirstSelector : public HeapSelector<ByDepthThenBound> {
 public:
-    DepthFirstSelector() = default;
-
-    void add_node(BPNode* node) override {
-        if (node && node->can_be_explored()) {
-            queue_.push(node);
-        }
-    }
-
-    BPNode* select_next() override {
-        prune();
-        if (queue_.empty()) return nullptr;
-
-        BPNode* node = queue_.top();
-        queue_.pop();
-        return node;
-    }
-
-    BPNode* peek_next() const override {
-        if (queue_.empty()) return nullptr;
-        return queue_.top();
-    }
-
-    bool empty() const override {
-        return queue_.empty();
-    }
-
-    size_t size() const override {
-        return queue_.size();
-    }
-
-    size_t prune() override {
-        std::vector<BPNode*> valid;
-        size_t removed = 0;
-
-        while (!queue_.empty()) {
-            BPNode* node = queue_.top();
-            queue_.pop();
-            if (node->can_be_explored()) {
-                valid.push_back(node);
-            } else {
-                removed++;
-            }
-        }
+    explicit DepthFirstSelector(double compaction_threshold = DEFAULT_COMPACTION_THRESHOLD)
+        : HeapSelector(compaction_threshold)
+    {}
+};
 
-        for (auto* node : valid) {
-            queue_.push(node);
-        }
 
-        return removed;
-    }
+/**
+ * @brief Heap ordering for best-estimate selection (lowest estimate first).
+ *
+ * The estimate depends only on the node and on the incumbent value and
+ * maximum depth held here, so the heap stays valid until either changes.
+ */
+struct ByEstimate {
+    double estimate_weight = 0.5;
+    double global_upper_bound = std::numeric_limits<double>::infinity();
+    int64_t max_depth = 1;
 
-    double best_bound() const override {
-        if (queue_.empty()) return std::numeric_limits<double>::infinity();
+    double estimate(const BPNode* node) const {
+        double lb = node->lower_bound();
 
-        double best = std::numeric_limits<double>::infinity();
-        auto copy = queue_;
-        while (!copy.empty()) {
-            best = std::min(best, copy.top()->lower_bound());
-            copy.pop();
+        if (global_upper_bound == std::numeric_limits<double>::infinity()) {
+            // No incumbent yet - use depth penalty to encourage diving
+            return lb - estimate_weight * node->depth();
         }
-        return best;
-    }
 
-    std::vector<BPNode::NodeId> get_open_node_ids() const override {
-        std::vector<BPNode::NodeId> ids;
-        auto copy = queue_;
-        while (!copy.empty()) {
-            ids.push_back(copy.top()->id());
-            copy.pop();
-        }
-        return ids;
+        // Estimate based on depth progress toward integer
+        double depth_ratio = static_cast<double>(node->depth()) / static_cast<double>(std::max(static_cast<int64_t>(1), max_depth));
+        double gap = global_upper_bound - lb;
+        return lb + estimate_weight * (1.0 - depth_ratio) * gap;
     }
 
-    void clear() override {
-        while (!queue_.empty()) queue_.pop();
+    bool operator()(const BPNode* a, const BPNode* b) const {
+        double ea = estimate(a);
+        double eb = estimate(b);
+        if (ea != eb) return ea < eb;
+        return a->id() < b->id();
     }
-
-private:
-    struct CompareByDepth {
-        bool operator()(const BPNode* a, const BPNode* b) const {
-            // Max-heap for depth: deeper is better
-            if (a->depth() != b->depth()) {
-                return a->depth() < b->depth();
-            }
-            // Tiebreaker: lower bound
-            return a->lower_bound() > b->lower_bound();
-        }
-    };
-
-    std::priority_queue<BPNode*, std::vector<BPNode*>, CompareByDepth> queue_;
 };
 
 
@@ -299,117 +436,55 @@ private:
  * integer objective to prioritize nodes likely to lead to
  * good solutions.
  *
- * Estimate = lower_bound + estimate_weight * (depth / max_depth) * gap
+ * Estimate = lower_bound + estimate_weight * (1 - depth / max_depth) * gap
+ *
+ * Nodes are kept in a heap keyed by estimate, so selection is O(log n).
+ * Estimates only change when the incumbent or the maximum depth changes;
+ * the heap is then re-keyed in bulk with one O(n) heapify. Before an
+ * incumbent exists the estimate does not depend on the maximum depth, so
+ * depth growth costs nothing.
  */
-class BestEstimateSelector : public NodeSelector {
+class BestEstimateSelector : public HeapSelector<ByEstimate> {
 public:
     /**
      * @brief Construct a best-estimate selector.
      * @param estimate_weight Weight for the depth-based estimate (default 0.5)
      */
-    explicit BestEstimateSelector(double estimate_weight = 0.5)
-        : estimate_weight_(estimate_weight)
-        , global_upper_bound_(std::numeric_limits<double>::infinity())
-        , max_depth_(1)
-    {}
+    explicit BestEstimateSelector(double estimate_weight = 0.5,
+                                  double compaction_threshold = DEFAULT_COMPACTION_THRESHOLD)
+        : HeapSelector(compaction_threshold)
+    {
+        heap_.ordering().estimate_weight = estimate_weight;
+    }
 
     void add_node(BPNode* node) override {
-        if (node && node->can_be_explored()) {
-            nodes_.push_back(node);
-            max_depth_ = std::max(max_depth_, static_cast<int64_t>(node->depth()));
+        if (!node || !node->can_be_explored()) return;
+        ByEstimate& key = heap_.ordering();
+        if (node->depth() > key.max_depth) {
+            key.max_depth = node->depth();
+            if (has_incumbent()) heap_.rebuild();
         }
-    }
-
-    BPNode* select_next() override {
-        prune();
-        if (nodes_.empty()) return nullptr;
-
-        // Find node with best estimate
-        auto best_it = std::min_element(nodes_.begin(), nodes_.end(),
-            [this](const BPNode* a, const BPNode* b) {
-                return estimate(a) < estimate(b);
-            });
-
-        BPNode* node = *best_it;
-        nodes_.erase(best_it);
-        return node;
-    }
-
-    BPNode* peek_next() const override {
-        if (nodes_.empty()) return nullptr;
-
-        auto best_it = std::min_element(nodes_.begin(), nodes_.end(),
-            [this](const BPNode* a, const BPNode* b) {
-                return estimate(a) < estimate(b);
-            });
-
-        return *best_it;
-    }
-
-    bool empty() const override {
-        return nodes_.empty();
-    }
-
-    size_t size() const override {
-        return nodes_.size();
-    }
-
-    size_t prune() override {
-        size_t old_size = nodes_.size();
-        nodes_.erase(
-            std::remove_if(nodes_.begin(), nodes_.end(),
-                [](BPNode* n) { return !n->can_be_explored(); }),
-            nodes_.end()
-        );
-        return old_size - nodes_.size();
+        HeapSelector::add_node(node);
     }
 
     void on_bound_update(double new_bound) override {
-        global_upper_bound_ = new_bound;
+        ByEstimate& key = heap_.ordering();
+        if (new_bound == key.global_upper_bound) return;
+        key.global_upper_bound = new_bound;
+        heap_.rebuild();
     }
 
-    double best_bound() const override {
-        if (nodes_.empty()) return std::numeric_limits<double>::infinity();
+    double estimate_weight() const { return heap_.ordering().estimate_weight; }
 
-        double best = std::numeric_limits<double>::infinity();
-        for (const auto* node : nodes_) {
-            best = std::min(best, node->lower_bound());
-        }
-        return best;
-    }
-
-    std::vector<BPNode::NodeId> get_open_node_ids() const override {
-        std::vector<BPNode::NodeId> ids;
-        ids.reserve(nodes_.size());
-        for (const auto* node : nodes_) {
-            ids.push_back(node->id());
-        }
-        return ids;
-    }
-
-    void clear() override {
-        nodes_.clear();
-    }
+    /**
+     * @brief Deepest node depth seen so far (normalizes the estimate).
+     */
+    int64_t max_depth() const { return heap_.ordering().max_depth; }
 
 private:
-    double estimate(const BPNode* node) const {
-        double lb = node->lower_bound();
-
-        if (global_upper_bound_ == std::numeric_limits<double>::infinity()) {
-            // No incumbent yet - use depth penalty to encourage diving
-            return lb - estimate_weight_ * node->depth();
-        }
-
-        // Estimate based on depth progress toward integer
-        double depth_ratio = static_cast<double>(node->depth()) / static_cast<double>(std::max(static_cast<int64_t>(1), max_depth_));
-        double gap = global_upper_bound_ - lb;
-        return lb + estimate_weight_ * (1.0 - depth_ratio) * gap;
+    bool has_incumbent() const {
+        return heap_.ordering().global_upper_bound != std::numeric_limits<double>::infinity();
     }
-
-    std::vector<BPNode*> nodes_;
-    double estimate_weight_;
-    double global_upper_bound_;
-    int64_t max_depth_;
 };
 
 
@@ -418,38 +493,28 @@ private:
  *
  * Alternates between best-first and depth-first selection
  * to balance bound improvement and solution finding.
+ *
+ * Each node is stored once and indexed by two heaps (depth order and
+ * bound order, see HeapSelector). A node selected through one order is
+ * removed from the other in O(log n), so no queue ever needs a rescan.
  */
-class HybridSelector : public NodeSelector {
+class HybridSelector : public HeapSelector<ByDepthThenBound, true> {
 public:
     /**
      * @brief Construct a hybrid selector.
      * @param dive_frequency How often to dive (1 = every node, higher = less often)
      * @param dive_depth How deep to dive before switching back
      */
-    HybridSelector(int dive_frequency = 5, int dive_depth = 10)
-        : dive_frequency_(dive_frequency)
+    HybridSelector(int dive_frequency = 5, int dive_depth = 10,
+                   double compaction_threshold = DEFAULT_COMPACTION_THRESHOLD)
+        : HeapSelector(compaction_threshold)
+        , dive_frequency_(dive_frequency)
         , dive_depth_(dive_depth)
         , nodes_since_dive_(0)
         , current_dive_depth_(0)
         , diving_(false)
     {}
 
-    void add_node(BPNode* node) override {
-        if (node && node->can_be_explored()) {
-            best_first_.add_node(node);
-            depth_first_.add_node(node);
-        }
-    }
-
-    void add_nodes(const std::vector<BPNode*>& nodes) override {
-        for (auto* node : nodes) {
-            if (node && node->can_be_explored()) {
-                best_first_.add_node(node);
-                depth_first_.add_node(node);
-            }
-        }
-    }
-
     BPNode* select_next() override {
         // Decide whether to dive
         if (!diving_ && nodes_since_dive_ >= dive_frequency_) {
@@ -458,77 +523,357 @@ public:
         }
 
         if (diving_) {
-            BPNode* node = depth_first_.select_next();
+            BPNode* node = HeapSelector::select_next();
             if (node) {
                 current_dive_depth_++;
                 if (current_dive_depth_ >= dive_depth_) {
                     diving_ = false;
                     nodes_since_dive_ = 0;
                 }
-                // Remove from best_first too (it's a duplicate)
-                best_first_.prune();
                 return node;
             }
-            // Depth-first is empty, switch to best-first
+            // Nothing left to dive into
             diving_ = false;
         }
 
         nodes_since_dive_++;
-        depth_first_.prune();
-        return best_first_.select_next();
+        discard_stale_bound_top();
+        BPNode* node = by_bound_.pop();
+        if (node) heap_.remove(node);
+        return node;
     }
 
     BPNode* peek_next() const override {
         if (diving_) {
-            return depth_first_.peek_next();
+            return HeapSelector::peek_next();
+        }
+        discard_stale_bound_top();
+        return by_bound_.top();
+    }
+
+    void clear() override {
+        HeapSelector::clear();
+        nodes_since_dive_ = 0;
+        current_dive_depth_ = 0;
+        diving_ = false;
+    }
+
+    bool is_diving() const { return diving_; }
+
+private:
+    int dive_frequency_;
+    int dive_depth_;
+    int nodes_since_dive_;
+    int current_dive_depth_;
+    bool diving_;
+};
+
+
+/**
+ * @brief Work-stealing node selection for parallel workers.
+ *
+ * Each worker owns a local queue with its own lock. Children added by a
+ * worker go to its own queue and are explored depth-first, which keeps
+ * related nodes (and their warm-started LPs) on one thread. Workers only
+ * touch each other's queues in two cases:
+ *
+ * - Balancing: if the best bound in a worker's queue is more than
+ *   max_bound_drift (relative) above the global best bound, the worker
+ *   takes the best-bound node from the queue holding it instead, so the
+ *   dual bound keeps moving.
+ * - Stealing: an idle worker takes the best-bound node of the queue
+ *   with the lowest bound.
+ *
+ * Each queue publishes its size and best bound in atomics after every
+ * change, so choosing a victim takes no lock, and no operation ever
+ * holds two queue locks. All methods are thread-safe. Calls without a
+ * worker (select_next(), add_node()) act for worker 0 or spread nodes
+ * round-robin, respectively.
+ */
+class WorkStealingSelector : public NodeSelector {
+public:
+    static constexpr double DEFAULT_MAX_BOUND_DRIFT = 0.1;
+
+    /**
+     * @brief Construct a work-stealing selector.
+     * @param num_workers Number of local queues (default: hardware concurrency)
+     * @param max_bound_drift Relative distance from the global best bound
+     *        beyond which a worker switches to the global best node
+     */
+    explicit WorkStealingSelector(int num_workers = 0,
+                                  double max_bound_drift = DEFAULT_MAX_BOUND_DRIFT)
+        : max_bound_drift_(max_bound_drift)
+    {
+        if (num_workers <= 0) {
+            num_workers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+        locals_.reserve(static_cast<size_t>(num_workers));
+        for (int w = 0; w < num_workers; ++w) {
+            locals_.push_back(std::make_unique<Local>());
+        }
+    }
+
+    int num_workers() const { return static_cast<int>(locals_.size()); }
+    double max_bound_drift() const { return max_bound_drift_; }
+
+    /**
+     * @brief Nodes taken from another worker's queue while idle.
+     */
+    int64_t num_steals() const { return steals_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Nodes taken from another queue to follow the global best bound.
+     */
+    int64_t num_balancing_picks() const { return balancing_picks_.load(std::memory_order_relaxed); }
+
+    bool is_concurrent() const override { return true; }
+
+    void add_node(BPNode* node) override {
+        if (!node || !node->can_be_explored()) return;
+        size_t w = next_local_.fetch_add(1, std::memory_order_relaxed) % locals_.size();
+        Local& local = *locals_[w];
+        std::lock_guard<std::mutex> lock(local.mutex);
+        local.queue.add_node(node);
+        local.publish();
+    }
+
+    void add_nodes_for_worker(const std::vector<BPNode*>& nodes, int worker) override {
+        if (nodes.empty()) return;
+        Local& local = *locals_[slot(worker)];
+        std::lock_guard<std::mutex> lock(local.mutex);
+        for (BPNode* node : nodes) local.queue.add_node(node);
+        local.publish();
+    }
+
+    BPNode* select_next() override {
+        return select_for_worker(0);
+    }
+
+    BPNode* select_for_worker(int worker) override {
+        const size_t own = slot(worker);
+        Local& local = *locals_[own];
+
+        if (local.size.load(std::memory_order_acquire) > 0) {
+            size_t best = best_local();
+            if (best != own && best != NONE &&
+                drifted(local.best_bound.load(std::memory_order_acquire),
+                        locals_[best]->best_bound.load(std::memory_order_acquire))) {
+                if (BPNode* node = take_best_bound(best)) {
+                    balancing_picks_.fetch_add(1, std::memory_order_relaxed);
+                    return node;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(local.mutex);
+            BPNode* node = local.queue.select_next();
+            local.publish();
+            if (node) return node;
         }
-        return best_first_.peek_next();
+
+        // Idle: steal the best node, preferring the queue with the lowest bound
+        size_t victim = best_local();
+        if (victim != NONE && victim != own) {
+            if (BPNode* node = take_best_bound(victim)) {
+                steals_.fetch_add(1, std::memory_order_relaxed);
+                return node;
+            }
+        }
+        for (size_t k = 1; k <= locals_.size(); ++k) {
+            size_t w = (own + k) % locals_.size();
+            if (locals_[w]->size.load(std::memory_order_acquire) == 0) continue;
+            if (BPNode* node = take_best_bound(w)) {
+                if (w != own) steals_.fetch_add(1, std::memory_order_relaxed);
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Node worker 0 would get from its own queue, or the global
+     * best-bound node if that queue is empty.
+     */
+    BPNode* peek_next() const override {
+        {
+            Local& local = *locals_[0];
+            std::lock_guard<std::mutex> lock(local.mutex);
+            if (BPNode* node = local.queue.peek_next()) return node;
+        }
+        size_t best = best_local();
+        if (best == NONE) return nullptr;
+        Local& local = *locals_[best];
+        std::lock_guard<std::mutex> lock(local.mutex);
+        return local.queue.peek_best_bound();
     }
 
     bool empty() const override {
-        return best_first_.empty();
+        return size() == 0;
     }
 
     size_t size() const override {
-        return best_first_.size();
+        size_t total = 0;
+        for (const auto& local : locals_) total += local->size.load(std::memory_order_acquire);
+        return total;
     }
 
     size_t prune() override {
-        size_t removed1 = best_first_.prune();
-        size_t removed2 = depth_first_.prune();
-        return std::max(removed1, removed2);
+        size_t removed = 0;
+        for_each_local([&](Local& local) { removed += local.queue.prune(); });
+        return removed;
+    }
+
+    bool remove(BPNode* node) override {
+        bool held = false;
+        for_each_local([&](Local& local) { held = local.queue.remove(node) || held; });
+        return held;
+    }
+
+    bool update_priority(BPNode* node) override {
+        bool held = false;
+        for_each_local([&](Local& local) { held = local.queue.update_priority(node) || held; });
+        return held;
+    }
+
+    bool contains(const BPNode* node) const override {
+        for (const auto& local : locals_) {
+            std::lock_guard<std::mutex> lock(local->mutex);
+            if (local->queue.contains(node)) return true;
+        }
+        return false;
     }
 
+    /**
+     * @brief Lowest lower bound among held nodes, from the published
+     * per-queue bounds (no locks).
+     */
     double best_bound() const override {
-        return best_first_.best_bound();
+        size_t best = best_local();
+        return best == NONE ? std::numeric_limits<double>::infinity()
+                            : locals_[best]->best_bound.load(std::memory_order_acquire);
     }
 
     std::vector<BPNode::NodeId> get_open_node_ids() const override {
-        return best_first_.get_open_node_ids();
+        std::vector<BPNode::NodeId> ids;
+        for (const auto& local : locals_) {
+            std::lock_guard<std::mutex> lock(local->mutex);
+            auto local_ids = local->queue.get_open_node_ids();
+            ids.insert(ids.end(), local_ids.begin(), local_ids.end());
+        }
+        return ids;
     }
 
     void clear() override {
-        best_first_.clear();
-        depth_first_.clear();
-        nodes_since_dive_ = 0;
-        current_dive_depth_ = 0;
-        diving_ = false;
+        for_each_local([](Local& local) { local.queue.clear(); });
+    }
+
+    /**
+     * @brief Number of nodes in one worker's queue.
+     */
+    size_t local_size(int worker) const {
+        return locals_[slot(worker)]->size.load(std::memory_order_acquire);
     }
 
 private:
-    BestFirstSelector best_first_;
-    DepthFirstSelector depth_first_;
-    int dive_frequency_;
-    int dive_depth_;
-    int nodes_since_dive_;
-    int current_dive_depth_;
-    bool diving_;
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+    /**
+     * @brief Depth-first queue that can also hand out its best-bound node.
+     *
+     * Nodes migrate between queues through stealing and balancing, so each
+     * queue sees most of the tree over a run. Hashed positions keep its
+     * memory proportional to the nodes it currently holds.
+     */
+    class LocalQueue : public HeapSelector<ByDepthThenBound, true, HashedPositions> {
+    public:
+        /**
+         * @brief Held entries in O(1); may include stale nodes below the top.
+         */
+        size_t held() const {
+            discard_stale_top();
+            return heap_.size();
+        }
+
+        BPNode* select_best_bound() {
+            discard_stale_bound_top();
+            BPNode* node = by_bound_.pop();
+            if (node) heap_.remove(node);
+            return node;
+        }
+
+        BPNode* peek_best_bound() const {
+            discard_stale_bound_top();
+            return by_bound_.top();
+        }
+    };
+
+    struct alignas(64) Local {
+        mutable std::mutex mutex;
+        LocalQueue queue;
+        std::atomic<size_t> size{0};
+        std::atomic<double> best_bound{std::numeric_limits<double>::infinity()};
+
+        // Call with the mutex held
+        void publish() {
+            best_bound.store(queue.best_bound(), std::memory_order_release);
+            size.store(queue.held(), std::memory_order_release);
+        }
+    };
+
+    size_t slot(int worker) const {
+        return static_cast<size_t>(worker < 0 ? 0 : worker) % locals_.size();
+    }
+
+    /**
+     * @brief Index of the non-empty queue with the lowest published bound.
+     */
+    size_t best_local() const {
+        size_t best = NONE;
+        double best_lb = std::numeric_limits<double>::infinity();
+        for (size_t w = 0; w < locals_.size(); ++w) {
+            if (locals_[w]->size.load(std::memory_order_acquire) == 0) continue;
+            double lb = locals_[w]->best_bound.load(std::memory_order_acquire);
+            if (best == NONE || lb < best_lb) {
+                best = w;
+                best_lb = lb;
+            }
+        }
+        return best;
+    }
+
+    bool drifted(double local_bound, double global_bound) const {
+        double scale = std::max(1.0, std::abs(global_bound));
+        return local_bound - global_bound > max_bound_drift_ * scale;
+    }
+
+    BPNode* take_best_bound(size_t w) {
+        Local& local = *locals_[w];
+        std::lock_guard<std::mutex> lock(local.mutex);
+        BPNode* node = local.queue.select_best_bound();
+        local.publish();
+        return node;
+    }
+
+    template<typename Func>
+    void for_each_local(Func&& fn) {
+        for (auto& local : locals_) {
+            std::lock_guard<std::mutex> lock(local->mutex);
+            fn(*local);
+            local->publish();
+        }
+    }
+
+    std::vector<std::unique_ptr<Local>> locals_;
+    double max_bound_drift_;
+    std::atomic<size_t> next_local_{0};
+    std::atomic<int64_t> steals_{0};
+    std::atomic<int64_t> balancing_picks_{0};
 };
 
 
 /**
  * @brief Factory function to create node selectors by name.
- * @param name Selector name: "best_first", "depth_first", "best_estimate", "hybrid"
+ * @param name Selector name: "best_first", "depth_first", "best_estimate", "hybrid",
+ *             "work_stealing"
  * @return Unique pointer to the selector
  */
 inline std::unique_ptr<NodeSelector> create_selector(const std::string& name) {
@@ -540,6 +885,8 @@ inline std::unique_ptr<NodeSelector> create_selector(const std::string& name) {
         return std::make_unique<BestEstimateSelector>();
     } else if (name == "hybrid" || name == "Hybrid") {
         return std::make_unique<HybridSelector>();
+    } else if (name == "work_stealing" || name == "WorkStealing") {
+        return std::make_unique<WorkStealingSelector>();
     }
     // Default to best-first
     return std::make_unique<BestFirstSelector>();
@@ -10,18 +10,21 @@
 
 #include "node.hpp"
 #include "node_pool.hpp"
+#include "node_index.hpp"
+#include "indexed_heap.hpp"
 
 #include <queue>
 #include <functional>
-#include <unordered_map>
+#include <algorithm>
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include <array>
 
 namespace openbp {
 
 /**
- * @brief Statistics about the B&P tree.
+ * @brief Statistics about the B&P tree (a snapshot, see BPTree::stats()).
  */
 struct TreeStats {
     int64_t nodes_created = 0;
@@ -32,6 +35,7 @@ struct TreeStats {
     int64_t nodes_branched = 0;
     int64_t nodes_open = 0;
     int64_t max_depth = 0;
+    int64_t nodes_released = 0;
     double best_lower_bound = -std::numeric_limits<double>::infinity();
     double best_upper_bound = std::numeric_limits<double>::infinity();
 
@@ -47,13 +51,68 @@ struct TreeStats {
     }
 };
 
+/**
+ * @brief Column-wise snapshot of all live nodes (see BPTree::node_table()).
+ *
+ * Entry k of every column describes the same node; rows are in
+ * ascending ID order.
+ */
+struct NodeTable {
+    std::vector<int64_t> id;
+    std::vector<int64_t> parent_id;
+    std::vector<int32_t> depth;
+    std::vector<double> lower_bound;
+    std::vector<double> lp_value;
+    std::vector<uint8_t> status;  // NodeStatus values
+
+    size_t size() const { return id.size(); }
+};
+
+/**
+ * @brief Receives notifications about open-node changes made by BPTree.
+ *
+ * Node selectors implement this interface so that nodes the tree closes
+ * (e.g. pruned after an incumbent improvement) or re-keys (lower bound
+ * updated) are handled in the same pass, without a full queue rescan.
+ */
+class TreeListener {
+public:
+    virtual ~TreeListener() = default;
+
+    /**
+     * @brief A pending node was closed by the tree without being selected.
+     */
+    virtual void on_node_closed(BPNode* node) { (void)node; }
+
+    /**
+     * @brief The lower bound of a node changed.
+     */
+    virtual void on_node_bound_changed(BPNode* node) { (void)node; }
+};
+
 /**
  * @brief The branch-and-price search tree.
  *
  * Manages node storage, open node queue, and tree statistics.
- * Designed for efficiency and thread-safety (for future parallel B&P).
+ *
+ * The tree is safe for many workers processing different nodes
+ * concurrently: node IDs come from an atomic counter, nodes are
+ * allocated from sharded pools (one per thread, up to NUM_POOL_SHARDS),
+ * the ID index is lock-free, and statistics and global bounds are
+ * atomics that can be read without locking. Structural updates (open
+ * node indexes, parent links, listeners, recycling) are serialised by a
+ * single tree mutex and are O(log n) each. A worker must own the nodes
+ * it modifies: claim one with begin_processing() before working on it.
+ *
+ * Open nodes (PENDING or PROCESSING) are additionally indexed by lower
+ * bound in both directions: the highest bounds first, so pruning after an
+ * incumbent improvement touches only the nodes that are actually cut off,
+ * and the lowest bound first, so the global lower bound and gap() are
+ * maintained incrementally and can be read in O(1). Lower-bound changes
+ * made directly on a node are picked up through the node's observer hook;
+ * status changes must go through the tree (mark_processed(), etc.).
  */
-class BPTree {
+class BPTree : private NodeObserver {
 public:
     using NodeId = BPNode::NodeId;
     using NodePtr = BPNode*;
@@ -67,23 +126,27 @@ public:
         : minimize_(minimize)
         , next_id_(0)
         , global_lower_bound_(-std::numeric_limits<double>::infinity())
+        , lower_bound_floor_(-std::numeric_limits<double>::infinity())
         , global_upper_bound_(std::numeric_limits<double>::infinity())
     {
-        // Create root node
-        root_ = node_pool_.allocate();
+        // Create root node (never recycled)
+        root_ = allocate_node();
         root_->set_id(next_id_++);
-        nodes_[root_->id()] = root_;
-        stats_.nodes_created = 1;
-        stats_.nodes_open = 1;
+        root_->pinned_ = true;
+        root_->observer_ = this;
+        nodes_.insert(root_->id(), root_);
+        add_open(root_);
+        counters_.nodes_created = 1;
+        counters_.nodes_open = 1;
     }
 
     // Non-copyable
     BPTree(const BPTree&) = delete;
     BPTree& operator=(const BPTree&) = delete;
 
-    // Movable
-    BPTree(BPTree&&) = default;
-    BPTree& operator=(BPTree&&) = default;
+    // Non-movable: nodes hold a back-pointer to their tree
+    BPTree(BPTree&&) = delete;
+    BPTree& operator=(BPTree&&) = delete;
 
     // Root access
     NodePtr root() { return root_; }
@@ -91,104 +154,189 @@ public:
     NodeId root_id() const { return root_ ? root_->id() : BPNode::INVALID_ID; }
 
     // Node access
-    NodePtr node(NodeId id) {
-        auto it = nodes_.find(id);
-        return (it != nodes_.end()) ? it->second : nullptr;
-    }
-
-    ConstNodePtr node(NodeId id) const {
-        auto it = nodes_.find(id);
-        return (it != nodes_.end()) ? it->second : nullptr;
-    }
-
-    bool has_node(NodeId id) const {
-        return nodes_.find(id) != nodes_.end();
-    }
+    NodePtr node(NodeId id) { return nodes_.find(id); }
+    ConstNodePtr node(NodeId id) const { return nodes_.find(id); }
+    bool has_node(NodeId id) const { return nodes_.contains(id); }
 
     size_t num_nodes() const { return nodes_.size(); }
 
     /**
      * @brief Create a child node from a branching decision.
+     *
+     * A child whose Ryan-Foster decisions contradict each other (see
+     * RyanFosterClosure) is created closed, as PRUNED_INFEASIBLE, and is
+     * never opened; selectors ignore it when it is added to them.
      * @param parent Parent node
      * @param decision The branching decision
      * @return Pointer to the new child node
      */
     NodePtr create_child(NodePtr parent, const BranchingDecision& decision) {
-        NodePtr child = node_pool_.allocate();
-        NodeId child_id = next_id_++;
+        NodeId child_id = next_id_.fetch_add(1, std::memory_order_relaxed);
+        uint8_t contradicted = 0;
+        check_ryan_foster(parent, &decision, 1, &contradicted);
 
-        // Initialize child
-        *child = BPNode(child_id, parent->id(), parent->depth() + 1, decision);
-
-        // Inherit parent's decisions
-        auto inherited = parent->all_decisions();
-        child->set_inherited_decisions(std::move(inherited));
+        // Initialize child, sharing the parent's decision path
+        NodePtr child = allocate_node(child_id, parent->id(), parent->depth() + 1,
+                                      parent->decision_path(), decision, parent, contradicted != 0);
+        const bool feasible = child->ryan_foster_feasible();
 
         // Initialize bounds from parent
-        child->set_lower_bound(parent->lower_bound());
+        child->store_lower_bound(parent->lower_bound());
         child->set_upper_bound(parent->upper_bound());
-
-        // Link to parent
-        parent->add_child(child_id);
+        child->observer_ = this;
 
         // Add to tree
-        nodes_[child_id] = child;
+        nodes_.insert(child_id, child);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (feasible) {
+                add_open(child);
+            } else {
+                child->set_status(NodeStatus::PRUNED_INFEASIBLE);
+            }
+
+            // Link to parent
+            parent->add_child(child_id);
+            parent->open_children_++;
+            if (!feasible) on_subtree_closed(child);
+        }
 
         // Update stats
-        stats_.nodes_created++;
-        stats_.nodes_open++;
-        if (child->depth() > stats_.max_depth) {
-            stats_.max_depth = child->depth();
+        counters_.nodes_created++;
+        if (feasible) {
+            counters_.nodes_open++;
+        } else {
+            counters_.nodes_pruned_infeasible++;
         }
+        raise_max_depth(child->depth());
 
         return child;
     }
 
     /**
      * @brief Create multiple children from branching (common case: binary branching).
+     *
+     * Builds all children in one batch: consecutive IDs from a single
+     * counter increment, one pool allocation, one index insertion and one
+     * pass under the tree lock that also closes the parent. Every child
+     * shares the parent's decision path and adds one link to it. Children
+     * with contradictory Ryan-Foster decisions are created closed, as in
+     * create_child().
      * @param parent Parent node
      * @param decisions Vector of branching decisions (one per child)
      * @return Vector of pointers to new child nodes
      */
     std::vector<NodePtr> create_children(NodePtr parent, const std::vector<BranchingDecision>& decisions) {
-        std::vector<NodePtr> children;
-        children.reserve(decisions.size());
+        const size_t count = decisions.size();
+        std::vector<NodePtr> children(count);
+
+        NodeId first_id = BPNode::INVALID_ID;
+        if (count > 0) {
+            first_id = next_id_.fetch_add(static_cast<NodeId>(count), std::memory_order_relaxed);
+            const NodeId parent_id = parent->id();
+            const int32_t depth = parent->depth() + 1;
+            const DecisionPath& inherited = parent->decision_path();
+            std::vector<uint8_t> contradicted(count, 0);
+            check_ryan_foster(parent, decisions.data(), count, contradicted.data());
+            allocate_nodes(count, children.data(), [&](void* storage, size_t k) {
+                return ::new (storage) BPNode(first_id + static_cast<NodeId>(k), parent_id, depth,
+                                              inherited, decisions[k], parent, contradicted[k] != 0);
+            });
+
+            for (NodePtr child : children) {
+                child->store_lower_bound(parent->lower_bound());
+                child->set_upper_bound(parent->upper_bound());
+                child->observer_ = this;
+            }
+            nodes_.insert_range(first_id, children.data(), count);
+        }
 
-        for (const auto& decision : decisions) {
-            children.push_back(create_child(parent, decision));
+        // Open the children and mark the parent as branched
+        size_t infeasible = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (NodePtr child : children) {
+                if (!child->ryan_foster_feasible()) {
+                    child->set_status(NodeStatus::PRUNED_INFEASIBLE);
+                    infeasible++;
+                    continue;
+                }
+                open_by_bound_.push(child);
+                open_by_lowest_.push(child);
+            }
+            if (count > 0) {
+                parent->add_children(first_id, count);
+                parent->open_children_ += static_cast<uint32_t>(count);
+            }
+            remove_open(parent);
+            parent->set_status(NodeStatus::BRANCHED);
+            if (count == 0) {
+                on_subtree_closed(parent);
+            }
+            for (size_t k = 0; infeasible > 0 && k < count; ++k) {
+                if (children[k]->status() == NodeStatus::PRUNED_INFEASIBLE) on_subtree_closed(children[k]);
+            }
+            refresh_lower_bound();
         }
 
-        // Mark parent as branched
-        parent->set_status(NodeStatus::BRANCHED);
-        stats_.nodes_branched++;
-        stats_.nodes_open--;  // Parent is no longer open
+        // Update stats (the parent is no longer open)
+        counters_.nodes_created += static_cast<int64_t>(count);
+        counters_.nodes_open += static_cast<int64_t>(count - infeasible) - 1;
+        counters_.nodes_pruned_infeasible += static_cast<int64_t>(infeasible);
+        counters_.nodes_branched++;
+        if (count > 0) raise_max_depth(parent->depth() + 1);
 
         return children;
     }
 
+    /**
+     * @brief Claim a pending node for processing (PENDING -> PROCESSING).
+     *
+     * Atomic with respect to prune_by_bound(), so concurrent workers never
+     * process a node that is being pruned, nor the same node twice.
+     * @return true if the caller now owns the node
+     */
+    bool begin_processing(NodePtr node) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (node->status() != NodeStatus::PENDING) return false;
+        node->set_status(NodeStatus::PROCESSING);
+        return true;
+    }
+
     /**
      * @brief Mark a node as processed and update statistics.
      */
     void mark_processed(NodePtr node, NodeStatus new_status) {
+        std::unique_lock<std::mutex> lock(mutex_);
         NodeStatus old_status = node->status();
         node->set_status(new_status);
 
+        if (old_status == NodeStatus::PENDING && new_status != NodeStatus::PROCESSING) {
+            notify_closed(node);
+        }
+
         if (old_status == NodeStatus::PENDING || old_status == NodeStatus::PROCESSING) {
-            stats_.nodes_processed++;
+            remove_open(node);
+            if (node->is_processed() && new_status != NodeStatus::BRANCHED) {
+                on_subtree_closed(node);
+            }
+            lock.unlock();
+            counters_.nodes_processed++;
             if (new_status != NodeStatus::BRANCHED) {
-                stats_.nodes_open--;
+                counters_.nodes_open--;
             }
         }
 
         switch (new_status) {
             case NodeStatus::PRUNED_BOUND:
-                stats_.nodes_pruned_bound++;
+                counters_.nodes_pruned_bound++;
                 break;
             case NodeStatus::PRUNED_INFEASIBLE:
-                stats_.nodes_pruned_infeasible++;
+                counters_.nodes_pruned_infeasible++;
                 break;
             case NodeStatus::INTEGER:
-                stats_.nodes_integer++;
+                counters_.nodes_integer++;
                 break;
             default:
                 break;
@@ -196,11 +344,63 @@ public:
     }
 
     // Bounds management
-    double global_lower_bound() const { return global_lower_bound_; }
-    double global_upper_bound() const { return global_upper_bound_; }
 
-    void set_global_lower_bound(double lb) { global_lower_bound_ = lb; }
-    void set_global_upper_bound(double ub) { global_upper_bound_ = ub; }
+    /**
+     * @brief Global lower (dual) bound, in O(1).
+     *
+     * The lowest lower bound among open nodes, or the global upper bound
+     * once no node is open. It never drops below a bound given to
+     * set_global_lower_bound(), and never exceeds the global upper bound
+     * (which tighten_upper_bound() may lower before the cache catches up).
+     */
+    double global_lower_bound() const {
+        return std::min(global_lower_bound_.load(std::memory_order_acquire), global_upper_bound());
+    }
+    double global_upper_bound() const { return global_upper_bound_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Set a floor for the global lower bound (e.g. a known valid bound).
+     */
+    void set_global_lower_bound(double lb) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lower_bound_floor_ = lb;
+        refresh_lower_bound();
+    }
+
+    void set_global_upper_bound(double ub) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        global_upper_bound_.store(ub, std::memory_order_release);
+        refresh_lower_bound();
+    }
+
+    /**
+     * @brief Lower the global upper bound without taking the tree lock.
+     *
+     * For bounds found elsewhere (another tree, a heuristic, see
+     * IncumbentRegister). The incumbent node is unchanged, and pruning is
+     * only flagged: the next prune_if_pending() prunes for all bounds
+     * received since the previous one in a single pass.
+     * @return true if @p ub improved the upper bound
+     */
+    bool tighten_upper_bound(double ub) {
+        if (!lower_upper_bound(ub)) return false;
+        prune_pending_.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Whether the upper bound improved since the last prune_by_bound().
+     */
+    bool prune_pending() const { return prune_pending_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Run prune_by_bound() if the upper bound improved since the last pass.
+     * @return Number of nodes pruned
+     */
+    int64_t prune_if_pending() {
+        if (!prune_pending()) return 0;
+        return prune_by_bound();
+    }
 
     bool is_minimizing() const { return minimize_; }
 
@@ -213,29 +413,34 @@ public:
         bool improved = false;
 
         // If integer solution found, update upper bound
-        if (node->is_integer() && node->lp_value() < global_upper_bound_) {
-            global_upper_bound_ = node->lp_value();
-            stats_.best_upper_bound = global_upper_bound_;
-            improved = true;
+        if (node->is_integer()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (lower_upper_bound(node->lp_value())) {
+                has_incumbent_bound_.store(true, std::memory_order_release);
+                prune_pending_.store(true, std::memory_order_release);
+                refresh_lower_bound();
+                improved = true;
+            }
         }
 
-        // Update lower bound from best open node
-        // (This is called by the solver after updating the open node queue)
-
+        // The lower bound is kept up to date as open nodes change
         return improved;
     }
 
     /**
-     * @brief Compute the global lower bound from open nodes.
+     * @brief Compute the lower bound over a subset of open nodes.
+     *
+     * O(size of the list); use global_lower_bound() for the bound over
+     * all open nodes.
      * @param open_node_ids IDs of currently open nodes
      * @return The minimum lower bound among open nodes
      */
     double compute_lower_bound(const std::vector<NodeId>& open_node_ids) const {
-        double lb = global_upper_bound_;
+        double lb = global_upper_bound();
         for (NodeId id : open_node_ids) {
-            auto it = nodes_.find(id);
-            if (it != nodes_.end() && it->second->can_be_explored()) {
-                lb = std::min(lb, it->second->lower_bound());
+            ConstNodePtr n = nodes_.find(id);
+            if (n && n->can_be_explored()) {
+                lb = std::min(lb, n->lower_bound());
             }
         }
         return lb;
@@ -243,74 +448,172 @@ public:
 
     /**
      * @brief Try to prune nodes by bound.
+     *
+     * Pops open nodes from the bound index while their lower bound
+     * reaches the global upper bound, so the cost is O(k log n) for k
+     * pruned nodes. Attached listeners are told about each pruned node
+     * in the same pass. Nodes currently being processed are left open.
      * @return Number of nodes pruned
      */
     int64_t prune_by_bound() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        prune_pending_.store(false, std::memory_order_relaxed);
         int64_t pruned = 0;
-        for (auto& [id, node] : nodes_) {
-            if (node->can_be_explored() && node->try_prune_by_bound(global_upper_bound_)) {
-                stats_.nodes_pruned_bound++;
-                stats_.nodes_open--;
-                pruned++;
+        const double cutoff = global_upper_bound() - PRUNE_TOLERANCE;
+        std::vector<NodePtr> processing;
+
+        while (!open_by_bound_.empty() && open_by_bound_.top()->lower_bound() >= cutoff) {
+            NodePtr node = open_by_bound_.pop();
+            if (node->status() == NodeStatus::PROCESSING) {
+                processing.push_back(node);
+                continue;
+            }
+            open_by_lowest_.remove(node);
+            if (!node->can_be_explored()) {
+                continue;  // Closed directly on the node, bypassing the tree
             }
+            node->set_status(NodeStatus::PRUNED_BOUND);
+            counters_.nodes_pruned_bound++;
+            counters_.nodes_open--;
+            pruned++;
+            notify_closed(node);
+            on_subtree_closed(node);
         }
+
+        for (NodePtr node : processing) {
+            open_by_bound_.push(node);
+        }
+        refresh_lower_bound();
         return pruned;
     }
 
     /**
-     * @brief Get all open node IDs.
+     * @brief Get all open (pending) node IDs, in ascending order.
      */
     std::vector<NodeId> get_open_nodes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
         std::vector<NodeId> open;
-        for (const auto& [id, node] : nodes_) {
+        open.reserve(open_by_bound_.size());
+        for (ConstNodePtr node : open_by_bound_.items()) {
             if (node->can_be_explored()) {
-                open.push_back(id);
+                open.push_back(node->id());
             }
         }
+        std::sort(open.begin(), open.end());
         return open;
     }
 
+    // Listeners
+
+    /**
+     * @brief Attach a listener (e.g. a node selector) to this tree.
+     *
+     * The listener must outlive the tree or be removed first. Listeners
+     * are called with the tree mutex held and must not call back into
+     * the tree.
+     */
+    void add_listener(TreeListener* listener) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (listener && std::find(listeners_.begin(), listeners_.end(), listener) == listeners_.end()) {
+            listeners_.push_back(listener);
+        }
+    }
+
+    void remove_listener(TreeListener* listener) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        listeners_.erase(std::remove(listeners_.begin(), listeners_.end(), listener), listeners_.end());
+    }
+
+    bool has_listener(const TreeListener* listener) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::find(listeners_.begin(), listeners_.end(), listener) != listeners_.end();
+    }
+
     /**
      * @brief Check if tree exploration is complete.
      */
     bool is_complete() const {
-        return stats_.nodes_open == 0;
+        return counters_.nodes_open.load(std::memory_order_acquire) == 0;
     }
 
     /**
-     * @brief Get current gap.
+     * @brief Get current gap, in O(1).
      */
     double gap() const {
-        if (global_upper_bound_ == std::numeric_limits<double>::infinity() ||
-            global_lower_bound_ == -std::numeric_limits<double>::infinity()) {
+        const double ub = global_upper_bound();
+        const double lb = global_lower_bound();
+        if (ub == std::numeric_limits<double>::infinity() ||
+            lb == -std::numeric_limits<double>::infinity()) {
             return std::numeric_limits<double>::infinity();
         }
-        if (std::abs(global_upper_bound_) < 1e-10) {
-            return (std::abs(global_lower_bound_) < 1e-10) ? 0.0 : std::numeric_limits<double>::infinity();
+        if (std::abs(ub) < 1e-10) {
+            return (std::abs(lb) < 1e-10) ? 0.0 : std::numeric_limits<double>::infinity();
         }
-        return (global_upper_bound_ - global_lower_bound_) / std::abs(global_upper_bound_);
+        return (ub - lb) / std::abs(ub);
     }
 
-    // Statistics
-    const TreeStats& stats() const { return stats_; }
-    TreeStats& stats() { return stats_; }
+    /**
+     * @brief Snapshot of the tree statistics (lock-free).
+     *
+     * Counters are read individually, so a snapshot taken while workers
+     * are running may mix values from slightly different moments.
+     */
+    TreeStats stats() const {
+        TreeStats s;
+        s.nodes_created = counters_.nodes_created.load(std::memory_order_relaxed);
+        s.nodes_processed = counters_.nodes_processed.load(std::memory_order_relaxed);
+        s.nodes_pruned_bound = counters_.nodes_pruned_bound.load(std::memory_order_relaxed);
+        s.nodes_pruned_infeasible = counters_.nodes_pruned_infeasible.load(std::memory_order_relaxed);
+        s.nodes_integer = counters_.nodes_integer.load(std::memory_order_relaxed);
+        s.nodes_branched = counters_.nodes_branched.load(std::memory_order_relaxed);
+        s.nodes_open = counters_.nodes_open.load(std::memory_order_relaxed);
+        s.max_depth = counters_.max_depth.load(std::memory_order_relaxed);
+        s.nodes_released = counters_.nodes_released.load(std::memory_order_relaxed);
+        s.best_lower_bound = global_lower_bound();
+        s.best_upper_bound = has_incumbent_bound_.load(std::memory_order_acquire)
+            ? global_upper_bound() : std::numeric_limits<double>::infinity();
+        return s;
+    }
 
     /**
-     * @brief Iterate over all nodes.
+     * @brief Iterate over all nodes in ascending ID order.
      * @param callback Function to call for each node
      */
     template<typename Func>
     void for_each_node(Func&& callback) {
-        for (auto& [id, node] : nodes_) {
-            callback(node);
-        }
+        nodes_.for_each([&](NodePtr node) { callback(node); });
     }
 
     template<typename Func>
     void for_each_node(Func&& callback) const {
-        for (const auto& [id, node] : nodes_) {
-            callback(node);
-        }
+        nodes_.for_each([&](ConstNodePtr node) { callback(node); });
+    }
+
+    /**
+     * @brief Export every live node as one row of a NodeTable.
+     *
+     * One pass over the ID index into flat columns, for analysing large
+     * trees without a per-node object. Bounds and statuses of nodes being
+     * processed concurrently may be mid-update.
+     */
+    NodeTable node_table() const {
+        NodeTable table;
+        const size_t n = nodes_.size();
+        table.id.reserve(n);
+        table.parent_id.reserve(n);
+        table.depth.reserve(n);
+        table.lower_bound.reserve(n);
+        table.lp_value.reserve(n);
+        table.status.reserve(n);
+        nodes_.for_each([&](ConstNodePtr node) {
+            table.id.push_back(node->id());
+            table.parent_id.push_back(node->parent_id());
+            table.depth.push_back(node->depth());
+            table.lower_bound.push_back(node->lower_bound());
+            table.lp_value.push_back(node->lp_value());
+            table.status.push_back(static_cast<uint8_t>(node->status()));
+        });
+        return table;
     }
 
     /**
@@ -324,9 +627,9 @@ public:
 
         while (current != BPNode::INVALID_ID) {
             path.push_back(current);
-            auto it = nodes_.find(current);
-            if (it == nodes_.end()) break;
-            current = it->second->parent_id();
+            ConstNodePtr n = nodes_.find(current);
+            if (!n) break;
+            current = n->parent_id();
         }
 
         std::reverse(path.begin(), path.end());
@@ -337,29 +640,338 @@ public:
      * @brief Get the incumbent (best integer solution) node.
      * @return Pointer to the incumbent node, or nullptr if none
      */
-    ConstNodePtr incumbent() const { return incumbent_; }
-    NodePtr incumbent() { return incumbent_; }
+    ConstNodePtr incumbent() const { return incumbent_.load(std::memory_order_acquire); }
+    NodePtr incumbent() { return incumbent_.load(std::memory_order_acquire); }
 
     void set_incumbent(NodePtr node) {
-        incumbent_ = node;
+        std::lock_guard<std::mutex> lock(mutex_);
+        NodePtr old = incumbent_.exchange(node, std::memory_order_acq_rel);
         if (node) {
-            global_upper_bound_ = node->lp_value();
-            stats_.best_upper_bound = global_upper_bound_;
+            global_upper_bound_.store(node->lp_value(), std::memory_order_release);
+            has_incumbent_bound_.store(true, std::memory_order_release);
+            refresh_lower_bound();
         }
+        update_incumbent_pins(old, node);
+    }
+
+    /**
+     * @brief Make @p node the incumbent if it improves the upper bound.
+     *
+     * Check and update happen atomically, so concurrent workers finding
+     * integer solutions keep the best one. Pruning is left to the caller
+     * (prune_by_bound() or prune_if_pending()).
+     * @return true if the node became the incumbent
+     */
+    bool update_incumbent(NodePtr node) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!node || !lower_upper_bound(node->lp_value())) return false;
+        NodePtr old = incumbent_.exchange(node, std::memory_order_acq_rel);
+        has_incumbent_bound_.store(true, std::memory_order_release);
+        prune_pending_.store(true, std::memory_order_release);
+        refresh_lower_bound();
+        update_incumbent_pins(old, node);
+        return true;
     }
 
+    // Node recycling
+
+    /**
+     * @brief Enable or disable node recycling.
+     *
+     * When enabled, nodes whose subtree is closed (pruned, infeasible,
+     * integer or fathomed, or branched with every child subtree closed)
+     * are queued and released by reclaim_closed_nodes(). Releasing a node
+     * destroys it (freeing its solution and child vectors and its share
+     * of the decision path), removes it from the index and recycles its
+     * pool slot. The root and the path from the root to the incumbent are
+     * never released. Nodes closed while recycling was off stay resident.
+     */
+    void set_node_recycling(bool enabled) { recycle_nodes_ = enabled; }
+    bool node_recycling() const { return recycle_nodes_; }
+
+    /**
+     * @brief Release all queued closed nodes.
+     *
+     * Pointers to released nodes become invalid. Selectors attached with
+     * add_listener() have already dropped pruned nodes; others must be
+     * pruned first (NodeSelector::prune()).
+     * @return Number of nodes released
+     */
+    size_t reclaim_closed_nodes() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t released = 0;
+        for (NodePtr node : reclaimable_) {
+            node->release_queued_ = false;
+            if (node->pinned_) continue;
+            nodes_.erase(node->id());
+            deallocate_node(node);
+            released++;
+        }
+        reclaimable_.clear();
+        counters_.nodes_released += static_cast<int64_t>(released);
+        return released;
+    }
+
+    /**
+     * @brief Number of closed nodes waiting for reclaim_closed_nodes().
+     */
+    size_t num_reclaimable() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return reclaimable_.size();
+    }
+
+    /**
+     * @brief Approximate memory held by node storage and the ID index.
+     */
+    size_t memory_usage() const {
+        size_t bytes = nodes_.memory_usage();
+        for (const PoolShard& shard : pools_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            bytes += shard.pool.memory_usage();
+        }
+        return bytes;
+    }
+
+    /// Number of node pool shards; threads are assigned round-robin.
+    static constexpr size_t NUM_POOL_SHARDS = 16;
+
+    /// Absolute tolerance of pruning by bound (same as BPNode::try_prune_by_bound).
+    static constexpr double PRUNE_TOLERANCE = 1e-6;
+
 private:
+
+    /**
+     * @brief A node pool with its own lock, padded to a cache line.
+     */
+    struct alignas(64) PoolShard {
+        mutable std::mutex mutex;
+        NodePool<BPNode> pool;
+    };
+
+    /**
+     * @brief Atomic counters behind TreeStats.
+     */
+    struct Counters {
+        std::atomic<int64_t> nodes_created{0};
+        std::atomic<int64_t> nodes_processed{0};
+        std::atomic<int64_t> nodes_pruned_bound{0};
+        std::atomic<int64_t> nodes_pruned_infeasible{0};
+        std::atomic<int64_t> nodes_integer{0};
+        std::atomic<int64_t> nodes_branched{0};
+        std::atomic<int64_t> nodes_open{0};
+        std::atomic<int64_t> max_depth{0};
+        std::atomic<int64_t> nodes_released{0};
+    };
+
+    /**
+     * @brief Pool shard of the calling thread (assigned on first use).
+     */
+    static uint16_t thread_shard() {
+        static std::atomic<uint16_t> next_shard{0};
+        thread_local uint16_t shard = static_cast<uint16_t>(
+            next_shard.fetch_add(1, std::memory_order_relaxed) % NUM_POOL_SHARDS);
+        return shard;
+    }
+
+    /**
+     * @brief Flag in @p out each of @p decisions that contradicts the
+     * Ryan-Foster decisions on @p parent's path. Leaves @p out untouched
+     * when none needs the parent's closure to tell (see
+     * BPNode::needs_closure).
+     */
+    void check_ryan_foster(NodePtr parent, const BranchingDecision* decisions, size_t count, uint8_t* out) {
+        for (size_t k = 0; k < count; ++k) {
+            if (BPNode::needs_closure(*parent, decisions[k])) {
+                parent->contradicted_decisions(nodes_.find(parent->parent_id()), decisions, count, out);
+                return;
+            }
+        }
+    }
+
+    template<typename... Args>
+    NodePtr allocate_node(Args&&... args) {
+        uint16_t shard = thread_shard();
+        NodePtr node;
+        {
+            std::lock_guard<std::mutex> lock(pools_[shard].mutex);
+            node = pools_[shard].pool.allocate(std::forward<Args>(args)...);
+        }
+        node->pool_shard_ = shard;
+        return node;
+    }
+
+    /**
+     * @brief Allocate @p count nodes from the calling thread's shard under one lock.
+     */
+    template<typename Construct>
+    void allocate_nodes(size_t count, NodePtr* out, Construct&& construct) {
+        uint16_t shard = thread_shard();
+        {
+            std::lock_guard<std::mutex> lock(pools_[shard].mutex);
+            pools_[shard].pool.allocate_batch(count, out, std::forward<Construct>(construct));
+        }
+        for (size_t k = 0; k < count; ++k) out[k]->pool_shard_ = shard;
+    }
+
+    void deallocate_node(NodePtr node) {
+        PoolShard& shard = pools_[node->pool_shard_];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.pool.deallocate(node);
+    }
+
+    /**
+     * @brief Max-heap ordering of open nodes by lower bound.
+     */
+    struct ByHighestBound {
+        bool operator()(const BPNode* a, const BPNode* b) const {
+            if (a->lower_bound() != b->lower_bound()) {
+                return a->lower_bound() > b->lower_bound();
+            }
+            return a->id() < b->id();
+        }
+    };
+
+    /**
+     * @brief Min-heap ordering of open nodes by lower bound.
+     */
+    struct ByLowestBound {
+        bool operator()(const BPNode* a, const BPNode* b) const {
+            if (a->lower_bound() != b->lower_bound()) {
+                return a->lower_bound() < b->lower_bound();
+            }
+            return a->id() < b->id();
+        }
+    };
+
+    void raise_max_depth(int64_t depth) {
+        int64_t max_depth = counters_.max_depth.load(std::memory_order_relaxed);
+        while (depth > max_depth &&
+               !counters_.max_depth.compare_exchange_weak(max_depth, depth, std::memory_order_relaxed)) {}
+    }
+
+    void add_open(NodePtr node) {
+        open_by_bound_.push(node);
+        open_by_lowest_.push(node);
+        refresh_lower_bound();
+    }
+
+    void remove_open(NodePtr node) {
+        open_by_bound_.remove(node);
+        if (open_by_lowest_.remove(node)) refresh_lower_bound();
+    }
+
+    /**
+     * @brief Recompute the cached global lower bound from the min-heap top.
+     *
+     * Caller holds mutex_ (as for all helpers below that touch the open
+     * node indexes, parent links or the reclaim queue).
+     */
+    void refresh_lower_bound() {
+        double lb = open_by_lowest_.empty() ? global_upper_bound()
+                                            : open_by_lowest_.top()->lower_bound();
+        global_lower_bound_.store(std::max(lb, lower_bound_floor_), std::memory_order_release);
+    }
+
+    /**
+     * @brief Atomically lower the upper bound to @p ub if it is better.
+     *
+     * Lock-free, so tighten_upper_bound() never races with incumbent
+     * updates made under mutex_ into raising the bound again.
+     */
+    bool lower_upper_bound(double ub) {
+        double current = global_upper_bound_.load(std::memory_order_acquire);
+        while (ub < current) {
+            if (global_upper_bound_.compare_exchange_weak(current, ub, std::memory_order_acq_rel,
+                                                          std::memory_order_acquire)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void update_lower_bound(BPNode* node, double lb) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        node->store_lower_bound(lb);
+        open_by_bound_.update(node);
+        if (open_by_lowest_.update(node)) refresh_lower_bound();
+        for (TreeListener* listener : listeners_) {
+            listener->on_node_bound_changed(node);
+        }
+    }
+
+    void notify_closed(NodePtr node) {
+        for (TreeListener* listener : listeners_) {
+            listener->on_node_closed(node);
+        }
+    }
+
+    static bool is_subtree_closed(ConstNodePtr node) {
+        if (node->status() == NodeStatus::BRANCHED) {
+            return node->num_open_children() == 0;
+        }
+        return node->is_processed();
+    }
+
+    void queue_release(NodePtr node) {
+        if (recycle_nodes_ && !node->pinned_ && !node->release_queued_) {
+            node->release_queued_ = true;
+            reclaimable_.push_back(node);
+        }
+    }
+
+    /**
+     * @brief Propagate the closing of @p node's subtree to its ancestors.
+     */
+    void on_subtree_closed(NodePtr node) {
+        while (node) {
+            queue_release(node);
+            NodePtr parent = nodes_.find(node->parent_id());
+            if (!parent || parent->open_children_ == 0) break;
+            parent->open_children_--;
+            if (parent->open_children_ > 0 || parent->status() != NodeStatus::BRANCHED) break;
+            node = parent;
+        }
+    }
+
+    /**
+     * @brief Move the recycling pins from the old incumbent path to the new one.
+     */
+    void update_incumbent_pins(NodePtr old_incumbent, NodePtr new_incumbent) {
+        if (old_incumbent == new_incumbent) return;
+        for (NodePtr n = old_incumbent; n; n = nodes_.find(n->parent_id())) {
+            if (n != root_) n->pinned_ = false;
+        }
+        for (NodePtr n = new_incumbent; n; n = nodes_.find(n->parent_id())) {
+            n->pinned_ = true;
+        }
+        for (NodePtr n = old_incumbent; n; n = nodes_.find(n->parent_id())) {
+            if (!n->pinned_ && is_subtree_closed(n)) queue_release(n);
+        }
+    }
+
     bool minimize_;
-    NodePool<BPNode> node_pool_;
-    std::unordered_map<NodeId, NodePtr> nodes_;
+    std::array<PoolShard, NUM_POOL_SHARDS> pools_;
+    NodeIndex<BPNode> nodes_;
     NodePtr root_ = nullptr;
-    NodePtr incumbent_ = nullptr;
-    int64_t next_id_;
+    std::atomic<NodePtr> incumbent_{nullptr};
+    std::atomic<int64_t> next_id_;
+
+    mutable std::mutex mutex_;  // Guards everything below except the atomics
+
+    bool recycle_nodes_ = false;
+    std::vector<NodePtr> reclaimable_;
+
+    IndexedHeap<ByHighestBound> open_by_bound_;  // Open nodes, highest bound on top
+    IndexedHeap<ByLowestBound> open_by_lowest_;  // Same nodes, lowest bound on top
+    std::vector<TreeListener*> listeners_;
 
-    double global_lower_bound_;
-    double global_upper_bound_;
+    std::atomic<double> global_lower_bound_;  // Cached: max(lowest open bound, floor)
+    double lower_bound_floor_;
+    std::atomic<double> global_upper_bound_;
+    std::atomic<bool> has_incumbent_bound_{false};
+    std::atomic<bool> prune_pending_{false};  // Upper bound improved since last prune
 
-    TreeStats stats_;
+    Counters counters_;
 };
 
 }  // namespace openbp
@@ -0,0 +1,170 @@
+/**
+ * @file test_column_filter.cpp
+ * @brief Tests for ColumnFilter.
+ */
+
+#include "core/column_filter.hpp"
+#include "core/tree.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace openbp;
+
+namespace {
+
+/// Decision-by-decision reference check (the Python filter semantics)
+bool satisfies(const std::vector<int32_t>& items, const std::vector<int32_t>& arcs,
+               const std::vector<BranchingDecision>& decisions) {
+    auto has = [](const std::vector<int32_t>& v, int32_t x) {
+        return std::find(v.begin(), v.end(), x) != v.end();
+    };
+    for (const auto& d : decisions) {
+        if (d.type() == BranchType::RYAN_FOSTER) {
+            bool has_i = has(items, d.item_i()), has_j = has(items, d.item_j());
+            if (d.same_column() ? has_i != has_j : has_i && has_j) return false;
+        } else if (d.type() == BranchType::ARC && d.source_node() < 0) {
+            if (has(arcs, d.arc_index()) != d.arc_required()) return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+void test_ryan_foster_filter() {
+    std::cout << "Testing ColumnFilter Ryan-Foster decisions..." << std::endl;
+
+    ColumnPool pool(10);
+    pool.add(1.0, {0, 1});     // 0: both
+    pool.add(1.0, {0});        // 1: only 0
+    pool.add(1.0, {1, 2});     // 2: only 1
+    pool.add(1.0, {2, 3});     // 3: neither
+
+    ColumnFilter same({BranchingDecision::ryan_foster(0, 1, true)});
+    assert(same.num_tests() == 1);
+    assert((same.indices(pool) == std::vector<int64_t>{0, 3}));
+
+    ColumnFilter diff({BranchingDecision::ryan_foster(0, 1, false)});
+    assert((diff.mask(pool) == std::vector<uint8_t>{0, 1, 1, 1}));
+    assert(!diff.accepts(pool, 0) && diff.accepts(pool, 1));
+
+    // Items beyond the pool's width are covered by no column
+    ColumnFilter outside({BranchingDecision::ryan_foster(2, 50, true),
+                          BranchingDecision::ryan_foster(0, 60, false)});
+    assert((outside.indices(pool) == std::vector<int64_t>{0, 1}));
+
+    // Non-column decisions are ignored
+    ColumnFilter none({BranchingDecision::variable_branch(3, 0.5, true)});
+    assert(none.empty());
+    assert(none.indices(pool).size() == pool.size());
+
+    // begin offsets the mask
+    assert((same.mask(pool, 2) == std::vector<uint8_t>{0, 1}));
+    assert((same.indices(pool, 2) == std::vector<int64_t>{3}));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_arc_filter() {
+    std::cout << "Testing ColumnFilter arc decisions..." << std::endl;
+
+    ColumnPool pool;
+    pool.add(1.0, {0}, {1, 2, 3});
+    pool.add(1.0, {1}, {2, 4});
+    pool.add(1.0, {2}, {5});
+
+    ColumnFilter required({BranchingDecision::arc_branch(2, -1, true)});
+    assert((required.indices(pool) == std::vector<int64_t>{0, 1}));
+
+    ColumnFilter forbidden({BranchingDecision::arc_branch(2, -1, true),
+                            BranchingDecision::arc_branch(4, -1, false)});
+    assert((forbidden.indices(pool) == std::vector<int64_t>{0}));
+
+    // Source-specific arc decisions are left to the caller
+    ColumnFilter sourced({BranchingDecision::arc_branch(2, 7, true)});
+    assert(sourced.num_skipped() == 1 && sourced.empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_random_against_reference() {
+    std::cout << "Testing ColumnFilter against reference (scalar and SIMD)..." << std::endl;
+
+    std::mt19937 rng(5);
+    for (int32_t num_items : {20, 130, 700}) {
+        std::uniform_int_distribution<int32_t> item(0, num_items - 1);
+        std::uniform_int_distribution<int32_t> arc(0, 30);
+
+        ColumnPool pool(num_items);
+        std::vector<std::vector<int32_t>> items, arcs;
+        for (int k = 0; k < 3000; ++k) {
+            std::vector<int32_t> cover(1 + k % 6), path(k % 4);
+            for (auto& i : cover) i = item(rng);
+            for (auto& a : path) a = arc(rng);
+            if (pool.add(1.0, cover, path).inserted) {
+                items.push_back(cover);
+                arcs.push_back(path);
+            }
+        }
+
+        // Few decisions: sparse program; many: dense (AVX2 screen)
+        for (int num_decisions : {3, 40, 400}) {
+            std::vector<BranchingDecision> decisions;
+            for (int k = 0; k < num_decisions; ++k) {
+                decisions.push_back(BranchingDecision::ryan_foster(item(rng), item(rng), k % 3 == 0));
+            }
+            decisions.push_back(BranchingDecision::arc_branch(arc(rng), -1, false));
+
+            ColumnFilter filter(decisions);
+            auto simd = filter.mask(pool);
+            filter.set_use_simd(false);
+            auto scalar = filter.mask(pool);
+            assert(simd == scalar);
+            for (size_t c = 0; c < pool.size(); ++c) {
+                assert((scalar[c] != 0) == satisfies(items[c], arcs[c], decisions));
+            }
+        }
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_refine_and_node() {
+    std::cout << "Testing ColumnFilter::refine and for_node..." << std::endl;
+
+    ColumnPool pool(10);
+    pool.add(1.0, {0, 1});
+    pool.add(1.0, {0, 2});
+    pool.add(1.0, {3});
+
+    BPTree tree;
+    auto* child = tree.create_child(tree.root(), BranchingDecision::ryan_foster(0, 1, false));
+    auto* grandchild = tree.create_child(child, BranchingDecision::ryan_foster(0, 2, true));
+
+    auto filter = ColumnFilter::for_node(*grandchild);
+    assert(filter.num_tests() == 2);
+    assert((filter.indices(pool) == std::vector<int64_t>{1, 2}));
+
+    // Entries already cleared are not re-enabled
+    std::vector<uint8_t> mask = {1, 1, 0};
+    filter.refine(pool, mask.data(), 0, pool.size());
+    assert((mask == std::vector<uint8_t>{0, 1, 0}));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "=== ColumnFilter Tests ===" << std::endl;
+    std::cout << "AVX2 available: " << (ColumnFilter::simd_available() ? "yes" : "no") << std::endl;
+
+    test_ryan_foster_filter();
+    test_arc_filter();
+    test_random_against_reference();
+    test_refine_and_node();
+
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
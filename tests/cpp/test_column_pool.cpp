@@ -0,0 +1,141 @@
+/**
+ * @file test_column_pool.cpp
+ * @brief Tests for ColumnPool.
+ */
+
+#include "core/column_pool.hpp"
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace openbp;
+
+void test_add_and_dedupe() {
+    std::cout << "Testing ColumnPool add/dedupe..." << std::endl;
+
+    ColumnPool pool(10);
+    assert(pool.empty());
+    assert(pool.words_per_column() == 1);
+
+    auto first = pool.add(5.0, {3, 1, 7});
+    assert(first.inserted && first.index == 0);
+
+    // Same coverage in another order (and with a repeat) is a duplicate
+    auto again = pool.add(9.0, {7, 3, 1, 3});
+    assert(!again.inserted && again.index == 0);
+    assert(pool.cost(0) == 5.0);
+
+    // Same coverage, different arcs: distinct column
+    auto with_arcs = pool.add(6.0, {1, 3, 7}, {4, 2});
+    assert(with_arcs.inserted && with_arcs.index == 1);
+    assert(!pool.add(6.0, {1, 3, 7}, {4, 2}).inserted);
+    // Arc order matters
+    assert(pool.add(6.0, {1, 3, 7}, {2, 4}).inserted);
+
+    assert(pool.size() == 3);
+    assert(pool.find({1, 3, 7}) == 0);
+    assert(pool.find({1, 3, 7}, {4, 2}) == 1);
+    assert(pool.find({1, 3}) == -1);
+    assert(pool.find({100}) == -1);
+    assert(pool.contains({7, 1, 3}));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_columnar_layout() {
+    std::cout << "Testing ColumnPool columnar layout..." << std::endl;
+
+    ColumnPool pool(70);
+    assert(pool.words_per_column() == 2);
+    pool.add(1.0, {0, 65}, {10, 11, 12});
+    pool.add(2.0, {64});
+    pool.add(3.0, {2, 3}, {13});
+
+    assert((pool.costs() == std::vector<double>{1.0, 2.0, 3.0}));
+    assert((pool.arc_offsets() == std::vector<int64_t>{0, 3, 3, 4}));
+    assert((pool.arc_data() == std::vector<int32_t>{10, 11, 12, 13}));
+    assert(pool.coverage_data().size() == 6);
+
+    const auto* row = pool.coverage(0);
+    assert(row[0] == 1u && row[1] == 2u);
+    assert((pool.items(0) == std::vector<int32_t>{0, 65}));
+    assert((pool.arcs(0) == std::vector<int32_t>{10, 11, 12}));
+    assert(pool.num_arcs(1) == 0);
+    assert(pool.covers(1, 64) && !pool.covers(1, 0) && !pool.covers(1, 500));
+
+    bool threw = false;
+    try {
+        pool.add(1.0, {-1});
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(pool.size() == 3);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_widening() {
+    std::cout << "Testing ColumnPool coverage widening..." << std::endl;
+
+    ColumnPool pool;  // No width hint
+    assert(pool.num_items() == 0 && pool.words_per_column() == 0);
+
+    pool.add(1.0, {5});
+    pool.add(2.0, {});
+    assert(pool.words_per_column() == 1);
+
+    // Widening re-lays rows out but keeps hashes valid
+    pool.add(3.0, {200, 5});
+    assert(pool.num_items() == 201);
+    assert(pool.words_per_column() >= 4);
+    assert((pool.items(0) == std::vector<int32_t>{5}));
+    assert((pool.items(2) == std::vector<int32_t>{5, 200}));
+    assert(pool.items(1).empty());
+    assert(!pool.add(1.0, {5}).inserted);
+    assert(!pool.add(2.0, {}).inserted);
+    assert(pool.find({5, 200}) == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_many_columns() {
+    std::cout << "Testing ColumnPool with many columns..." << std::endl;
+
+    ColumnPool pool(500);
+    const int n = 20000;
+    for (int k = 0; k < n; ++k) {
+        std::vector<int32_t> items = {k % 500, (k / 500) % 500, (k * 7) % 500};
+        pool.add(static_cast<double>(k), items, {k});
+    }
+    assert(pool.size() == static_cast<size_t>(n));
+
+    // Every column is found again; re-adding inserts nothing
+    for (int k = 0; k < n; k += 97) {
+        std::vector<int32_t> items = {k % 500, (k / 500) % 500, (k * 7) % 500};
+        assert(pool.find(items, {k}) == k);
+        assert(!pool.add(0.0, items, {k}).inserted);
+    }
+    assert(pool.size() == static_cast<size_t>(n));
+    assert(pool.memory_usage() > 0);
+
+    pool.clear();
+    assert(pool.empty());
+    assert(pool.find({0}) == -1);
+    assert(pool.add(1.0, {0}).index == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "=== ColumnPool Tests ===" << std::endl;
+
+    test_add_and_dedupe();
+    test_columnar_layout();
+    test_widening();
+    test_many_columns();
+
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
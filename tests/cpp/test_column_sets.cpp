@@ -0,0 +1,144 @@
+/**
+ * @file test_column_sets.cpp
+ * @brief Tests for ColumnSet and NodeColumnSets.
+ */
+
+#include "core/column_sets.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace openbp;
+
+void test_column_set_forms() {
+    std::cout << "Testing ColumnSet sparse and bitmap forms..." << std::endl;
+
+    ColumnSet sparse({3, 70, 900}, 1000);
+    assert(!sparse.is_bitmap());
+    assert(sparse.count() == 3 && sparse.limit() == 1000);
+    assert(sparse.contains(70) && !sparse.contains(71) && !sparse.contains(5000));
+    assert((sparse.indices() == std::vector<int64_t>{3, 70, 900}));
+
+    std::vector<uint32_t> many;
+    for (uint32_t c = 0; c < 1000; c += 3) many.push_back(c);
+    ColumnSet dense(many, 1000);
+    assert(dense.is_bitmap());
+    assert(dense.count() == many.size());
+    assert(dense.contains(999) && !dense.contains(998));
+    auto back = dense.indices();
+    assert(back.size() == many.size() && back.front() == 0 && back.back() == 999);
+    assert(dense.memory_usage() < sparse.memory_usage() + many.size() * sizeof(uint32_t));
+
+    // Editing keeps the bitmap while dense and falls back to a list when sparse
+    auto grown = ColumnSet::edited(dense, {0, 3}, {1000, 1001}, 1002);
+    assert(grown.is_bitmap() && grown.count() == many.size() && grown.limit() == 1002);
+    assert(!grown.contains(0) && grown.contains(6) && grown.contains(1001));
+    auto shrunk = ColumnSet::edited(dense, std::vector<uint32_t>(many.begin(), many.end() - 1), {}, 1000);
+    assert(!shrunk.is_bitmap() && (shrunk.indices() == std::vector<int64_t>{999}));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_incremental_matches_full() {
+    std::cout << "Testing NodeColumnSets against full filtering..." << std::endl;
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int32_t> item(0, 59);
+    ColumnPool pool(60);
+    auto add_columns = [&](int n) {
+        for (int k = 0; k < n; ++k) {
+            std::vector<int32_t> cover(2 + k % 5);
+            for (auto& i : cover) i = item(rng);
+            pool.add(1.0, cover, {k % 7});
+        }
+    };
+    add_columns(2000);
+
+    BPTree tree;
+    NodeColumnSets sets(pool);
+    tree.add_listener(&sets);
+
+    auto root_set = sets.get(*tree.root());
+    assert(root_set->count() == pool.size());
+
+    // Dive: branch, add columns between levels, and compare every child
+    BPNode* node = tree.root();
+    for (int depth = 0; depth < 8; ++depth) {
+        // Every third level branches on an arc, which rescans the parent's set
+        int32_t i = item(rng), j = item(rng);
+        auto children = depth % 3 == 2
+            ? tree.create_children(node, {BranchingDecision::arc_branch(i % 7, -1, true),
+                                          BranchingDecision::arc_branch(i % 7, -1, false)})
+            : tree.create_children(node, {BranchingDecision::ryan_foster(i, j, true),
+                                          BranchingDecision::ryan_foster(i, j, false)});
+        sets.branch(*node, children);
+        assert(!sets.is_cached(node->id()));
+        assert(sets.is_cached(children[0]->id()) && sets.is_cached(children[1]->id()));
+
+        add_columns(300);
+        for (BPNode* child : children) {
+            auto incremental = sets.get(*child)->indices();
+            auto full = ColumnFilter::for_node(*child).indices(pool);
+            assert(incremental == full);
+            assert(sets.get(*child)->limit() == pool.size());
+        }
+
+        // The parent's set is gone: a fresh get() falls back to full filtering
+        assert((sets.get(*node)->indices() == ColumnFilter::for_node(*node).indices(pool)));
+        sets.release(node->id());
+
+        node = children[depth % 2];
+    }
+
+    tree.remove_listener(&sets);
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_release_on_prune() {
+    std::cout << "Testing NodeColumnSets drops pruned nodes..." << std::endl;
+
+    ColumnPool pool(4);
+    pool.add(1.0, {0, 1});
+    pool.add(1.0, {2});
+
+    BPTree tree;
+    NodeColumnSets sets(pool);
+    tree.add_listener(&sets);
+
+    auto children = tree.create_children(tree.root(), {BranchingDecision::ryan_foster(0, 1, true),
+                                                       BranchingDecision::ryan_foster(0, 1, false)});
+    sets.branch(*tree.root(), children);
+    assert(sets.size() == 2);
+    assert(sets.memory_usage() > 0);
+
+    children[0]->set_lower_bound(10.0);
+    children[1]->set_lower_bound(1.0);
+    tree.update_bounds(children[0]);
+    tree.update_bounds(children[1]);
+    tree.tighten_upper_bound(5.0);
+    tree.prune_by_bound();
+
+    assert(!sets.is_cached(children[0]->id()));
+    assert(sets.is_cached(children[1]->id()));
+    assert((sets.get(*children[1])->indices() == std::vector<int64_t>{1}));
+
+    // A handed-out set survives eviction
+    auto held = sets.get(*children[1]);
+    sets.clear();
+    assert(sets.size() == 0 && held->count() == 1);
+
+    tree.remove_listener(&sets);
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "=== NodeColumnSets Tests ===" << std::endl;
+
+    test_column_set_forms();
+    test_incremental_matches_full();
+    test_release_on_prune();
+
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file test_concurrent_tree.cpp
+ * @brief Stress tests for BPTree under concurrent workers.
+ */
+
+#include "core/tree.hpp"
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace openbp;
+
+namespace {
+
+constexpr int NUM_THREADS = 16;
+constexpr int64_t NODES_PER_THREAD = 1 << 17;  // ~2.1M nodes in total
+
+/**
+ * @brief Worker: claims random nodes from its own frontier, branches
+ * them until its creation budget is spent, then closes the rest.
+ * Occasionally reports an "integer" node, which tightens the shared
+ * incumbent and prunes nodes owned by other workers.
+ */
+void worker(BPTree& tree, BPNode* start, unsigned seed, int64_t& created) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> bound(0.0, 1000.0);
+    std::vector<BPNode*> stack = {start};
+
+    while (!stack.empty()) {
+        std::swap(stack[rng() % stack.size()], stack.back());
+        BPNode* node = stack.back();
+        stack.pop_back();
+        if (!tree.begin_processing(node)) continue;  // Pruned by another worker
+
+        node->set_lower_bound(node->lower_bound() + bound(rng) * 0.05);
+
+        if (created < NODES_PER_THREAD) {
+            int32_t var = static_cast<int32_t>(node->id() & 0x7fffffff);
+            auto children = tree.create_children(node, {
+                BranchingDecision::variable_branch(var, 0.5, true),
+                BranchingDecision::variable_branch(var, 0.5, false),
+            });
+            created += 2;
+            stack.insert(stack.end(), children.begin(), children.end());
+        } else if (rng() % 4096 == 0) {
+            node->set_lp_value(node->lower_bound() + bound(rng) * 0.5);
+            node->set_is_integer(true);
+            tree.mark_processed(node, NodeStatus::INTEGER);
+            tree.update_bounds(node);
+            tree.prune_by_bound();
+        } else {
+            tree.mark_processed(node, (rng() & 1) ? NodeStatus::FATHOMED
+                                                  : NodeStatus::PRUNED_INFEASIBLE);
+        }
+    }
+}
+
+}  // namespace
+
+void test_concurrent_create_and_close() {
+    std::cout << "Testing concurrent create/close from " << NUM_THREADS
+              << " threads..." << std::endl;
+
+    BPTree tree;
+    std::vector<BranchingDecision> decisions;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        decisions.push_back(BranchingDecision::variable_branch(t, 0.5, true));
+    }
+    tree.root()->set_lower_bound(0.0);
+    auto starts = tree.create_children(tree.root(), decisions);
+
+    std::vector<int64_t> created(NUM_THREADS, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back(worker, std::ref(tree), starts[t], 1234u + t, std::ref(created[t]));
+    }
+
+    // Lock-free readers running alongside the workers
+    std::thread reader([&] {
+        for (int k = 0; k < 2000; ++k) {
+            TreeStats s = tree.stats();
+            assert(s.nodes_created >= 1 + NUM_THREADS);
+            assert(tree.global_lower_bound() <= tree.global_upper_bound());
+            BPNode* node = tree.node(static_cast<BPNode::NodeId>(k));
+            if (node) assert(node->id() == k);
+            (void)tree.gap();
+        }
+    });
+
+    for (auto& th : threads) th.join();
+    reader.join();
+
+    // IDs are unique and dense, and every node is indexed
+    int64_t total_created = 1 + NUM_THREADS;
+    for (int64_t c : created) total_created += c;
+    TreeStats stats = tree.stats();
+    assert(stats.nodes_created == total_created);
+    assert(static_cast<int64_t>(tree.num_nodes()) == total_created);
+
+    BPNode::NodeId expected = 0;
+    int64_t open = 0;
+    tree.for_each_node([&](BPNode* node) {
+        assert(node->id() == expected);
+        expected++;
+        if (node->status() == NodeStatus::PENDING || node->status() == NodeStatus::PROCESSING) open++;
+        if (node->id() != tree.root_id()) {
+            const BPNode* parent = tree.node(node->parent_id());
+            assert(parent && parent->status() == NodeStatus::BRANCHED);
+            assert(parent->depth() + 1 == node->depth());
+        }
+    });
+    assert(expected == total_created);
+
+    // Everything is closed, and the counters agree
+    assert(open == 0);
+    assert(stats.nodes_open == 0);
+    assert(tree.is_complete());
+    assert(tree.get_open_nodes().empty());
+    assert(stats.nodes_branched == (total_created - 1 - NUM_THREADS) / 2 + 1);
+    assert(tree.incumbent() == nullptr);  // Bounds only, no incumbent node set
+    assert(tree.global_upper_bound() < std::numeric_limits<double>::infinity());
+    assert(tree.global_lower_bound() == tree.global_upper_bound());
+
+    std::cout << "  " << total_created << " nodes, " << stats.nodes_pruned_bound
+              << " pruned by bound" << std::endl;
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_concurrent_claims() {
+    std::cout << "Testing concurrent begin_processing claims..." << std::endl;
+
+    BPTree tree;
+    std::vector<BranchingDecision> decisions;
+    for (int k = 0; k < 10000; ++k) {
+        decisions.push_back(BranchingDecision::variable_branch(k, 0.5, true));
+    }
+    auto nodes = tree.create_children(tree.root(), decisions);
+
+    // All threads race for every node: each is claimed exactly once
+    std::vector<std::vector<BPNode*>> claimed(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (BPNode* node : nodes) {
+                if (tree.begin_processing(node)) claimed[t].push_back(node);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    size_t total = 0;
+    for (const auto& list : claimed) total += list.size();
+    assert(total == nodes.size());
+    for (BPNode* node : nodes) assert(node->status() == NodeStatus::PROCESSING);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_concurrent_ryan_foster() {
+    std::cout << "Testing concurrent Ryan-Foster branching..." << std::endl;
+
+    // Workers branch sibling subtrees below shared ancestors, so closures
+    // are taken over, copied and rebuilt concurrently; readers query the
+    // shared ancestors' closures at the same time
+    BPTree tree;
+    auto top = tree.create_children(tree.root(), {BranchingDecision::ryan_foster(0, 1, true),
+                                                  BranchingDecision::ryan_foster(0, 1, false)});
+    auto starts = tree.create_children(top[0], {BranchingDecision::ryan_foster(1, 2, true),
+                                                BranchingDecision::ryan_foster(1, 2, false)});
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(NUM_THREADS, 0);
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 rng(static_cast<unsigned>(t) + 1);
+            std::uniform_int_distribution<int32_t> item(0, 15);
+            BPNode* node = starts[static_cast<size_t>(t) % starts.size()];
+            for (int step = 0; step < 400; ++step) {
+                auto children = tree.create_children(node, {
+                    BranchingDecision::ryan_foster(item(rng), item(rng), true),
+                    BranchingDecision::ryan_foster(item(rng), item(rng), false),
+                });
+                if (top[0]->ryan_foster_closure()->together(0, 1) == false) mismatches[t]++;
+                BPNode* next = nullptr;
+                for (BPNode* child : children) {
+                    if (child->ryan_foster_feasible() !=
+                        RyanFosterClosure(child->all_decisions()).feasible()) {
+                        mismatches[t]++;
+                    }
+                    if (child->ryan_foster_feasible()) next = child;
+                }
+                node = next ? next : starts[rng() % starts.size()];
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (int m : mismatches) assert(m == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Concurrent BPTree Tests ===" << std::endl;
+
+    test_concurrent_claims();
+    test_concurrent_create_and_close();
+    test_concurrent_ryan_foster();
+
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
@@ -7,6 +7,7 @@
 #include <cassert>
 #include <iostream>
 #include <cmath>
+#include <type_traits>
 
 using namespace openbp;
 
@@ -15,31 +16,83 @@ void test_branching_decision() {
 
     // Variable branching
     auto d1 = BranchingDecision::variable_branch(5, 2.5, true);
-    assert(d1.type == BranchType::VARIABLE);
-    assert(d1.variable_index == 5);
-    assert(std::abs(d1.bound_value - 2.5) < 1e-9);
-    assert(d1.is_upper_bound == true);
+    assert(d1.type() == BranchType::VARIABLE);
+    assert(d1.variable_index() == 5);
+    assert(std::abs(d1.bound_value() - 2.5) < 1e-9);
+    assert(d1.is_upper_bound() == true);
 
     // Ryan-Foster
     auto d2 = BranchingDecision::ryan_foster(1, 5, true);
-    assert(d2.type == BranchType::RYAN_FOSTER);
-    assert(d2.item_i == 1);
-    assert(d2.item_j == 5);
-    assert(d2.same_column == true);
+    assert(d2.type() == BranchType::RYAN_FOSTER);
+    assert(d2.item_i() == 1);
+    assert(d2.item_j() == 5);
+    assert(d2.same_column() == true);
 
     // Arc branching
     auto d3 = BranchingDecision::arc_branch(10, 0, true);
-    assert(d3.type == BranchType::ARC);
-    assert(d3.arc_index == 10);
-    assert(d3.source_node == 0);
-    assert(d3.arc_required == true);
+    assert(d3.type() == BranchType::ARC);
+    assert(d3.arc_index() == 10);
+    assert(d3.source_node() == 0);
+    assert(d3.arc_required() == true);
 
     // Resource branching
     auto d4 = BranchingDecision::resource_branch(0, 5.0, 10.0);
-    assert(d4.type == BranchType::RESOURCE);
-    assert(d4.resource_index == 0);
-    assert(std::abs(d4.lower_bound - 5.0) < 1e-9);
-    assert(std::abs(d4.upper_bound - 10.0) < 1e-9);
+    assert(d4.type() == BranchType::RESOURCE);
+    assert(d4.resource_index() == 0);
+    assert(std::abs(d4.lower_bound() - 5.0) < 1e-9);
+    assert(std::abs(d4.upper_bound() - 10.0) < 1e-9);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_decision_layout() {
+    std::cout << "Testing BranchingDecision layout..." << std::endl;
+
+    // Regression guard: decisions must stay compact
+    static_assert(sizeof(BranchingDecision) <= 32, "BranchingDecision too large");
+
+    // Fields of other types read as defaults
+    auto d1 = BranchingDecision::ryan_foster(3, 4, false);
+    assert(d1.variable_index() == -1);
+    assert(d1.arc_index() == -1);
+    assert(d1.upper_bound() == std::numeric_limits<double>::infinity());
+
+    // Setting a field re-tags the decision
+    BranchingDecision d2;
+    assert(d2.type() == BranchType::VARIABLE);
+    d2.set_item_i(7);
+    d2.set_item_j(9);
+    assert(d2.type() == BranchType::RYAN_FOSTER);
+    assert(d2.item_i() == 7 && d2.item_j() == 9);
+    assert(d2.same_column() == false);
+
+    // Custom payload is stored out of line and shared between copies
+    BranchingDecision d4;
+    {
+        auto d3 = BranchingDecision::custom({1, 2, 3}, {0.5});
+        d4 = d3;
+        assert(d4.custom_int_data().data == d3.custom_int_data().data);
+    }
+    assert(d4.type() == BranchType::CUSTOM);
+    assert(d4.custom_int_data().size == 3);
+    assert(d4.custom_int_data()[2] == 3);
+    assert(d4.custom_float_data().size == 1);
+    assert(std::abs(d4.custom_float_data()[0] - 0.5) < 1e-9);
+
+    // Setters copy-on-write; the other array is kept
+    BranchingDecision d5 = d4;
+    d5.set_custom_int_data({8});
+    assert(d5.custom_int_data().size == 1 && d5.custom_int_data()[0] == 8);
+    assert(d5.custom_float_data().size == 1);
+    assert(d4.custom_int_data().size == 3);
+
+    // Moving leaves the source empty; re-tagging drops the payload
+    BranchingDecision d6 = std::move(d5);
+    assert(d5.type() == BranchType::VARIABLE);
+    assert(d6.custom_int_data()[0] == 8);
+    d6.set_item_i(1);
+    assert(d6.custom_int_data().empty());
+    assert(BranchingDecision::custom({}, {}).custom_float_data().empty());
 
     std::cout << "  PASSED" << std::endl;
 }
@@ -140,6 +193,66 @@ void test_branching_decisions() {
 
     auto all = node.all_decisions();
     assert(all.size() == 3);
+    assert(all[0].type() == BranchType::VARIABLE && all[0].variable_index() == 3);
+    assert(all[2].type() == BranchType::RYAN_FOSTER);
+
+    // Adding a local decision later does not affect a path shared earlier
+    DecisionPath snapshot = node.decision_path();
+    node.add_local_decision(BranchingDecision::arc_branch(7, 1, false));
+    assert(snapshot.size() == 3);
+    assert(node.num_decisions() == 4);
+    assert(node.local_decisions().size() == 3);
+    assert(node.inherited_path().size() == 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_ryan_foster_closure() {
+    std::cout << "Testing RyanFosterClosure..." << std::endl;
+
+    RyanFosterClosure closure;
+    assert(closure.feasible() && closure.num_items() == 0);
+    assert(closure.together(4, 4) && !closure.implied(4, 5));
+
+    // same(1,2), same(2,3): 1 and 3 are together by transitivity
+    closure.add(BranchingDecision::ryan_foster(1, 2, true));
+    closure.add(BranchingDecision::ryan_foster(2, 3, true));
+    assert(closure.together(1, 3) && closure.together(3, 1));
+    assert(closure.representative(3) == closure.representative(1));
+    assert(closure.representative(9) == 9);
+
+    // diff(3,5) separates the whole class {1,2,3} from 5; same(5,6) joins 6
+    closure.add(BranchingDecision::ryan_foster(3, 5, false));
+    closure.add(BranchingDecision::ryan_foster(6, 5, true));
+    assert(closure.apart(1, 6) && closure.apart(6, 2));
+    assert(!closure.apart(1, 3) && !closure.together(1, 5));
+    assert(!closure.implied(1, 7));
+    closure.add(BranchingDecision::variable_branch(0, 1.0, true));  // Ignored
+    assert(closure.feasible() && closure.num_items() == 5);
+
+    using Pairs = std::vector<std::pair<int32_t, int32_t>>;
+    assert((closure.implied_pairs(true) == Pairs{{1, 2}, {1, 3}, {2, 3}, {5, 6}}));
+    assert(closure.implied_pairs(false).size() == 6);
+
+    // Merging two classes that must be apart is a contradiction
+    RyanFosterClosure copy = closure;
+    assert(!copy.add(BranchingDecision::ryan_foster(2, 6, true)));
+    assert(!copy.feasible() && closure.feasible());
+
+    // So is diff inside one class, including diff(i, i)
+    assert(!RyanFosterClosure({BranchingDecision::ryan_foster(1, 2, true),
+                               BranchingDecision::ryan_foster(2, 3, true),
+                               BranchingDecision::ryan_foster(1, 3, false)}).feasible());
+    assert(!RyanFosterClosure({BranchingDecision::ryan_foster(4, 4, false)}).feasible());
+    assert(RyanFosterClosure({BranchingDecision::ryan_foster(4, 4, true)}).feasible());
+
+    // Nodes keep the closure of their whole path
+    BPNode node;
+    node.add_local_decision(BranchingDecision::ryan_foster(1, 2, true));
+    node.set_inherited_decisions({BranchingDecision::ryan_foster(2, 3, true)});
+    assert(node.ryan_foster_closure()->together(1, 3));
+    node.add_local_decision(BranchingDecision::ryan_foster(1, 3, false));
+    assert(!node.ryan_foster_feasible() && !node.ryan_foster_closure()->feasible());
 
     std::cout << "  PASSED" << std::endl;
 }
@@ -156,6 +269,20 @@ void test_solution_storage() {
     assert(node.has_solution() == true);
     assert(node.solution().size() == 4);
 
+    // A shared buffer outlives replacement and the node itself
+    auto held = node.shared_solution();
+    {
+        BPNode other;
+        other.set_solution_columns({2, 5});
+        auto columns = other.shared_solution_columns();
+        other.set_solution_columns({});
+        assert(!other.has_solution() && other.solution_columns().empty());
+        assert(columns->size() == 2 && (*columns)[1] == 5);
+    }
+    node.set_solution({1.0});
+    assert(node.solution().size() == 1);
+    assert(held->size() == 4 && (*held)[1] == 1.0);
+
     std::cout << "  PASSED" << std::endl;
 }
 
@@ -163,11 +290,13 @@ int main() {
     std::cout << "=== BPNode Tests ===" << std::endl;
 
     test_branching_decision();
+    test_decision_layout();
     test_node_creation();
     test_node_bounds();
     test_node_status();
     test_prune_by_bound();
     test_branching_decisions();
+    test_ryan_foster_closure();
     test_solution_storage();
 
     std::cout << "\nAll tests passed!" << std::endl;
@@ -0,0 +1,151 @@
+/**
+ * @file test_pair_scoring.cpp
+ * @brief Tests for RyanFosterPairScorer.
+ */
+
+#include "core/pair_scoring.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace openbp;
+
+void test_small_instance() {
+    std::cout << "Testing pair scores on a small LP solution..." << std::endl;
+
+    // Columns {0,1,2} = 0.5, {1,0} = 0.25 (unsorted), {2,3,3} = 0.5, {0,3} = 0 (ignored)
+    std::vector<int64_t> offsets{0, 3, 5, 8, 10};
+    std::vector<int32_t> items{0, 1, 2, 1, 0, 2, 3, 3, 0, 3};
+    std::vector<double> values{0.5, 0.25, 0.5, 0.0};
+
+    RyanFosterPairScorer scorer;
+    auto result = scorer.score(offsets, items, values, 10);
+    assert(scorer.num_pairs() == 4);  // (0,1) (0,2) (1,2) (2,3)
+
+    // (0,2), (1,2) and (2,3) have together = 0.5, (0,1) has 0.75
+    assert(result.size() == 4);
+    assert(result.item_i[0] == 0 && result.item_j[0] == 2 && result.score[0] == 1.0);
+    assert(result.item_i[1] == 1 && result.item_j[1] == 2);
+    assert(result.item_i[2] == 2 && result.item_j[2] == 3);
+    assert(result.item_i[3] == 0 && result.item_j[3] == 1);
+    assert(std::abs(result.together[3] - 0.75) < 1e-12 && std::abs(result.score[3] - 0.5) < 1e-12);
+
+    // apart(0,2): column {0,1} alone covers 0 only; {2,3} covers 2 only
+    assert(std::abs(result.apart[0] - 0.75) < 1e-12);
+
+    // Top-k keeps the best pairs only
+    auto best = scorer.score(offsets, items, values, 1);
+    assert(best.size() == 1 && best.item_i[0] == 0 && best.item_j[0] == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_closure_skips_implied_pairs() {
+    std::cout << "Testing implied pairs are skipped..." << std::endl;
+
+    std::vector<int64_t> offsets{0, 3, 4};
+    std::vector<int32_t> items{0, 1, 2, 3};
+    std::vector<double> values{0.5, 0.5};
+
+    // same(0,3), diff(3,2) imply apart(0,2); (0,1) was branched on directly
+    RyanFosterClosure closure({BranchingDecision::ryan_foster(0, 3, true),
+                               BranchingDecision::ryan_foster(3, 2, false),
+                               BranchingDecision::ryan_foster(0, 1, false)});
+
+    RyanFosterPairScorer scorer;
+    auto result = scorer.score(offsets, items, values, 10, &closure);
+    assert(result.size() == 1);
+    assert(result.item_i[0] == 1 && result.item_j[0] == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_matches_reference() {
+    std::cout << "Testing pair scores against a std::map reference..." << std::endl;
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int32_t> item(0, 199);
+    std::uniform_real_distribution<double> value(0.0, 0.6);
+    RyanFosterPairScorer scorer;
+
+    // Several rounds through one scorer: the buffers are reused and grow.
+    // Odd rounds spread the items out, which switches to the hash table.
+    for (int round = 0; round < 6; ++round) {
+        const int32_t spread = round % 2 == 0 ? 1 : 100000;
+        std::vector<int64_t> offsets{0};
+        std::vector<int32_t> items;
+        std::vector<double> values;
+        for (int c = 0; c < 100 * (round + 1); ++c) {
+            int n = 1 + c % 12;
+            for (int p = 0; p < n; ++p) items.push_back(item(rng) * spread);
+            offsets.push_back(static_cast<int64_t>(items.size()));
+            values.push_back(c % 5 == 0 ? 0.0 : value(rng));
+        }
+
+        std::map<std::pair<int32_t, int32_t>, double> together;
+        for (size_t c = 0; c < values.size(); ++c) {
+            if (values[c] <= 1e-9) continue;
+            std::vector<int32_t> col(items.begin() + offsets[c], items.begin() + offsets[c + 1]);
+            std::sort(col.begin(), col.end());
+            col.erase(std::unique(col.begin(), col.end()), col.end());
+            for (size_t a = 0; a < col.size(); ++a) {
+                for (size_t b = a + 1; b < col.size(); ++b) together[{col[a], col[b]}] += values[c];
+            }
+        }
+        size_t fractional = 0;
+        for (const auto& [pair, mass] : together) fractional += mass >= 0.01 && mass <= 0.99;
+
+        auto result = scorer.score(offsets, items, values, together.size());
+        assert(scorer.used_dense() == (spread == 1));
+        assert(scorer.num_pairs() == together.size());
+        assert(result.size() == fractional);
+        for (size_t r = 0; r < result.size(); ++r) {
+            assert(result.item_i[r] < result.item_j[r]);
+            assert(std::abs(result.together[r] - together.at({result.item_i[r], result.item_j[r]})) < 1e-9);
+            if (r > 0) assert(result.score[r] <= result.score[r - 1]);
+        }
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_invalid_input() {
+    std::cout << "Testing invalid input..." << std::endl;
+
+    RyanFosterPairScorer scorer;
+    bool threw = false;
+    try {
+        scorer.score({0, 2}, {0, -1}, {0.5}, 1);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        scorer.score({0, 3}, {0, 1}, {0.5}, 1);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    assert(scorer.score({0}, {}, {}, 5).size() == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "=== RyanFosterPairScorer Tests ===" << std::endl;
+
+    test_small_instance();
+    test_closure_skips_implied_pairs();
+    test_matches_reference();
+    test_invalid_input();
+
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,457 @@
+/**
+ * @file test_parallel.cpp
+ * @brief Tests for the parallel branch-and-price driver.
+ */
+
+#include "core/parallel.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+using namespace openbp;
+
+namespace {
+
+constexpr int32_t LEAF_DEPTH = 10;
+
+/**
+ * @brief Deterministic value in [0, 1) derived from a node's decisions,
+ * so results do not depend on node IDs or on which worker runs them.
+ */
+double path_noise(const BPNode* node, uint64_t salt) {
+    uint64_t h = 1469598103934665603ull ^ salt;
+    for (const auto& d : node->decision_path()) {
+        h ^= static_cast<uint64_t>(d.variable_index()) * 2 + (d.is_upper_bound() ? 1 : 0);
+        h *= 1099511628211ull;
+    }
+    return static_cast<double>(h % 10007) / 10007.0;
+}
+
+/**
+ * @brief Synthetic node evaluation: bounds grow with depth, leaves are
+ * integer, and a few nodes are infeasible.
+ */
+NodeResult evaluate(BPNode* node, int /*worker*/) {
+    double lb = node->lower_bound() + path_noise(node, 1);
+    if (node->depth() > 0 && path_noise(node, 2) < 0.05) {
+        return NodeResult::infeasible();
+    }
+    if (node->depth() >= LEAF_DEPTH) {
+        return NodeResult::integer(lb + 2.0 * path_noise(node, 3));
+    }
+    auto var = static_cast<int32_t>(node->depth());
+    return NodeResult::branch(lb, lb, {
+        BranchingDecision::variable_branch(var, 0.5, false),
+        BranchingDecision::variable_branch(var, 0.5, true),
+    });
+}
+
+/**
+ * @brief Everything that must match between reproducible runs.
+ */
+using Fingerprint = std::vector<std::tuple<BPNode::NodeId, BPNode::NodeId, int, double>>;
+
+Fingerprint fingerprint(const BPTree& tree) {
+    Fingerprint fp;
+    tree.for_each_node([&](const BPNode* n) {
+        fp.emplace_back(n->id(), n->parent_id(), static_cast<int>(n->status()), n->lower_bound());
+    });
+    return fp;
+}
+
+double solve_sequential() {
+    BPTree tree;
+    tree.root()->set_lower_bound(0.0);
+    BestFirstSelector selector;
+    ParallelConfig config;
+    config.num_threads = 1;
+    config.deterministic = true;
+    config.gap_tolerance = 0.0;
+    ParallelSolver solver(tree, selector, config);
+    ParallelResult result = solver.run(evaluate);
+    assert(result.status == ParallelStatus::COMPLETED || result.status == ParallelStatus::GAP_LIMIT);
+    return tree.global_upper_bound();
+}
+
+}  // namespace
+
+void test_worker_pool() {
+    std::cout << "Testing WorkerPool..." << std::endl;
+
+    WorkerPool pool(4);
+    std::vector<int> hits(1000, 0);
+    pool.run_tasks(hits.size(), [&](size_t k, int) { hits[k]++; });
+    for (int h : hits) assert(h == 1);
+
+    std::atomic<int> calls{0};
+    pool.run_on_all([&](int) { calls++; });
+    assert(calls == 4);
+
+    bool thrown = false;
+    try {
+        pool.run_tasks(10, [](size_t k, int) {
+            if (k == 7) throw std::runtime_error("boom");
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_parallel_finds_optimum() {
+    std::cout << "Testing non-deterministic parallel solve..." << std::endl;
+
+    const double optimum = solve_sequential();
+    assert(optimum < std::numeric_limits<double>::infinity());
+
+    BPTree tree;
+    tree.root()->set_lower_bound(0.0);
+    BestFirstSelector selector;
+    ParallelConfig config;
+    config.num_threads = 8;
+    config.gap_tolerance = 0.0;
+    ParallelSolver solver(tree, selector, config);
+    ParallelResult result = solver.run(evaluate);
+
+    assert(result.status == ParallelStatus::COMPLETED || result.status == ParallelStatus::GAP_LIMIT);
+    assert(std::abs(tree.global_upper_bound() - optimum) < 1e-12);
+    assert(tree.incumbent() != nullptr);
+    assert(tree.incumbent()->status() == NodeStatus::INTEGER);
+    assert(result.nodes_processed > 0);
+    assert(result.nodes_per_worker.size() == 8);
+    if (result.status == ParallelStatus::COMPLETED) {
+        assert(tree.is_complete());
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_work_stealing_solve() {
+    std::cout << "Testing parallel solve with work stealing..." << std::endl;
+
+    const double optimum = solve_sequential();
+    for (int run = 0; run < 5; ++run) {
+        BPTree tree;
+        tree.root()->set_lower_bound(0.0);
+        WorkStealingSelector selector(8);
+        ParallelConfig config;
+        config.num_threads = 8;
+        config.gap_tolerance = 0.0;
+        ParallelSolver solver(tree, selector, config);
+        ParallelResult result = solver.run(evaluate);
+
+        assert(result.status == ParallelStatus::COMPLETED || result.status == ParallelStatus::GAP_LIMIT);
+        assert(std::abs(tree.global_upper_bound() - optimum) < 1e-12);
+        if (result.status == ParallelStatus::COMPLETED) {
+            assert(tree.is_complete());
+            assert(selector.empty());
+        }
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_deterministic_mode() {
+    std::cout << "Testing deterministic parallel solve..." << std::endl;
+
+    struct Run {
+        Fingerprint fp;
+        ParallelResult result;
+        TreeStats stats;
+        double upper_bound;
+        BPNode::NodeId incumbent;
+    };
+    auto run = [](int num_threads) {
+        BPTree tree;
+        tree.root()->set_lower_bound(0.0);
+        DepthFirstSelector selector;
+        ParallelConfig config;
+        config.num_threads = num_threads;
+        config.deterministic = true;
+        config.round_size = 6;
+        config.gap_tolerance = 0.0;
+        ParallelSolver solver(tree, selector, config);
+        Run r;
+        r.result = solver.run(evaluate);
+        r.fp = fingerprint(tree);
+        r.stats = tree.stats();
+        r.upper_bound = tree.global_upper_bound();
+        r.incumbent = tree.incumbent() ? tree.incumbent()->id() : -1;
+        return r;
+    };
+
+    // Same tree, incumbent and statistics for any thread count
+    Run base = run(1);
+    assert(base.incumbent >= 0);
+    assert(std::abs(base.upper_bound - solve_sequential()) < 1e-12);
+    for (int threads : {1, 3, 8}) {
+        Run r = run(threads);
+        assert(r.fp == base.fp);
+        assert(r.upper_bound == base.upper_bound);
+        assert(r.incumbent == base.incumbent);
+        assert(r.result.status == base.result.status);
+        assert(r.result.nodes_processed == base.result.nodes_processed);
+        assert(r.result.rounds == base.result.rounds);
+        assert(r.stats.nodes_created == base.stats.nodes_created);
+        assert(r.stats.nodes_processed == base.stats.nodes_processed);
+        assert(r.stats.nodes_pruned_bound == base.stats.nodes_pruned_bound);
+        assert(r.stats.nodes_pruned_infeasible == base.stats.nodes_pruned_infeasible);
+        assert(r.stats.nodes_integer == base.stats.nodes_integer);
+        assert(r.stats.nodes_branched == base.stats.nodes_branched);
+        assert(r.stats.max_depth == base.stats.max_depth);
+        assert(r.stats.best_lower_bound == base.stats.best_lower_bound);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_round_api() {
+    std::cout << "Testing batched round API..." << std::endl;
+
+    BPTree tree;
+    tree.root()->set_lower_bound(0.0);
+    BestFirstSelector selector;
+    tree.add_listener(&selector);
+    selector.add_node(tree.root());
+
+    std::vector<BPNode*> batch;
+    std::vector<NodeResult> results;
+    size_t rounds = 0;
+    size_t improvements = 0;
+    while (select_round(tree, selector, 8, batch) > 0) {
+        assert(batch.size() <= 8);
+        for (BPNode* node : batch) {
+            assert(node->status() == NodeStatus::PROCESSING);
+            results.push_back(evaluate(node, 0));
+        }
+        improvements += apply_round(tree, selector, batch, results);
+        assert(!tree.prune_pending());
+        batch.clear();
+        results.clear();
+        rounds++;
+    }
+    assert(rounds > 1);
+    assert(improvements > 0);
+    assert(tree.is_complete());
+    assert(tree.global_upper_bound() == solve_sequential());
+
+    bool thrown = false;
+    try {
+        std::vector<BPNode*> one = {tree.root()};
+        apply_round(tree, selector, one, results);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    tree.remove_listener(&selector);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_portfolio() {
+    std::cout << "Testing portfolio racing..." << std::endl;
+
+    const double optimum = solve_sequential();
+    auto zero_root = [](BPNode* root) { root->set_lower_bound(0.0); };
+
+    PortfolioConfig config;
+    config.gap_tolerance = 0.0;
+    PortfolioSolver portfolio(config);
+    assert(portfolio.num_racers() == 4);
+    PortfolioResult result = portfolio.run(evaluate, zero_root);
+
+    assert(result.status == ParallelStatus::COMPLETED || result.status == ParallelStatus::GAP_LIMIT);
+    assert(result.winner >= 0 && result.winner < 4);
+    assert(result.incumbent_racer >= 0);
+    assert(std::abs(result.upper_bound - optimum) < 1e-12);
+    assert(result.lower_bound <= result.upper_bound);
+    assert(result.racers.size() == 4);
+    assert(result.racers[static_cast<size_t>(result.winner)].status == result.status);
+
+    // The winner proved the shared incumbent, found by itself or imported
+    assert(portfolio.tree(result.winner).global_upper_bound() == result.upper_bound);
+
+    // Node limit on every racer: nobody proves optimality
+    PortfolioConfig limited;
+    limited.selectors = {"best_first", "depth_first"};
+    limited.max_nodes = 5;
+    PortfolioResult partial = PortfolioSolver(limited).run(evaluate, zero_root);
+    assert(partial.status == ParallelStatus::NODE_LIMIT);
+    assert(partial.winner == -1);
+    for (const auto& racer : partial.racers) assert(racer.nodes_processed == 5);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_incumbent_register() {
+    std::cout << "Testing lock-free incumbent register..." << std::endl;
+
+    IncumbentRegister reg;
+    assert(reg.upper_bound() == std::numeric_limits<double>::infinity());
+    assert(reg.epoch() == 0 && reg.source() == -1);
+
+    int calls = 0;
+    double delivered = 0.0;
+    BoundSubscription sub(reg, [&](double ub) { calls++; delivered = ub; });
+    assert(!sub.poll());
+
+    assert(reg.offer(10.0, 2));
+    assert(!reg.offer(10.0, 3));  // Not an improvement
+    assert(!reg.offer(11.0, 3));
+    assert(reg.offer(7.0, 1));
+    assert(reg.epoch() == 2 && reg.source() == 1);
+
+    // Two improvements between polls arrive as one delivery
+    assert(sub.poll());
+    assert(calls == 1 && delivered == 7.0);
+    assert(!sub.poll());
+
+    // Concurrent offers keep the minimum; each improvement bumps the epoch
+    {
+        IncumbentRegister shared;
+        std::atomic<int> improvements{0};
+        WorkerPool pool(8);
+        pool.run_on_all([&](int worker) {
+            for (int k = 1000; k > 0; --k) {
+                if (shared.offer(k * 8.0 + worker, worker)) improvements++;
+            }
+        });
+        assert(shared.upper_bound() == 8.0);
+        assert(shared.source() == 0);
+        assert(shared.epoch() == static_cast<uint64_t>(improvements.load()));
+    }
+
+    // A subscription polled by many workers delivers each epoch once
+    {
+        IncumbentRegister shared;
+        std::atomic<int> deliveries{0};
+        BoundSubscription multi(shared, [&](double) { deliveries++; });
+        shared.offer(1.0);
+        WorkerPool pool(8);
+        pool.run_on_all([&](int) { multi.poll(); });
+        assert(deliveries == 1);
+    }
+
+    // Tightening a tree only flags pruning; one pass serves all bounds
+    {
+        BPTree tree;
+        tree.root()->set_lower_bound(0.0);
+        auto children = tree.create_children(tree.root(), {
+            BranchingDecision::variable_branch(0, 0.5, false),
+            BranchingDecision::variable_branch(0, 0.5, true),
+        });
+        tree.mark_processed(tree.root(), NodeStatus::BRANCHED);
+        children[0]->set_lower_bound(3.0);
+        children[1]->set_lower_bound(6.0);
+
+        assert(!tree.prune_pending());
+        assert(tree.tighten_upper_bound(8.0));
+        assert(tree.tighten_upper_bound(5.0));
+        assert(!tree.tighten_upper_bound(9.0));
+        assert(tree.global_upper_bound() == 5.0);
+        assert(tree.incumbent() == nullptr);
+        assert(tree.prune_pending());
+        assert(children[1]->can_be_explored());
+
+        assert(tree.prune_if_pending() == 1);
+        assert(!children[1]->can_be_explored());
+        assert(children[0]->can_be_explored());
+        assert(!tree.prune_pending());
+        assert(tree.prune_if_pending() == 0);
+    }
+
+    // A bound found outside the solver prunes its tree from the start
+    {
+        IncumbentRegister shared;
+        shared.offer(solve_sequential());
+
+        BPTree tree;
+        tree.root()->set_lower_bound(0.0);
+        BestFirstSelector selector;
+        ParallelConfig config;
+        config.num_threads = 4;
+        config.gap_tolerance = 0.0;
+        ParallelSolver solver(tree, selector, config);
+        solver.share_incumbent(shared);
+        ParallelResult result = solver.run(evaluate);
+
+        assert(result.status == ParallelStatus::COMPLETED || result.status == ParallelStatus::GAP_LIMIT);
+        assert(tree.global_upper_bound() == shared.upper_bound());
+        assert(tree.incumbent() == nullptr);  // Nothing strictly better exists
+        assert(&solver.incumbent() == &shared);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_node_limit_and_errors() {
+    std::cout << "Testing node limit and callback errors..." << std::endl;
+
+    {
+        BPTree tree;
+        BestFirstSelector selector;
+        ParallelConfig config;
+        config.num_threads = 4;
+        config.deterministic = true;
+        config.max_nodes = 50;
+        ParallelSolver solver(tree, selector, config);
+        ParallelResult result = solver.run(evaluate);
+        assert(result.status == ParallelStatus::NODE_LIMIT);
+        assert(result.nodes_processed == 50);
+        assert(!selector.empty());  // Remaining nodes stay queued
+    }
+    {
+        BPTree tree;
+        BestFirstSelector selector;
+        ParallelConfig config;
+        config.num_threads = 4;
+        config.max_nodes = 50;
+        ParallelSolver solver(tree, selector, config);
+        ParallelResult result = solver.run(evaluate);
+        assert(result.status == ParallelStatus::NODE_LIMIT);
+        assert(result.nodes_processed <= 50);
+    }
+    {
+        BPTree tree;
+        BestFirstSelector selector;
+        tree.add_listener(&selector);
+        ParallelConfig config;
+        config.num_threads = 4;
+        ParallelSolver solver(tree, selector, config);
+        bool thrown = false;
+        try {
+            solver.run([](BPNode* node, int w) {
+                if (node->depth() == 3) throw std::runtime_error("pricing failed");
+                return evaluate(node, w);
+            });
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(tree.has_listener(&selector));  // Re-attached after the run
+        tree.remove_listener(&selector);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Parallel Driver Tests ===" << std::endl;
+
+    test_worker_pool();
+    test_parallel_finds_optimum();
+    test_work_stealing_solve();
+    test_deterministic_mode();
+    test_round_api();
+    test_portfolio();
+    test_incumbent_register();
+    test_node_limit_and_errors();
+
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
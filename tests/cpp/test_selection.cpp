@@ -0,0 +1,473 @@
+/**
+ * @file test_selection.cpp
+ * @brief Tests for node selection policies.
+ */
+
+#include "core/selection.hpp"
+#include <cassert>
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+using namespace openbp;
+
+namespace {
+
+/**
+ * @brief Create @p n pending children of the root with lower bounds 0..n-1.
+ */
+std::vector<BPNode*> make_open_nodes(BPTree& tree, int n) {
+    std::vector<BPNode*> nodes;
+    for (int k = 0; k < n; ++k) {
+        auto* child = tree.create_child(tree.root(), BranchingDecision::variable_branch(k, 0.5, true));
+        child->set_lower_bound(static_cast<double>(k));
+        nodes.push_back(child);
+    }
+    return nodes;
+}
+
+}  // namespace
+
+void test_best_first_order() {
+    std::cout << "Testing BestFirstSelector ordering..." << std::endl;
+
+    BPTree tree;
+    auto nodes = make_open_nodes(tree, 50);
+
+    BestFirstSelector selector;
+    // Insert in scrambled order
+    for (int k = 0; k < 50; ++k) {
+        selector.add_node(nodes[(k * 17) % 50]);
+    }
+    assert(selector.size() == 50);
+    assert(std::abs(selector.best_bound() - 0.0) < 1e-9);
+
+    for (int k = 0; k < 50; ++k) {
+        BPNode* node = selector.select_next();
+        assert(node != nullptr);
+        assert(std::abs(node->lower_bound() - k) < 1e-9);
+    }
+    assert(selector.empty());
+    assert(selector.select_next() == nullptr);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_best_first_lazy_deletion() {
+    std::cout << "Testing BestFirstSelector lazy deletion..." << std::endl;
+
+    BPTree tree;
+    auto nodes = make_open_nodes(tree, 10);
+
+    BestFirstSelector selector(0.5);
+    selector.add_nodes(nodes);
+
+    // Prune the three best nodes behind the selector's back
+    for (int k = 0; k < 3; ++k) {
+        tree.mark_processed(nodes[k], NodeStatus::PRUNED_BOUND);
+    }
+    assert(selector.size() == 7);
+
+    // Stale entries are skipped when they surface
+    assert(std::abs(selector.best_bound() - 3.0) < 1e-9);
+    BPNode* node = selector.select_next();
+    assert(node == nodes[3]);
+
+    // prune() drops stale entries below the top without a rebuild
+    tree.mark_processed(nodes[9], NodeStatus::PRUNED_INFEASIBLE);
+    assert(selector.size() == 5);
+    assert(selector.prune() == 1);
+    assert(selector.size() == 5);
+
+    // Past the threshold, prune() compacts the heap
+    for (int k = 4; k < 8; ++k) {
+        tree.mark_processed(nodes[k], NodeStatus::PRUNED_BOUND);
+    }
+    assert(selector.prune() == 4);
+    assert(selector.size() == 1);
+    assert(selector.get_open_node_ids().size() == 1);
+    assert(selector.select_next() == nodes[8]);
+    assert(selector.empty());
+
+    // A selector holding only closed nodes is empty without prune()
+    auto more = make_open_nodes(tree, 4);
+    selector.add_nodes(more);
+    for (BPNode* n : more) tree.mark_processed(n, NodeStatus::FATHOMED);
+    assert(selector.size() == 0);
+    assert(selector.empty());
+    assert(selector.select_next() == nullptr);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_indexed_heap() {
+    std::cout << "Testing IndexedHeap..." << std::endl;
+
+    BPTree tree;
+    auto nodes = make_open_nodes(tree, 500);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> bound(0.0, 100.0);
+
+    IndexedHeap<ByLowerBound> heap;
+    for (auto* node : nodes) {
+        node->set_lower_bound(bound(rng));
+        heap.push(node);
+    }
+
+    // Remove every third node, re-key every fifth
+    for (size_t k = 0; k < nodes.size(); k += 3) {
+        assert(heap.remove(nodes[k]));
+        assert(!heap.contains(nodes[k]));
+        assert(!heap.remove(nodes[k]));
+    }
+    for (size_t k = 1; k < nodes.size(); k += 5) {
+        nodes[k]->set_lower_bound(bound(rng));
+        heap.update(nodes[k]);
+    }
+
+    std::vector<double> expected;
+    for (size_t k = 0; k < nodes.size(); ++k) {
+        if (k % 3 != 0) expected.push_back(nodes[k]->lower_bound());
+    }
+    std::sort(expected.begin(), expected.end());
+    assert(heap.size() == expected.size());
+
+    for (double e : expected) {
+        BPNode* top = heap.pop();
+        assert(std::abs(top->lower_bound() - e) < 1e-12);
+    }
+    assert(heap.empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_hashed_positions() {
+    std::cout << "Testing IndexedHeap with hashed positions..." << std::endl;
+
+    BPTree tree;
+    auto nodes = make_open_nodes(tree, 2000);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> bound(0.0, 100.0);
+    for (auto* node : nodes) node->set_lower_bound(bound(rng));
+
+    // Random churn, checked against the dense-table heap
+    IndexedHeap<ByLowerBound> dense;
+    IndexedHeap<ByLowerBound, 4, HashedPositions> hashed;
+    std::uniform_int_distribution<size_t> pick(0, nodes.size() - 1);
+    for (int step = 0; step < 20000; ++step) {
+        BPNode* node = nodes[pick(rng)];
+        switch (step % 4) {
+            case 0:
+            case 1:
+                dense.push(node);
+                hashed.push(node);
+                break;
+            case 2:
+                assert(dense.remove(node) == hashed.remove(node));
+                break;
+            default:
+                node->set_lower_bound(bound(rng));
+                assert(dense.update(node) == hashed.update(node));
+                break;
+        }
+        assert(dense.contains(node) == hashed.contains(node));
+        assert(dense.size() == hashed.size());
+    }
+
+    // Drain both in the same order, then refill after the table shrank
+    while (!dense.empty()) assert(dense.pop()->lower_bound() == hashed.pop()->lower_bound());
+    assert(hashed.empty());
+    for (auto* node : nodes) assert(!hashed.contains(node));
+    hashed.push(nodes[0]);
+    assert(hashed.contains(nodes[0]) && hashed.pop() == nodes[0]);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_remove_and_update_priority() {
+    std::cout << "Testing selector remove/update_priority..." << std::endl;
+
+    BPTree tree;
+    auto nodes = make_open_nodes(tree, 10);
+
+    BestFirstSelector best;
+    DepthFirstSelector depth;
+    BestEstimateSelector estimate;
+    best.add_nodes(nodes);
+    depth.add_nodes(nodes);
+    estimate.add_nodes(nodes);
+
+    // O(log n) removal of an arbitrary node
+    assert(best.remove(nodes[0]));
+    assert(!best.contains(nodes[0]));
+    assert(best.size() == 9);
+    assert(depth.remove(nodes[4]));
+    assert(depth.size() == 9);
+    assert(estimate.remove(nodes[4]));
+    assert(!estimate.contains(nodes[4]));
+    assert(estimate.size() == 9);
+
+    // A raised bound moves the node behind the others
+    nodes[1]->set_lower_bound(100.0);
+    assert(best.update_priority(nodes[1]));
+    assert(best.select_next() == nodes[2]);
+
+    // Depth-first: same depth, so the bound breaks the tie
+    nodes[2]->set_lower_bound(-1.0);
+    assert(depth.update_priority(nodes[2]));
+    assert(depth.select_next() == nodes[2]);
+
+    assert(!best.update_priority(nodes[0]));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_best_estimate_order() {
+    std::cout << "Testing BestEstimateSelector heap order..." << std::endl;
+
+    // Random tree: nodes at varying depths with random bounds
+    BPTree tree;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> bound(0.0, 100.0);
+    std::vector<BPNode*> all = {tree.root()};
+    for (int k = 0; k < 300; ++k) {
+        BPNode* parent = all[rng() % all.size()];
+        BPNode* child = tree.create_child(parent, BranchingDecision::variable_branch(k, 0.5, true));
+        child->set_lower_bound(bound(rng));
+        all.push_back(child);
+    }
+
+    const double weight = 0.5;
+    BestEstimateSelector selector(weight);
+    std::vector<BPNode*> open(all.begin() + 1, all.begin() + 151);
+    selector.add_nodes(open);
+
+    // Reference: linear scan with the same estimate
+    auto expected_next = [&](double ub, int64_t max_depth) {
+        ByEstimate key{weight, ub, max_depth};
+        return *std::min_element(open.begin(), open.end(), key);
+    };
+    auto take = [&](BPNode* node) {
+        open.erase(std::find(open.begin(), open.end(), node));
+    };
+
+    double ub = std::numeric_limits<double>::infinity();
+    for (int k = 0; k < 40; ++k) {
+        BPNode* node = selector.select_next();
+        assert(node == expected_next(ub, selector.max_depth()));
+        take(node);
+    }
+
+    // Incumbent found: one bulk re-key, then heap order again
+    ub = 120.0;
+    selector.on_bound_update(ub);
+    for (int k = 0; k < 40; ++k) {
+        BPNode* node = selector.select_next();
+        assert(node == expected_next(ub, selector.max_depth()));
+        take(node);
+    }
+
+    // Deeper nodes arrive: max depth grows and the heap is re-keyed
+    int64_t old_max = selector.max_depth();
+    std::vector<BPNode*> more(all.begin() + 151, all.end());
+    selector.add_nodes(more);
+    open.insert(open.end(), more.begin(), more.end());
+    assert(selector.max_depth() >= old_max);
+    while (!open.empty()) {
+        BPNode* node = selector.select_next();
+        assert(node == expected_next(ub, selector.max_depth()));
+        take(node);
+    }
+    assert(selector.empty());
+    assert(selector.select_next() == nullptr);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_hybrid_shared_store() {
+    std::cout << "Testing HybridSelector shared store..." << std::endl;
+
+    // Two levels: bounds increase with ID, grandchildren are deeper
+    BPTree tree;
+    auto nodes = make_open_nodes(tree, 30);
+    for (int k = 0; k < 10; ++k) {
+        auto* deep = tree.create_child(nodes[29 - k], BranchingDecision::variable_branch(100 + k, 0.5, true));
+        deep->set_lower_bound(200.0 + k);
+        nodes.push_back(deep);
+    }
+
+    HybridSelector selector(2, 3);
+    selector.add_nodes(nodes);
+    assert(selector.size() == nodes.size());
+
+    // Two best-first picks, then a dive of three deepest nodes
+    assert(selector.select_next() == nodes[0]);
+    assert(selector.select_next() == nodes[1]);
+    assert(selector.select_next() == nodes[30]);
+    assert(selector.is_diving());
+    assert(selector.select_next() == nodes[31]);
+    assert(selector.select_next() == nodes[32]);
+    assert(!selector.is_diving());
+    assert(selector.size() == nodes.size() - 5);
+
+    // Removal through either order is immediate in the other one
+    assert(selector.remove(nodes[2]));
+    assert(!selector.contains(nodes[2]));
+    assert(selector.best_bound() == 3.0);
+
+    // Every node comes out exactly once
+    std::vector<bool> seen(nodes.size() + 1, false);
+    size_t count = 5 + 1;
+    while (BPNode* node = selector.select_next()) {
+        assert(!seen[node->id()]);
+        seen[node->id()] = true;
+        count++;
+    }
+    assert(count == nodes.size());
+    assert(selector.empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_tree_notifies_selector() {
+    std::cout << "Testing tree-to-selector notifications..." << std::endl;
+
+    BPTree tree;
+    auto nodes = make_open_nodes(tree, 100);
+    tree.mark_processed(tree.root(), NodeStatus::BRANCHED);
+
+    BestFirstSelector selector;
+    selector.add_nodes(nodes);
+    tree.add_listener(&selector);
+
+    // One node is being processed: it must survive pruning
+    BPNode* busy = selector.select_next();
+    assert(busy == nodes[0]);
+    busy->set_status(NodeStatus::PROCESSING);
+    busy->set_lower_bound(95.0);
+
+    // Incumbent at 90: exactly the nodes with bound >= 90 are cut off,
+    // and the selector drops them in the same pass
+    tree.set_global_upper_bound(90.0);
+    assert(tree.prune_by_bound() == 10);
+    assert(selector.size() == 89);
+    assert(busy->status() == NodeStatus::PROCESSING);
+    assert(nodes[95]->status() == NodeStatus::PRUNED_BOUND);
+    assert(nodes[89]->can_be_explored());
+
+    // Lower bounds set directly on a node re-order the selector
+    nodes[50]->set_lower_bound(-5.0);
+    assert(selector.peek_next() == nodes[50]);
+
+    // Closing a pending node through the tree removes it as well
+    tree.mark_processed(nodes[50], NodeStatus::FATHOMED);
+    assert(!selector.contains(nodes[50]));
+    assert(selector.size() == 88);
+
+    tree.remove_listener(&selector);
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_depth_first_best_bound() {
+    std::cout << "Testing DepthFirstSelector best_bound..." << std::endl;
+
+    BPTree tree;
+    auto nodes = make_open_nodes(tree, 20);
+    auto grandchild = tree.create_child(nodes[19], BranchingDecision::variable_branch(99, 0.5, true));
+    grandchild->set_lower_bound(30.0);
+
+    DepthFirstSelector selector;
+    selector.add_nodes(nodes);
+    selector.add_node(grandchild);
+    assert(selector.best_bound() == 0.0);
+
+    // Deepest node is selected, the best bound is unaffected
+    assert(selector.select_next() == grandchild);
+    assert(selector.best_bound() == 0.0);
+
+    // Nodes closed behind the selector's back are skipped lazily
+    nodes[0]->set_status(NodeStatus::PRUNED_BOUND);
+    nodes[1]->set_status(NodeStatus::PRUNED_BOUND);
+    assert(selector.best_bound() == 2.0);
+    assert(selector.size() == 18);
+
+    selector.remove(nodes[2]);
+    nodes[3]->set_lower_bound(50.0);
+    selector.update_priority(nodes[3]);
+    assert(selector.best_bound() == 4.0);
+
+    selector.clear();
+    assert(selector.best_bound() == std::numeric_limits<double>::infinity());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_work_stealing() {
+    std::cout << "Testing WorkStealingSelector..." << std::endl;
+
+    BPTree tree;
+    auto nodes = make_open_nodes(tree, 30);
+    auto* deep = tree.create_child(nodes[5], BranchingDecision::variable_branch(99, 0.5, true));
+    deep->set_lower_bound(5.5);
+
+    WorkStealingSelector selector(4, 0.1);
+    assert(selector.is_concurrent());
+    selector.add_nodes_for_worker({nodes.begin(), nodes.begin() + 10}, 0);
+    selector.add_nodes_for_worker({deep}, 0);
+    selector.add_nodes_for_worker({nodes.begin() + 20, nodes.end()}, 1);
+    assert(selector.size() == 21);
+    assert(selector.local_size(0) == 11);
+    assert(selector.local_size(2) == 0);
+    assert(selector.best_bound() == 0.0);
+
+    // Own queue is depth-first
+    assert(selector.select_for_worker(0) == deep);
+
+    // Worker 1's best (20) drifted too far from the global best (0)
+    assert(selector.select_for_worker(1) == nodes[0]);
+    assert(selector.num_balancing_picks() == 1);
+
+    // Idle worker 2 steals the best node
+    assert(selector.select_for_worker(2) == nodes[1]);
+    assert(selector.num_steals() == 1);
+    assert(selector.size() == 18);
+    assert(selector.best_bound() == 2.0);
+
+    // Pruned nodes are dropped; remove() finds nodes in any queue
+    nodes[2]->set_status(NodeStatus::PRUNED_BOUND);
+    assert(selector.prune() == 1);
+    assert(selector.remove(nodes[25]));
+    assert(!selector.contains(nodes[25]));
+    assert(selector.size() == 16);
+    assert(selector.best_bound() == 3.0);
+
+    // Draining from one worker returns every remaining node exactly once
+    std::vector<BPNode*> drained;
+    while (BPNode* node = selector.select_for_worker(3)) drained.push_back(node);
+    assert(drained.size() == 16);
+    std::sort(drained.begin(), drained.end());
+    assert(std::unique(drained.begin(), drained.end()) == drained.end());
+    assert(selector.empty());
+    assert(selector.best_bound() == std::numeric_limits<double>::infinity());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "=== NodeSelector Tests ===" << std::endl;
+
+    test_best_first_order();
+    test_best_first_lazy_deletion();
+    test_indexed_heap();
+    test_hashed_positions();
+    test_remove_and_update_priority();
+    test_best_estimate_order();
+    test_hybrid_shared_store();
+    test_tree_notifies_selector();
+    test_depth_first_best_bound();
+    test_work_stealing();
+
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
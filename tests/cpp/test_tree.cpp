@@ -7,6 +7,10 @@
 #include <cassert>
 #include <iostream>
 #include <cmath>
+#include <limits>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
 
 using namespace openbp;
 
@@ -59,6 +63,39 @@ void test_create_children() {
     assert(tree.num_nodes() == 3);
     assert(root->status() == NodeStatus::BRANCHED);
 
+    // k-ary batch: consecutive IDs, one shared parent path, parent bounds
+    children[0]->set_lower_bound(4.0);
+    std::vector<BranchingDecision> k_ary;
+    for (int32_t k = 0; k < 5; ++k) {
+        k_ary.push_back(BranchingDecision::ryan_foster(k, k + 1, k % 2 == 0));
+    }
+    auto grandchildren = tree.create_children(children[0], k_ary);
+    assert(grandchildren.size() == 5);
+    for (size_t k = 0; k < grandchildren.size(); ++k) {
+        BPNode* g = grandchildren[k];
+        assert(g->id() == 3 + static_cast<BPNode::NodeId>(k));
+        assert(tree.node(g->id()) == g);
+        assert(g->parent_id() == children[0]->id());
+        assert(g->depth() == 2);
+        assert(g->lower_bound() == 4.0);
+        assert(g->inherited_path().same_as(children[0]->decision_path()));
+        assert(g->decision_path().back().item_i() == static_cast<int32_t>(k));
+        assert(children[0]->children()[k] == g->id());
+    }
+    assert(children[0]->num_open_children() == 5);
+
+    TreeStats stats = tree.stats();
+    assert(stats.nodes_created == 8);
+    assert(stats.nodes_open == 6);  // children[1] and the grandchildren
+    assert(stats.nodes_branched == 2);
+    assert(stats.max_depth == 2);
+    assert(tree.global_lower_bound() == children[1]->lower_bound());
+
+    // No decisions: the parent closes without children
+    auto none = tree.create_children(children[1], {});
+    assert(none.empty());
+    assert(tree.stats().nodes_open == 5);
+
     std::cout << "  PASSED" << std::endl;
 }
 
@@ -83,6 +120,102 @@ void test_inherited_decisions() {
     std::cout << "  PASSED" << std::endl;
 }
 
+void test_shared_decision_path() {
+    std::cout << "Testing shared decision paths..." << std::endl;
+
+    BPTree tree;
+    auto* node = tree.root();
+
+    // Deep dive: every child must share its parent's path, not copy it
+    for (int k = 0; k < 1000; ++k) {
+        auto* parent = node;
+        node = tree.create_child(parent, BranchingDecision::ryan_foster(k, k + 1, true));
+        assert(node->inherited_path().same_as(parent->decision_path()));
+    }
+    assert(node->num_decisions() == 1000);
+
+    // Walk the path without materialising it (most recent first)
+    int expected = 999;
+    for (const auto& d : node->decision_path()) {
+        assert(d.item_i() == expected);
+        expected--;
+    }
+    assert(expected == -1);
+
+    // Compatibility shim keeps root-to-node order
+    auto all = node->all_decisions();
+    assert(all.front().item_i() == 0);
+    assert(all.back().item_i() == 999);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_infeasible_ryan_foster_children() {
+    std::cout << "Testing contradictory Ryan-Foster children..." << std::endl;
+
+    BPTree tree;
+    auto* a = tree.create_child(tree.root(), BranchingDecision::ryan_foster(0, 1, true));
+    auto* b = tree.create_child(a, BranchingDecision::ryan_foster(1, 2, true));
+
+    auto* c = tree.create_child(b, BranchingDecision::variable_branch(0, 1.0, true));
+    assert(c->ryan_foster_feasible() && c->ryan_foster_closure()->together(0, 2));
+
+    // same(0,1), same(1,2) then diff(0,2) or same with a class apart
+    int64_t open_before = tree.stats().nodes_open;
+    auto children = tree.create_children(c, {BranchingDecision::ryan_foster(0, 2, false),
+                                             BranchingDecision::ryan_foster(2, 3, false)});
+    assert(children[0]->status() == NodeStatus::PRUNED_INFEASIBLE);
+    assert(children[1]->status() == NodeStatus::PENDING);
+    assert(tree.stats().nodes_pruned_infeasible == 1);
+    assert(tree.stats().nodes_open == open_before);  // c closed, one child opened
+
+    auto open = tree.get_open_nodes();
+    assert(std::find(open.begin(), open.end(), children[0]->id()) == open.end());
+
+    auto* d = tree.create_child(children[1], BranchingDecision::ryan_foster(3, 0, true));
+    assert(d->status() == NodeStatus::PRUNED_INFEASIBLE);
+    assert(children[1]->ryan_foster_closure()->apart(0, 3));
+    assert(tree.stats().nodes_pruned_infeasible == 2);
+
+    // All children infeasible: the parent's subtree closes with them
+    BPTree other;
+    auto* root_child = other.create_child(other.root(), BranchingDecision::ryan_foster(5, 6, false));
+    auto dead = other.create_children(root_child, {BranchingDecision::ryan_foster(5, 6, true),
+                                                   BranchingDecision::ryan_foster(6, 5, true)});
+    assert(dead[0]->is_pruned() && dead[1]->is_pruned());
+    assert(root_child->num_open_children() == 0);
+    assert(other.stats().nodes_open == 1);  // Only the root
+
+    // Random search: children are checked against closures handed down
+    // (and taken over) between nodes, and match a closure rebuilt from
+    // the whole path; siblings of dived-into nodes are expanded later
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int32_t> item(0, 11);
+    BPTree deep;
+    std::vector<BPNode*> frontier = {deep.root()};
+    for (int step = 0; step < 300 && !frontier.empty(); ++step) {
+        size_t pick = step % 7 == 6 ? rng() % frontier.size() : frontier.size() - 1;
+        BPNode* node = frontier[pick];
+        frontier.erase(frontier.begin() + static_cast<std::ptrdiff_t>(pick));
+        auto decision = step % 5 == 4 ? BranchingDecision::variable_branch(step, 0.5, true)
+                                      : BranchingDecision::ryan_foster(item(rng), item(rng), rng() % 3 == 0);
+        auto children = deep.create_children(node, {decision, BranchingDecision::ryan_foster(
+                                                                  item(rng), item(rng), rng() % 2 == 0)});
+        for (BPNode* child : children) {
+            RyanFosterClosure full(child->all_decisions());
+            assert(child->ryan_foster_feasible() == full.feasible());
+            if (step % 3 == 0) {
+                assert(child->ryan_foster_closure()->implied_pairs(true) == full.implied_pairs(true));
+                assert(child->ryan_foster_closure()->implied_pairs(false) == full.implied_pairs(false));
+            }
+            if (child->ryan_foster_feasible()) frontier.push_back(child);
+        }
+    }
+    assert(!frontier.empty() && frontier.back()->depth() > 20);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
 void test_node_lookup() {
     std::cout << "Testing node lookup..." << std::endl;
 
@@ -103,6 +236,99 @@ void test_node_lookup() {
     std::cout << "  PASSED" << std::endl;
 }
 
+void test_dense_node_index() {
+    std::cout << "Testing dense node index..." << std::endl;
+
+    BPTree tree;
+    auto* node = tree.root();
+
+    // Span several index chunks
+    const int n = 10000;
+    for (int k = 0; k < n; ++k) {
+        node = tree.create_child(node, BranchingDecision::variable_branch(k, 0.5, true));
+    }
+    assert(tree.num_nodes() == static_cast<size_t>(n + 1));
+    assert(tree.node(n) == node);
+    assert(tree.node(-1) == nullptr);
+    assert(tree.node(n + 1) == nullptr);
+
+    // Iteration is in ascending ID order
+    BPNode::NodeId expected = 0;
+    tree.for_each_node([&](BPNode* nd) {
+        assert(nd->id() == expected);
+        expected++;
+    });
+    assert(expected == n + 1);
+
+    // Tombstones are skipped and not counted
+    NodeIndex<BPNode> index;
+    BPNode a, b;
+    index.insert(0, &a);
+    index.insert(5000, &b);
+    assert(index.size() == 2);
+    index.erase(0);
+    assert(index.size() == 1);
+    assert(index.find(0) == nullptr);
+    size_t visited = 0;
+    index.for_each([&](BPNode* nd) { assert(nd == &b); visited++; });
+    assert(visited == 1);
+
+    // IDs outside [0, MAX_IDS) are rejected before touching the pages
+    bool threw = false;
+    try {
+        index.insert(-1, &a);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        index.insert(static_cast<NodeIndex<BPNode>::Id>(NodeIndex<BPNode>::MAX_IDS), &a);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    BPNode* pair[] = {&a, &b};
+    try {
+        index.insert_range(static_cast<NodeIndex<BPNode>::Id>(NodeIndex<BPNode>::MAX_IDS - 1), pair, 2);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(index.size() == 1);
+    assert(index.id_limit() == 5001);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_node_table() {
+    std::cout << "Testing columnar node export..." << std::endl;
+
+    BPTree tree;
+    tree.root()->set_lower_bound(1.0);
+    auto children = tree.create_children(tree.root(), {
+        BranchingDecision::variable_branch(0, 0.5, false),
+        BranchingDecision::variable_branch(0, 0.5, true),
+    });
+    children[1]->set_lower_bound(2.5);
+    children[1]->set_lp_value(2.75);
+    tree.mark_processed(children[0], NodeStatus::PRUNED_INFEASIBLE);
+
+    NodeTable table = tree.node_table();
+    assert(table.size() == 3);
+    assert((table.id == std::vector<int64_t>{0, 1, 2}));
+    assert((table.parent_id == std::vector<int64_t>{-1, 0, 0}));
+    assert((table.depth == std::vector<int32_t>{0, 1, 1}));
+    assert(table.lower_bound[0] == 1.0 && table.lower_bound[2] == 2.5);
+    assert(table.lp_value[2] == 2.75);
+    assert(table.status[0] == static_cast<uint8_t>(NodeStatus::BRANCHED));
+    assert(table.status[1] == static_cast<uint8_t>(NodeStatus::PRUNED_INFEASIBLE));
+    assert(table.status[2] == static_cast<uint8_t>(NodeStatus::PENDING));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
 void test_bounds() {
     std::cout << "Testing bounds management..." << std::endl;
 
@@ -118,6 +344,51 @@ void test_bounds() {
     std::cout << "  PASSED" << std::endl;
 }
 
+void test_incremental_lower_bound() {
+    std::cout << "Testing incremental global lower bound..." << std::endl;
+
+    BPTree tree;
+    assert(tree.global_lower_bound() == -std::numeric_limits<double>::infinity());
+
+    tree.root()->set_lower_bound(10.0);
+    assert(tree.global_lower_bound() == 10.0);
+
+    auto children = tree.create_children(tree.root(), {
+        BranchingDecision::variable_branch(0, 0.5, true),
+        BranchingDecision::variable_branch(0, 0.5, false),
+        BranchingDecision::variable_branch(1, 0.5, true),
+    });
+    children[0]->set_lower_bound(12.0);
+    children[1]->set_lower_bound(15.0);
+    children[2]->set_lower_bound(20.0);
+    assert(tree.global_lower_bound() == 12.0);
+    assert(tree.stats().best_lower_bound == 12.0);
+
+    // A node being processed still counts; closing it raises the bound
+    children[0]->set_status(NodeStatus::PROCESSING);
+    assert(tree.global_lower_bound() == 12.0);
+    tree.mark_processed(children[0], NodeStatus::PRUNED_INFEASIBLE);
+    assert(tree.global_lower_bound() == 15.0);
+
+    // Incumbent at 18 prunes the node at 20; gap is read from the cache
+    tree.set_global_upper_bound(18.0);
+    assert(tree.prune_by_bound() == 1);
+    assert(tree.global_lower_bound() == 15.0);
+    assert(std::abs(tree.gap() - 3.0 / 18.0) < 1e-12);
+
+    // An explicit floor is honoured
+    tree.set_global_lower_bound(16.0);
+    assert(tree.global_lower_bound() == 16.0);
+
+    // No open nodes left: the bound meets the incumbent
+    tree.mark_processed(children[1], NodeStatus::FATHOMED);
+    assert(tree.is_complete());
+    assert(tree.global_lower_bound() == 18.0);
+    assert(tree.gap() == 0.0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
 void test_prune_by_bound() {
     std::cout << "Testing prune_by_bound..." << std::endl;
 
@@ -144,6 +415,47 @@ void test_prune_by_bound() {
     std::cout << "  PASSED" << std::endl;
 }
 
+void test_prune_by_bound_index() {
+    std::cout << "Testing bound-ordered pruning..." << std::endl;
+
+    BPTree tree;
+    std::vector<BranchingDecision> decisions;
+    for (int32_t k = 0; k < 50; ++k) {
+        decisions.push_back(BranchingDecision::variable_branch(k, 0.5, true));
+    }
+    auto children = tree.create_children(tree.root(), decisions);
+    for (size_t k = 0; k < children.size(); ++k) {
+        children[k]->set_lower_bound(static_cast<double>(k));
+    }
+
+    // Re-keyed after creation: must still be found by the index
+    children[3]->set_lower_bound(1000.0);
+    children[45]->set_lower_bound(-1.0);
+    children[40]->set_status(NodeStatus::PROCESSING);
+
+    tree.set_global_upper_bound(30.0);
+    assert(tree.prune_by_bound() == 19);  // 30..49 minus 40 and 45, plus 3
+
+    assert(children[3]->status() == NodeStatus::PRUNED_BOUND);
+    assert(children[30]->status() == NodeStatus::PRUNED_BOUND);
+    assert(children[29]->can_be_explored());
+    assert(children[45]->can_be_explored());
+    assert(children[40]->status() == NodeStatus::PROCESSING);
+    assert(tree.stats().nodes_open == 31);
+    assert(tree.stats().nodes_pruned_bound == 19);
+
+    auto open = tree.get_open_nodes();
+    assert(open.size() == 30);  // Pending only
+    assert(std::is_sorted(open.begin(), open.end()));
+
+    // Nothing left to prune; the processing node is still indexed
+    assert(tree.prune_by_bound() == 0);
+    tree.mark_processed(children[40], NodeStatus::INTEGER);
+    assert(tree.stats().nodes_open == 30);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
 void test_get_open_nodes() {
     std::cout << "Testing get_open_nodes..." << std::endl;
 
@@ -229,6 +541,134 @@ void test_statistics() {
     std::cout << "  PASSED" << std::endl;
 }
 
+void test_node_pool_recycling() {
+    std::cout << "Testing NodePool recycling..." << std::endl;
+
+    NodePool<BPNode> pool(4);
+    BPNode* a = pool.allocate();
+    BPNode* b = pool.allocate(7, 0, 1, BranchingDecision::variable_branch(0, 1.0, true));
+    assert(pool.size() == 2);
+    assert(b->id() == 7);
+    assert(b->num_decisions() == 1);
+
+    // Freed slot is reused by the next allocation
+    pool.deallocate(b);
+    assert(pool.size() == 1);
+    BPNode* c = pool.allocate();
+    assert(c == b);
+    assert(c->num_decisions() == 0);
+    assert(pool.size() == 2);
+    assert(pool.total_allocated() == 3);
+    assert(pool.num_chunks() == 1);
+
+    pool.deallocate(a);
+    pool.deallocate(c);
+    assert(pool.size() == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_node_pool_batch() {
+    std::cout << "Testing NodePool batch allocation..." << std::endl;
+
+    NodePool<BPNode> pool(4);
+    auto make = [](void* storage, size_t k) {
+        return ::new (storage) BPNode(static_cast<BPNode::NodeId>(k), 0, 1,
+                                      BranchingDecision::variable_branch(0, 1.0, true));
+    };
+
+    BPNode* first = pool.allocate();
+    BPNode* batch[4];
+
+    // Three slots left in the chunk: the batch starts a fresh one
+    pool.allocate_batch(4, batch, make);
+    assert(pool.num_chunks() == 2);
+    assert(pool.size() == 5);
+    for (size_t k = 0; k < 4; ++k) {
+        assert(batch[k]->id() == static_cast<BPNode::NodeId>(k));
+        if (k > 0) {
+            assert(reinterpret_cast<char*>(batch[k]) > reinterpret_cast<char*>(batch[k - 1]));
+        }
+    }
+
+    // The retired tail serves later allocations
+    BPNode* single = pool.allocate();
+    assert(pool.num_chunks() == 2);
+
+    // Recycled slots are reused first
+    pool.deallocate(batch[1]);
+    pool.deallocate(batch[2]);
+    BPNode* reuse[3];
+    pool.allocate_batch(3, reuse, make);
+    assert(reuse[0] == batch[2] && reuse[1] == batch[1]);
+    assert(pool.num_chunks() == 2);
+    assert(pool.size() == 7);
+    assert(pool.total_allocated() == 9);
+
+    pool.deallocate(first);
+    pool.deallocate(single);
+    assert(pool.size() == 5);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_tree_node_recycling() {
+    std::cout << "Testing BPTree node recycling..." << std::endl;
+
+    BPTree tree;
+    tree.set_node_recycling(true);
+    auto* root = tree.root();
+    root->set_lower_bound(0.0);
+
+    // root -> (a, b); a -> (a1, a2)
+    auto top = tree.create_children(root, {
+        BranchingDecision::ryan_foster(0, 1, true),
+        BranchingDecision::ryan_foster(0, 1, false),
+    });
+    auto* a = top[0];
+    auto* b = top[1];
+    BPNode::NodeId a_id = a->id();
+    auto leaves = tree.create_children(a, {
+        BranchingDecision::ryan_foster(2, 3, true),
+        BranchingDecision::ryan_foster(2, 3, false),
+    });
+    BPNode::NodeId a1_id = leaves[0]->id();
+    BPNode::NodeId a2_id = leaves[1]->id();
+    assert(tree.num_nodes() == 5);
+
+    // a1 is the incumbent, a2 is infeasible: a's subtree is closed,
+    // but a1 and a stay because they lie on the incumbent path
+    leaves[0]->set_lp_value(10.0);
+    tree.mark_processed(leaves[0], NodeStatus::INTEGER);
+    tree.set_incumbent(leaves[0]);
+    tree.mark_processed(leaves[1], NodeStatus::PRUNED_INFEASIBLE);
+    assert(a->num_open_children() == 0);
+    assert(root->num_open_children() == 1);
+
+    assert(tree.reclaim_closed_nodes() == 1);  // only a2
+    assert(!tree.has_node(a2_id));
+    assert(tree.has_node(a1_id));
+    assert(tree.has_node(a_id));
+    assert(tree.num_nodes() == 4);
+    assert(tree.stats().nodes_released == 1);
+
+    // b finds a better incumbent: the old path (a1, a) is released
+    b->set_lp_value(5.0);
+    tree.mark_processed(b, NodeStatus::INTEGER);
+    tree.set_incumbent(b);
+    assert(tree.reclaim_closed_nodes() == 2);
+    assert(!tree.has_node(a1_id));
+    assert(!tree.has_node(a_id));
+    assert(tree.has_node(b->id()));
+    assert(tree.has_node(root->id()));
+    assert(tree.incumbent() == b);
+
+    auto path = tree.get_path_to_root(b->id());
+    assert(path.size() == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
 int main() {
     std::cout << "=== BPTree Tests ===" << std::endl;
 
@@ -236,13 +676,22 @@ int main() {
     test_create_child();
     test_create_children();
     test_inherited_decisions();
+    test_shared_decision_path();
+    test_infeasible_ryan_foster_children();
     test_node_lookup();
+    test_dense_node_index();
+    test_node_table();
     test_bounds();
+    test_incremental_lower_bound();
     test_prune_by_bound();
+    test_prune_by_bound_index();
     test_get_open_nodes();
     test_incumbent();
     test_path_to_root();
     test_statistics();
+    test_node_pool_recycling();
+    test_node_pool_batch();
+    test_tree_node_recycling();
 
     std::cout << "\nAll tests passed!" << std::endl;
     return 0;
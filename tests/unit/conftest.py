@@ -0,0 +1,59 @@
+"""Shared fixtures for the Python test suite."""
+
+import glob
+import importlib.util
+import os
+
+import pytest
+
+_REPO_ROOT = os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+# Where a compiled _core extension is looked for, in order
+_NATIVE_PATTERNS = [
+    os.path.join(_REPO_ROOT, "openbp", "_core*.so"),
+    os.path.join(_REPO_ROOT, "openbp", "_core*.pyd"),
+    os.path.join(_REPO_ROOT, "build", "*", "_core*.so"),
+]
+
+
+def _find_native_core():
+    path = os.environ.get("OPENBP_NATIVE_CORE")
+    if path:
+        return path
+    for pattern in _NATIVE_PATTERNS:
+        matches = sorted(glob.glob(pattern))
+        if matches:
+            return matches[0]
+    return None
+
+
+@pytest.fixture(scope="session")
+def native_core():
+    """The compiled pybind11 module, loaded directly from its file.
+
+    The openbp._core package shadows the extension of the same name, so
+    the module is loaded from its path (OPENBP_NATIVE_CORE, the package
+    directory, or a CMake build directory). Tests using this fixture are
+    skipped when no build is found.
+    """
+    path = _find_native_core()
+    if path is None:
+        pytest.skip("compiled openbp _core extension not found (set OPENBP_NATIVE_CORE)")
+    spec = importlib.util.spec_from_file_location("_core", path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+@pytest.fixture(params=["python", "native"])
+def backend(request):
+    """The pure-Python openbp.core package, then the compiled module.
+
+    For tests of behaviour both implementations share; the native run is
+    skipped when no build is found.
+    """
+    if request.param == "native":
+        return request.getfixturevalue("native_core")
+    import openbp.core
+
+    return openbp.core
@@ -146,6 +146,24 @@ class TestRyanFosterBranching:
             assert c.decisions[0].same_column is True  # Same branch
             assert c.decisions[1].same_column is False  # Different branch
 
+    def test_skips_implied_pairs(self):
+        """Pairs decided on the path, even transitively, are not candidates."""
+        strategy = RyanFosterBranching()
+        node = BPNode()
+        node.set_inherited_decisions([
+            BranchingDecision.ryan_foster(1, 2, True),
+            BranchingDecision.ryan_foster(2, 3, True),
+        ])
+
+        columns = [
+            MockColumn(arc_indices=(1,), cost=10.0, covered_items=frozenset({1, 3, 4})),
+            MockColumn(arc_indices=(2,), cost=20.0, covered_items=frozenset({2})),
+        ]
+        candidates = strategy.select_branching_candidates(node, columns, [0.5, 0.5], {})
+
+        pairs = {(c.metadata["item_i"], c.metadata["item_j"]) for c in candidates}
+        assert pairs == {(1, 4), (3, 4)}
+
     def test_filter_columns_same(self):
         """Test filtering columns for same-column decision."""
         strategy = RyanFosterBranching()
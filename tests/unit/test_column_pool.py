@@ -0,0 +1,290 @@
+"""Tests for ColumnPool, ColumnFilter and NodeColumnSets (pure Python fallback and native module)."""
+
+import threading
+
+import pytest
+
+
+class TestColumnPool:
+    """Tests for ColumnPool (pure Python fallback and native module)."""
+
+    def test_add_and_dedupe(self, backend):
+        """Same coverage and arcs is a duplicate; the first column is kept."""
+        pool = backend.ColumnPool(10)
+
+        assert pool.add(5.0, frozenset({3, 1, 7})) == (0, True)
+        assert pool.add(9.0, [7, 3, 1, 3]) == (0, False)
+        assert pool.cost(0) == 5.0
+
+        assert pool.add(6.0, {1, 3, 7}, (4, 2)) == (1, True)
+        assert pool.add(6.0, {1, 3, 7}, (4, 2)) == (1, False)
+        assert pool.add(6.0, {1, 3, 7}, (2, 4)) == (2, True)
+        assert len(pool) == 3
+
+    def test_find(self, backend):
+        """find returns the index or -1."""
+        pool = backend.ColumnPool()
+        pool.add(1.0, [0, 65], [10, 11])
+
+        assert pool.find([65, 0], [10, 11]) == 0
+        assert pool.find([0, 65]) == -1
+        assert pool.find([500]) == -1
+        assert pool.contains({0, 65}, (10, 11))
+
+    def test_column_access(self, backend):
+        """Items are returned sorted, arcs in order."""
+        pool = backend.ColumnPool()
+        pool.add(1.0, [65, 0], [12, 10])
+        pool.add(2.0, [64])
+
+        assert pool.items(0) == [0, 65]
+        assert pool.arcs(0) == [12, 10]
+        assert pool.arcs(1) == []
+        assert pool.covers(1, 64)
+        assert not pool.covers(1, 0)
+        assert pool.num_items == 66
+        assert pool.words_per_column == 2
+
+    def test_negative_item(self, backend):
+        """Negative items are rejected without adding a column."""
+        pool = backend.ColumnPool()
+        with pytest.raises(IndexError):
+            pool.add(1.0, [-1])
+        assert len(pool) == 0
+
+    def test_add_batch(self, backend):
+        """CSR batches report the pool index of every column."""
+        pool = backend.ColumnPool()
+        pool.add(1.0, [0, 1])
+
+        indices = pool.add_batch(
+            [2.0, 3.0, 4.0], [0, 2, 3, 5], [0, 1, 2, 3, 4],
+        )
+        assert list(indices) == [0, 1, 2]
+        assert len(pool) == 3
+
+        with pytest.raises(ValueError):
+            pool.add_batch([1.0], [0, 2], [0])
+        with pytest.raises(ValueError):
+            pool.add_batch([1.0], [0, 1], [0], arc_offsets=[0, 0])
+
+    def test_columnar_export(self, backend):
+        """Arrays follow the C++ layout."""
+        np = pytest.importorskip("numpy")
+        pool = backend.ColumnPool(70)
+        pool.add(1.0, [0, 65], [10, 11, 12])
+        pool.add(2.0, [64])
+
+        assert pool.costs().tolist() == [1.0, 2.0]
+        assert pool.coverage().tolist() == [[1, 2], [0, 1]]
+        assert pool.arc_offsets().tolist() == [0, 3, 3]
+        assert pool.arc_indices().dtype == np.int32
+
+    def test_clear(self, backend):
+        """clear removes columns and signatures."""
+        pool = backend.ColumnPool()
+        pool.add(1.0, [0])
+        pool.clear()
+
+        assert len(pool) == 0
+        assert pool.find([0]) == -1
+        assert pool.add(1.0, [0]) == (0, True)
+
+
+class TestColumnFilter:
+    """Tests for ColumnFilter (pure Python fallback and native module)."""
+
+    def make_pool(self, backend):
+        pool = backend.ColumnPool(10)
+        pool.add(1.0, [0, 1], [5])   # both
+        pool.add(1.0, [0], [6])      # only 0
+        pool.add(1.0, [1, 2])        # only 1
+        pool.add(1.0, [2, 3], [5])   # neither
+        return pool
+
+    def test_ryan_foster(self, backend):
+        """same keeps both-or-neither, diff drops columns with both."""
+        pool = self.make_pool(backend)
+
+        same = backend.ColumnFilter([backend.BranchingDecision.ryan_foster(0, 1, True)])
+        assert list(same.indices(pool)) == [0, 3]
+        diff = backend.ColumnFilter([backend.BranchingDecision.ryan_foster(0, 1, False)])
+        assert list(diff.indices(pool)) == [1, 2, 3]
+        assert list(diff.indices(pool, begin=2)) == [2, 3]
+
+    def test_arcs(self, backend):
+        """Source-free arc decisions are enforced; others are skipped."""
+        pool = self.make_pool(backend)
+
+        f = backend.ColumnFilter([backend.BranchingDecision.arc_branch(5, -1, True)])
+        assert list(f.indices(pool)) == [0, 3]
+        f = backend.ColumnFilter([backend.BranchingDecision.arc_branch(5, -1, False)])
+        assert list(f.indices(pool)) == [1, 2]
+
+        f = backend.ColumnFilter([backend.BranchingDecision.arc_branch(5, 2, True)])
+        assert f.num_skipped == 1
+        assert f.num_tests == 0
+        assert list(f.indices(pool)) == [0, 1, 2, 3]
+
+    def test_for_node(self, backend):
+        """for_node enforces the whole decision path."""
+        pool = self.make_pool(backend)
+        tree = backend.BPTree()
+        child = tree.create_child(tree.root(), backend.BranchingDecision.ryan_foster(0, 1, False))
+        grandchild = tree.create_child(child, backend.BranchingDecision.ryan_foster(2, 3, True))
+
+        f = backend.ColumnFilter.for_node(grandchild)
+        assert f.num_tests == 2
+        assert list(f.indices(pool)) == [1, 3]
+        assert f.accepts(pool, 3)
+        assert not f.accepts(pool, 0)
+
+    def test_mask_matches_indices(self, native_core):
+        """The native mask is a bool array; the AVX2 and scalar kernels agree."""
+        np = pytest.importorskip("numpy")
+        rng = np.random.default_rng(3)
+        pool = native_core.ColumnPool(300)
+        for _ in range(500):
+            pool.add(1.0, rng.choice(300, size=rng.integers(1, 12), replace=False))
+        decisions = [native_core.BranchingDecision.ryan_foster(i, i + 1, i % 3 == 0)
+                     for i in range(0, 200, 7)]
+        f = native_core.ColumnFilter(decisions)
+
+        mask = f.mask(pool)
+        assert mask.dtype == np.bool_
+        assert np.flatnonzero(mask).tolist() == f.indices(pool).tolist()
+        f.set_use_simd(False)
+        assert f.indices(pool).tolist() == np.flatnonzero(mask).tolist()
+        assert f.indices(pool, begin=250).tolist() == [k for k in np.flatnonzero(mask) if k >= 250]
+
+
+class TestNodeColumnSets:
+    """Tests for backend.NodeColumnSets."""
+
+    def test_branch_matches_full_filter(self, backend):
+        """Children derived from the parent equal a full re-filter."""
+        pool = backend.ColumnPool()
+        for cover in ([0, 1], [0], [1, 2], [2, 3], [0, 3], [1, 3]):
+            pool.add(1.0, cover)
+        tree = backend.BPTree()
+        sets = backend.NodeColumnSets(pool)
+
+        root = tree.root()
+        assert list(sets.get(root)) == list(range(6))
+        children = tree.create_children(root, [
+            backend.BranchingDecision.ryan_foster(0, 1, True),
+            backend.BranchingDecision.ryan_foster(0, 1, False),
+        ])
+        sets.branch(root, children)
+        assert not sets.is_cached(root.id)
+        assert len(sets) == 2
+
+        pool.add(1.0, [0, 1, 2])  # Generated after branching
+        for child in children:
+            assert list(sets.get(child)) == list(backend.ColumnFilter.for_node(child).indices(pool))
+        assert list(sets.get(children[0])) == [0, 3, 6]
+
+    def test_attach_drops_pruned(self, backend):
+        """Attached caches forget pruned nodes."""
+        pool = backend.ColumnPool()
+        pool.add(1.0, [0])
+        tree = backend.BPTree()
+        sets = backend.NodeColumnSets(pool)
+        sets.attach(tree)
+
+        children = tree.create_children(tree.root(), [
+            backend.BranchingDecision.ryan_foster(0, 1, True),
+            backend.BranchingDecision.ryan_foster(0, 1, False),
+        ])
+        sets.branch(tree.root(), children)
+        children[0].lower_bound = 10.0
+        tree.update_bounds(children[0])
+        tree.tighten_upper_bound(5.0)
+        tree.prune_by_bound()
+
+        assert sets.count(children[1]) == 1
+        assert not sets.is_cached(children[0].id)
+
+    def test_branch_from_threads(self, native_core):
+        """Sets of different subtrees are derived concurrently (GIL released)."""
+        np = pytest.importorskip("numpy")
+        rng = np.random.default_rng(8)
+        pool = native_core.ColumnPool(64)
+        for _ in range(2000):
+            pool.add(1.0, rng.choice(64, size=rng.integers(1, 8), replace=False))
+        tree = native_core.BPTree()
+        sets = native_core.NodeColumnSets(pool)
+        sets.attach(tree)
+        BranchingDecision = native_core.BranchingDecision
+        tops = tree.create_children(tree.root(), [BranchingDecision.ryan_foster(t, 63, t % 2 == 0)
+                                                  for t in range(4)])
+        sets.branch(tree.root(), tops)
+        errors = []
+
+        def dive(node, t):
+            try:
+                for depth in range(12):
+                    i = (7 * t + 5 * depth) % 60
+                    children = tree.create_children(node, [BranchingDecision.ryan_foster(i, i + 1, True),
+                                                           BranchingDecision.ryan_foster(i, i + 1, False)])
+                    sets.branch(node, children)
+                    for child in children:
+                        expected = native_core.ColumnFilter.for_node(child).indices(pool).tolist()
+                        if sets.get(child).tolist() != expected:
+                            errors.append((t, child.id))
+                    node = children[depth % 2]
+            except Exception as exc:  # pragma: no cover - reported below
+                errors.append(exc)
+
+        threads = [threading.Thread(target=dive, args=(top, t)) for t, top in enumerate(tops)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        assert errors == []
+
+
+class TestGlobalPool:
+    """Tests for the solver's global column pool."""
+
+    @pytest.fixture
+    def solver(self, monkeypatch):
+        """A solver whose pool is usable without OpenCG installed."""
+        from openbp.solver.branch_and_price import BranchAndPrice
+        monkeypatch.setattr(BranchAndPrice, "_import_opencg", lambda self: None)
+        return BranchAndPrice(problem=None)
+
+    def test_same_coverage_different_cost_kept(self, solver):
+        """Columns sharing a signature are only dropped if they are equal."""
+        from dataclasses import dataclass
+
+        @dataclass(frozen=True)
+        class Column:
+            cost: float
+            covered_items: frozenset
+            arc_indices: tuple = ()
+
+        expensive = Column(9.0, frozenset({1, 2}))
+        cheap = Column(4.0, frozenset({2, 1}))
+
+        solver._add_to_pool([expensive, cheap, Column(9.0, frozenset({1, 2}))])
+
+        assert solver.column_pool == [expensive, cheap]
+
+    def test_multiplicities_kept(self, solver):
+        """Cutting-stock patterns differing only in multiplicities are distinct."""
+        from dataclasses import dataclass, field
+
+        @dataclass
+        class Pattern:
+            cost: float
+            pattern: dict
+            covered_items: frozenset = field(init=False)
+
+            def __post_init__(self):
+                self.covered_items = frozenset(self.pattern)
+
+        solver._add_to_pool([Pattern(1.0, {0: 1, 3: 2}), Pattern(1.0, {0: 2, 3: 1})])
+        solver._add_to_pool([Pattern(1.0, {0: 1, 3: 2})])
+
+        assert len(solver.column_pool) == 2
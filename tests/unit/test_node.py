@@ -9,6 +9,7 @@ from openbp.core.node import (
     NodeStatus,
     BranchType,
     BranchingDecision,
+    RyanFosterClosure,
 )
 
 
@@ -237,3 +238,111 @@ class TestBPNode:
         assert len(node.children) == 2
         assert 1 in node.children
         assert 2 in node.children
+
+
+class TestRyanFosterClosure:
+    """Tests for RyanFosterClosure (pure Python fallback and native module)."""
+
+    def test_transitive_pairs(self, backend):
+        """Same decisions chain into classes; diff links whole classes."""
+        BranchingDecision = backend.BranchingDecision
+        closure = backend.RyanFosterClosure([
+            BranchingDecision.ryan_foster(1, 2, True),
+            BranchingDecision.ryan_foster(2, 3, True),
+            BranchingDecision.ryan_foster(3, 4, False),
+            BranchingDecision.ryan_foster(5, 6, True),
+            BranchingDecision.variable_branch(0, 1.0, True),
+        ])
+
+        assert closure.feasible
+        assert closure.num_items == 6
+        assert closure.together(1, 3)
+        assert closure.representative(1) == closure.representative(3)
+        assert closure.apart(1, 4) and closure.apart(4, 2)
+        assert not closure.implied(1, 5)
+        assert closure.implied_pairs(True) == [(1, 2), (1, 3), (2, 3), (5, 6)]
+        assert closure.implied_pairs(False) == [(1, 4), (2, 4), (3, 4)]
+
+    def test_infeasible(self, backend):
+        """A class that must be apart from itself is infeasible."""
+        BranchingDecision = backend.BranchingDecision
+        closure = backend.RyanFosterClosure([
+            BranchingDecision.ryan_foster(1, 2, True),
+            BranchingDecision.ryan_foster(2, 3, False),
+        ])
+        assert closure.add(BranchingDecision.ryan_foster(3, 4, True))
+        assert not closure.add(BranchingDecision.ryan_foster(1, 4, True))
+        assert not closure.feasible
+
+        assert not backend.RyanFosterClosure([BranchingDecision.ryan_foster(4, 4, False)]).feasible
+
+    def test_node_closure(self, backend):
+        """Nodes expose the closure of their whole decision path."""
+        BranchingDecision = backend.BranchingDecision
+        node = backend.BPNode()
+        node.add_local_decision(BranchingDecision.ryan_foster(0, 1, True))
+        node.add_local_decision(BranchingDecision.ryan_foster(1, 2, True))
+
+        assert node.ryan_foster_closure().together(0, 2)
+        assert node.ryan_foster_feasible
+
+        node.add_local_decision(BranchingDecision.ryan_foster(0, 2, False))
+        assert not node.ryan_foster_feasible
+
+    def test_inherited_closure(self):
+        """Inherited decisions count towards the closure."""
+        node = BPNode()
+        node.set_inherited_decisions([BranchingDecision.ryan_foster(0, 1, True)])
+        node.add_local_decision(BranchingDecision.ryan_foster(1, 2, True))
+
+        assert node.ryan_foster_closure().together(0, 2)
+        assert node.ryan_foster_feasible
+
+    def test_closure_is_a_snapshot(self, native_core):
+        """The native closure is a copy: adding to it leaves the node alone."""
+        BranchingDecision = native_core.BranchingDecision
+        node = native_core.BPNode()
+        node.add_local_decision(BranchingDecision.ryan_foster(0, 1, True))
+
+        closure = node.ryan_foster_closure()
+        assert not closure.add(BranchingDecision.ryan_foster(0, 1, False))
+        assert node.ryan_foster_closure().feasible
+        assert node.ryan_foster_feasible
+
+
+class TestNativeSolution:
+    """Solution arrays of the compiled BPNode (skipped without a build)."""
+
+    def test_views_are_read_only(self, native_core):
+        """Solution arrays cannot be written through."""
+        pytest.importorskip("numpy")
+        node = native_core.BPNode()
+        node.set_solution([0.0, 1.0])
+        node.set_solution_columns([3])
+
+        assert not node.solution.flags.writeable
+        assert not node.solution_columns.flags.writeable
+        with pytest.raises(ValueError):
+            node.solution[0] = 2.0
+
+    def test_views_outlive_the_node(self, native_core):
+        """An array keeps its buffer after re-solve, recycling and tree teardown."""
+        pytest.importorskip("numpy")
+        tree = native_core.BPTree()
+        tree.node_recycling = True
+        child = tree.create_child(
+            tree.root(), native_core.BranchingDecision.variable_branch(0, 0.5, True)
+        )
+        child.set_solution([0.0, 1.0, 1.0])
+        child.set_solution_columns([4, 7])
+        solution, columns = child.solution, child.solution_columns
+
+        child.set_solution([5.0])
+        assert solution.tolist() == [0.0, 1.0, 1.0]
+
+        tree.mark_processed(child, native_core.NodeStatus.PRUNED_INFEASIBLE)
+        assert tree.reclaim_closed_nodes() == 1
+        del child, tree
+
+        assert solution.tolist() == [0.0, 1.0, 1.0]
+        assert columns.tolist() == [4, 7]
@@ -0,0 +1,149 @@
+"""Tests for RyanFosterPairScorer (pure Python fallback and native module)."""
+
+import random
+import threading
+from collections import defaultdict
+
+import pytest
+
+from openbp.core import pair_scoring as py_pair_scoring
+
+
+def to_list(array):
+    return [float(x) for x in array]
+
+
+def random_columns(seed, num_columns=300, num_items=60):
+    rng = random.Random(seed)
+    offsets, items, values = [0], [], []
+    for c in range(num_columns):
+        items.extend(rng.randrange(num_items) for _ in range(1 + c % 8))
+        offsets.append(len(items))
+        values.append(rng.uniform(0.0, 0.4))
+    return offsets, items, values
+
+
+class TestRyanFosterPairScorer:
+    """Tests for RyanFosterPairScorer."""
+
+    def test_small_instance(self, backend):
+        """Pairs are ranked by balance, ties by the smaller pair."""
+        # {0,1,2} = 0.5, {1,0} = 0.25 (unsorted), {2,3,3} = 0.5, {0,3} = 0 (ignored)
+        offsets = [0, 3, 5, 8, 10]
+        items = [0, 1, 2, 1, 0, 2, 3, 3, 0, 3]
+        values = [0.5, 0.25, 0.5, 0.0]
+
+        scorer = backend.RyanFosterPairScorer()
+        top = scorer.score(offsets, items, values, k=10)
+
+        assert scorer.num_pairs == 4
+        assert [int(i) for i in top["item_i"]] == [0, 1, 2, 0]
+        assert [int(j) for j in top["item_j"]] == [2, 2, 3, 1]
+        assert to_list(top["together"]) == [0.5, 0.5, 0.5, 0.75]
+        assert to_list(top["score"]) == [1.0, 1.0, 1.0, 0.5]
+        assert top["apart"][0] == pytest.approx(0.75)
+
+        best = scorer.score(offsets, items, values, k=1)
+        assert (int(best["item_i"][0]), int(best["item_j"][0])) == (0, 2)
+
+    def test_closure_skips_implied_pairs(self, backend):
+        """Pairs decided by the closure, even transitively, are skipped."""
+        BranchingDecision = backend.BranchingDecision
+        closure = backend.RyanFosterClosure([
+            BranchingDecision.ryan_foster(0, 3, True),
+            BranchingDecision.ryan_foster(3, 2, False),
+            BranchingDecision.ryan_foster(0, 1, False),
+        ])
+        top = backend.RyanFosterPairScorer().score([0, 3, 4], [0, 1, 2, 3], [0.5, 0.5], k=10,
+                                                closure=closure)
+
+        assert [(int(i), int(j)) for i, j in zip(top["item_i"], top["item_j"])] == [(1, 2)]
+
+    def test_matches_dict_reference(self, backend):
+        """Top-k equals ranking a plain dict of pair masses."""
+        offsets, items, values = random_columns(5)
+
+        together = defaultdict(float)
+        for c, value in enumerate(values):
+            column = sorted(set(items[offsets[c]:offsets[c + 1]]))
+            for a, i in enumerate(column):
+                for j in column[a + 1:]:
+                    together[i, j] += value
+        expected = sorted(
+            (pair for pair, mass in together.items() if 0.01 <= mass <= 0.99),
+            key=lambda pair: (-(1.0 - abs(together[pair] - 0.5) * 2.0), pair),
+        )[:25]
+
+        top = backend.RyanFosterPairScorer().score(offsets, items, values, k=25)
+        assert [(int(i), int(j)) for i, j in zip(top["item_i"], top["item_j"])] == expected
+
+    def test_invalid_input(self, backend):
+        """Bad offsets and negative items are rejected."""
+        scorer = backend.RyanFosterPairScorer()
+        with pytest.raises(ValueError):
+            scorer.score([0, 3], [0, 1], [0.5])
+        with pytest.raises(IndexError):
+            scorer.score([0, 2], [0, -1], [0.5])
+        assert len(scorer.score([0], [], [], k=5)["score"]) == 0
+
+    def test_application_pair_search(self):
+        """_find_ryan_foster_pair skips pairs implied by earlier decisions."""
+        from openbp.applications.crew_pairing import RyanFosterDecision, _find_ryan_foster_pair
+
+        pairings = [{"flights": [0, 1, 2]}, {"flights": [3]}]
+        assert _find_ryan_foster_pair(pairings, [0.5, 0.5], []) == (0, 1, 0.5)
+
+        decisions = [RyanFosterDecision(0, 3, True), RyanFosterDecision(3, 2, False),
+                     RyanFosterDecision(0, 1, False)]
+        assert _find_ryan_foster_pair(pairings, [0.5, 0.5], decisions) == (1, 2, 0.5)
+        assert _find_ryan_foster_pair(pairings, [1.0, 1.0], []) is None
+
+
+class TestNativePairScorer:
+    """Native-only behaviour of RyanFosterPairScorer."""
+
+    def test_matches_python_on_sparse_universe(self, native_core):
+        """A large item universe (hash table path) ranks like the fallback."""
+        offsets, items, values = random_columns(11, num_columns=200, num_items=50000)
+        native = native_core.RyanFosterPairScorer().score(offsets, items, values, k=40)
+        python = py_pair_scoring.RyanFosterPairScorer().score(offsets, items, values, k=40)
+        for key in ("item_i", "item_j"):
+            assert [int(x) for x in native[key]] == [int(x) for x in python[key]]
+        assert to_list(native["together"]) == pytest.approx(to_list(python["together"]))
+        assert to_list(native["apart"]) == pytest.approx(to_list(python["apart"]))
+
+    def test_node_closure(self, native_core):
+        """The closure of a tree node filters pairs decided on its path."""
+        tree = native_core.BPTree()
+        child = tree.create_child(
+            tree.root(), native_core.BranchingDecision.ryan_foster(0, 1, True)
+        )
+        grandchild = tree.create_child(
+            child, native_core.BranchingDecision.ryan_foster(1, 2, False)
+        )
+        top = native_core.RyanFosterPairScorer().score(
+            [0, 3, 4], [0, 1, 2, 3], [0.5, 0.5], k=10,
+            closure=grandchild.ryan_foster_closure(),
+        )
+        # (0,1) together and (0,2), (1,2) apart are all decided
+        assert [(int(i), int(j)) for i, j in zip(top["item_i"], top["item_j"])] == []
+
+    def test_concurrent_scoring(self, native_core):
+        """Scorers run from several Python threads agree with a serial run."""
+        offsets, items, values = random_columns(3, num_columns=2000, num_items=400)
+        expected = native_core.RyanFosterPairScorer().score(offsets, items, values, k=50)
+        results = [None] * 4
+
+        def run(t):
+            scorer = native_core.RyanFosterPairScorer()
+            for _ in range(5):
+                results[t] = scorer.score(offsets, items, values, k=50)
+
+        threads = [threading.Thread(target=run, args=(t,)) for t in range(len(results))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for result in results:
+            assert [int(x) for x in result["item_i"]] == [int(x) for x in expected["item_i"]]
+            assert [int(x) for x in result["item_j"]] == [int(x) for x in expected["item_j"]]
@@ -0,0 +1,405 @@
+"""Tests for the parallel B&P driver (pure Python fallback and native module)."""
+
+import threading
+import time
+
+import pytest
+
+from openbp.core.node import BranchingDecision, NodeStatus
+from openbp.core.parallel import (
+    IncumbentRegister,
+    NodeResult,
+    ParallelConfig,
+    ParallelSolver,
+    ParallelStatus,
+    PortfolioConfig,
+    PortfolioSolver,
+    apply_round,
+    select_round,
+)
+from openbp.core.selection import BestFirstSelector
+from openbp.core.tree import BPTree
+
+
+def knapsack_processor(node, worker):
+    """Branch on variables 0..3; leaves are integer with cost = bound + 1."""
+    lb = node.lower_bound + 1.0
+    if node.depth >= 4:
+        return NodeResult.integer(lb + node.id % 3)
+    return NodeResult.branch(lb, lb, [
+        BranchingDecision.variable_branch(node.depth, 0.5, False),
+        BranchingDecision.variable_branch(node.depth, 0.5, True),
+    ])
+
+
+def make_tree():
+    tree = BPTree()
+    tree.root().lower_bound = 0.0
+    return tree
+
+
+class TestParallelSolver:
+    """Tests for ParallelSolver."""
+
+    def test_solves_to_completion(self):
+        """The driver explores the tree and records an incumbent."""
+        tree = make_tree()
+        solver = ParallelSolver(tree, BestFirstSelector(), ParallelConfig(gap_tolerance=0.0))
+
+        result = solver.run(knapsack_processor)
+
+        assert result.status in (ParallelStatus.COMPLETED, ParallelStatus.GAP_LIMIT)
+        assert result.nodes_processed > 0
+        assert tree.incumbent() is not None
+        assert tree.incumbent().status == NodeStatus.INTEGER
+        assert tree.global_upper_bound == 5.0
+
+    def test_deterministic_rounds(self):
+        """Deterministic runs process fixed-size rounds and repeat exactly."""
+        def run():
+            tree = make_tree()
+            config = ParallelConfig(deterministic=True, round_size=4, gap_tolerance=0.0)
+            result = ParallelSolver(tree, BestFirstSelector(), config).run(knapsack_processor)
+            statuses = []
+            tree.for_each_node(lambda n: statuses.append((n.id, n.status, n.lower_bound)))
+            return result, statuses
+
+        first, statuses = run()
+        second, statuses_again = run()
+
+        assert first.rounds >= first.nodes_processed / 4
+        assert first.rounds == second.rounds
+        assert statuses == statuses_again
+
+    def test_node_limit_keeps_queue(self):
+        """Hitting the node limit leaves remaining nodes in the selector."""
+        tree = make_tree()
+        selector = BestFirstSelector()
+        solver = ParallelSolver(tree, selector, ParallelConfig(max_nodes=3))
+
+        result = solver.run(knapsack_processor)
+
+        assert result.status == ParallelStatus.NODE_LIMIT
+        assert result.nodes_processed == 3
+        assert not selector.empty()
+
+    def test_infeasible_root(self):
+        """An infeasible root completes immediately."""
+        tree = make_tree()
+        solver = ParallelSolver(tree, BestFirstSelector())
+
+        result = solver.run(lambda node, worker: NodeResult.infeasible())
+
+        assert result.status == ParallelStatus.COMPLETED
+        assert result.nodes_processed == 1
+        assert tree.root().status == NodeStatus.PRUNED_INFEASIBLE
+
+    def test_processor_errors_propagate(self):
+        """Exceptions raised by the processor reach the caller."""
+        def failing(node, worker):
+            raise ValueError("pricing failed")
+
+        solver = ParallelSolver(make_tree(), BestFirstSelector())
+        with pytest.raises(ValueError):
+            solver.run(failing)
+
+
+class TestRoundAPI:
+    """Tests for select_round and apply_round."""
+
+    def test_rounds_of_results(self):
+        """Whole rounds of NodeResults solve the tree."""
+        tree = make_tree()
+        selector = BestFirstSelector()
+        selector.add_node(tree.root())
+
+        improved = 0
+        while True:
+            nodes = select_round(tree, selector, 4)
+            if not nodes:
+                break
+            assert len(nodes) <= 4
+            assert all(n.status == NodeStatus.PROCESSING for n in nodes)
+            improved += apply_round(tree, selector, nodes, [knapsack_processor(n, 0) for n in nodes])
+
+        assert improved > 0
+        assert tree.is_complete
+        assert tree.global_upper_bound == 5.0
+
+    def test_rounds_of_arrays(self):
+        """Statuses and bounds may be given as parallel sequences of codes."""
+        branched, infeasible, integer = 2, 4, 5  # C++ NodeStatus codes
+        tree = make_tree()
+        selector = BestFirstSelector()
+        selector.add_node(tree.root())
+
+        nodes = select_round(tree, selector, 8)
+        assert nodes == [tree.root()]
+        branches = [[
+            BranchingDecision.variable_branch(0, 0.5, False),
+            BranchingDecision.variable_branch(0, 0.5, True),
+        ]]
+        apply_round(tree, selector, nodes, [branched], [1.0], [1.0], branches)
+        assert selector.size() == 2
+
+        nodes = select_round(tree, selector, 8)
+        statuses = [integer, infeasible]
+        assert apply_round(tree, selector, nodes, statuses, [3.0, 0.0], [3.0, 0.0]) == 1
+        assert tree.global_upper_bound == 3.0
+        assert tree.is_complete
+
+        with pytest.raises(ValueError):
+            apply_round(tree, selector, nodes, statuses, [3.0], [3.0])
+
+
+class TestIncumbentRegister:
+    """Tests for IncumbentRegister and deferred pruning."""
+
+    def test_offer_keeps_minimum(self):
+        """Only improvements are accepted, each bumping the epoch."""
+        reg = IncumbentRegister()
+
+        assert reg.offer(10.0, 2)
+        assert not reg.offer(10.0, 3)
+        assert reg.offer(7.0, 1)
+
+        assert reg.upper_bound == 7.0
+        assert reg.epoch == 2
+        assert reg.source == 1
+
+    def test_tighten_defers_pruning(self):
+        """A tightened bound prunes only on prune_if_pending()."""
+        tree = make_tree()
+        children = tree.create_children(tree.root(), [
+            BranchingDecision.variable_branch(0, 0.5, False),
+            BranchingDecision.variable_branch(0, 0.5, True),
+        ])
+        tree.mark_processed(tree.root(), NodeStatus.BRANCHED)
+        children[0].lower_bound = 3.0
+        children[1].lower_bound = 6.0
+
+        assert tree.tighten_upper_bound(5.0)
+        assert not tree.tighten_upper_bound(9.0)
+        assert tree.prune_pending
+        assert children[1].can_be_explored
+
+        assert tree.prune_if_pending() == 1
+        assert not children[1].can_be_explored
+        assert tree.prune_if_pending() == 0
+
+    def test_shared_bound_reaches_solver(self):
+        """A bound offered from outside prunes the solver's tree."""
+        shared = IncumbentRegister()
+        shared.offer(5.0)
+        tree = make_tree()
+        solver = ParallelSolver(tree, BestFirstSelector(), ParallelConfig(gap_tolerance=0.0))
+        solver.share_incumbent(shared)
+
+        result = solver.run(knapsack_processor)
+
+        assert result.status in (ParallelStatus.COMPLETED, ParallelStatus.GAP_LIMIT)
+        assert tree.global_upper_bound == 5.0
+        assert tree.incumbent() is None  # Nothing strictly better exists
+        assert solver.incumbent is shared
+
+
+class TestPortfolioSolver:
+    """Tests for PortfolioSolver."""
+
+    def test_race_finds_optimum(self):
+        """One racer proves the shared incumbent optimal."""
+        portfolio = PortfolioSolver(PortfolioConfig(gap_tolerance=0.0))
+
+        result = portfolio.run(
+            knapsack_processor, setup_root=lambda root: setattr(root, "lower_bound", 0.0)
+        )
+
+        assert result.status in (ParallelStatus.COMPLETED, ParallelStatus.GAP_LIMIT)
+        assert 0 <= result.winner < portfolio.num_racers
+        assert result.incumbent_racer >= 0
+        assert result.upper_bound == 5.0
+        assert len(result.racers) == 4
+        assert portfolio.tree(result.winner).global_upper_bound == 5.0
+
+    def test_node_limit(self):
+        """Racers that all hit the node limit prove nothing."""
+        config = PortfolioConfig(selectors=["best_first", "depth_first"], max_nodes=2)
+
+        result = PortfolioSolver(config).run(knapsack_processor)
+
+        assert result.status == ParallelStatus.NODE_LIMIT
+        assert result.winner == -1
+        assert all(r.nodes_processed == 2 for r in result.racers)
+
+
+def native_processor(core, delay=0.0, on_call=None):
+    """knapsack_processor over the native types, optionally sleeping in Python."""
+    def process(node, worker):
+        if on_call is not None:
+            on_call(node, worker)
+        if delay:
+            time.sleep(delay)
+        lb = node.lower_bound + 1.0
+        if node.depth >= 4:
+            return core.NodeResult.integer(lb + node.id % 3)
+        return core.NodeResult.branch(lb, lb, [
+            core.BranchingDecision.variable_branch(node.depth, 0.5, False),
+            core.BranchingDecision.variable_branch(node.depth, 0.5, True),
+        ])
+    return process
+
+
+def native_tree(core):
+    tree = core.BPTree()
+    tree.root().lower_bound = 0.0
+    return tree
+
+
+class TestNativeParallel:
+    """The compiled driver and round API, called back from Python (skipped without a build)."""
+
+    def test_rounds_of_results(self, native_core):
+        """select_round/apply_round solve the tree with NodeResults."""
+        tree = native_tree(native_core)
+        selector = native_core.BestFirstSelector()
+        selector.add_node(tree.root())
+        process = native_processor(native_core)
+
+        while True:
+            nodes = native_core.select_round(tree, selector, 4)
+            if not nodes:
+                break
+            assert len(nodes) <= 4
+            assert all(n.status == native_core.NodeStatus.PROCESSING for n in nodes)
+            native_core.apply_round(tree, selector, nodes, [process(n, 0) for n in nodes])
+
+        assert tree.is_complete
+        assert tree.global_upper_bound == 5.0
+
+    def test_rounds_of_arrays(self, native_core):
+        """Status codes and bounds may be given as arrays."""
+        np = pytest.importorskip("numpy")
+        NodeStatus = native_core.NodeStatus
+        tree = native_tree(native_core)
+        selector = native_core.BestFirstSelector()
+        selector.add_node(tree.root())
+
+        nodes = native_core.select_round(tree, selector, 8)
+        branches = [[
+            native_core.BranchingDecision.variable_branch(0, 0.5, False),
+            native_core.BranchingDecision.variable_branch(0, 0.5, True),
+        ]]
+        native_core.apply_round(tree, selector, nodes, np.array([int(NodeStatus.BRANCHED)], dtype=np.int32),
+                                np.array([1.0]), np.array([1.0]), branches)
+        assert selector.size() == 2
+
+        nodes = native_core.select_round(tree, selector, 8)
+        statuses = np.array([int(NodeStatus.INTEGER), int(NodeStatus.PRUNED_INFEASIBLE)], dtype=np.int32)
+        assert native_core.apply_round(tree, selector, nodes, statuses,
+                                       np.array([3.0, 0.0]), np.array([3.0, 0.0])) == 1
+        assert tree.global_upper_bound == 3.0
+        assert tree.is_complete
+
+        with pytest.raises(ValueError):
+            native_core.apply_round(tree, selector, nodes, statuses, [3.0], [3.0])
+        with pytest.raises(ValueError):
+            native_core.apply_round(tree, selector, nodes, np.array([0, 0], dtype=np.int32),
+                                    [3.0, 0.0], [3.0, 0.0])
+
+    def test_concurrent_callbacks(self, native_core):
+        """Workers call the Python processor concurrently; run() holds no GIL while waiting."""
+        lock = threading.Lock()
+        active, peak, workers = [0], [0], set()
+
+        def on_call(node, worker):
+            with lock:
+                active[0] += 1
+                peak[0] = max(peak[0], active[0])
+                workers.add(worker)
+
+        inner = native_processor(native_core, delay=0.005, on_call=on_call)
+
+        def process(node, worker):
+            try:
+                return inner(node, worker)
+            finally:
+                with lock:
+                    active[0] -= 1
+
+        config = native_core.ParallelConfig()
+        config.num_threads = 4
+        config.gap_tolerance = 0.0
+        tree = native_tree(native_core)
+        result = native_core.ParallelSolver(tree, native_core.BestFirstSelector(), config).run(process)
+
+        assert result.status in (native_core.ParallelStatus.COMPLETED, native_core.ParallelStatus.GAP_LIMIT)
+        assert tree.global_upper_bound == 5.0
+        assert sum(result.nodes_per_worker) == result.nodes_processed
+        # time.sleep releases the GIL, so callbacks on different workers overlap
+        assert peak[0] > 1
+        assert len(workers) > 1
+
+    def test_stop_from_python_thread(self, native_core):
+        """Another Python thread runs, and can stop the solve, while run() blocks."""
+        config = native_core.ParallelConfig()
+        config.num_threads = 2
+        started = threading.Event()
+
+        def process(node, worker):
+            started.set()
+            time.sleep(0.01)
+            # An endless dive: only stop() ends the run
+            lb = node.lower_bound + 1.0
+            return native_core.NodeResult.branch(lb, lb, [
+                native_core.BranchingDecision.variable_branch(node.depth, 0.5, False),
+                native_core.BranchingDecision.variable_branch(node.depth, 0.5, True),
+            ])
+
+        solver = native_core.ParallelSolver(native_tree(native_core), native_core.BestFirstSelector(), config)
+
+        def stopper():
+            started.wait(5.0)
+            solver.stop()
+
+        thread = threading.Thread(target=stopper)
+        thread.start()
+        result = solver.run(process)
+        thread.join()
+
+        assert result.status == native_core.ParallelStatus.INTERRUPTED
+
+    def test_processor_errors_keep_their_type(self, native_core):
+        """A Python exception raised on a worker is re-raised unchanged by run()."""
+        def failing(node, worker):
+            time.sleep(0.005)  # Let several workers fail at once
+            raise ValueError("pricing failed")
+
+        def fail_below_root(node, worker):
+            if node.depth == 0:
+                return native_processor(native_core)(node, worker)
+            return failing(node, worker)
+
+        config = native_core.ParallelConfig()
+        config.num_threads = 3
+        solver = native_core.ParallelSolver(native_tree(native_core), native_core.BestFirstSelector(), config)
+        with pytest.raises(ValueError, match="pricing failed"):
+            solver.run(fail_below_root)
+        solver = native_core.ParallelSolver(native_tree(native_core), native_core.BestFirstSelector(), config)
+        with pytest.raises(ValueError, match="pricing failed"):
+            solver.run(failing)
+
+        portfolio = native_core.PortfolioSolver()
+        with pytest.raises(ValueError, match="pricing failed"):
+            portfolio.run(failing)
+
+    def test_portfolio_callbacks(self, native_core):
+        """Racers call the processor and setup_root from their own threads."""
+        config = native_core.PortfolioConfig()
+        config.gap_tolerance = 0.0
+        portfolio = native_core.PortfolioSolver(config)
+
+        result = portfolio.run(native_processor(native_core, delay=0.001),
+                               setup_root=lambda root: setattr(root, "lower_bound", 0.0))
+
+        assert result.upper_bound == 5.0
+        assert 0 <= result.winner < portfolio.num_racers
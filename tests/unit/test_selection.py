@@ -7,6 +7,7 @@ from openbp.core.selection import (
     DepthFirstSelector,
     BestEstimateSelector,
     HybridSelector,
+    WorkStealingSelector,
     create_selector,
 )
 from openbp.core.node import BPNode, NodeStatus
@@ -233,6 +234,48 @@ class TestHybridSelector:
         assert len(selected_ids) > 0
 
 
+class TestWorkStealingSelector:
+    """Tests for WorkStealingSelector."""
+
+    def _node(self, node_id, bound, depth=1):
+        node = BPNode(id=node_id, depth=depth)
+        node.lower_bound = bound
+        return node
+
+    def test_local_balancing_and_stealing(self):
+        """Own queue is depth-first; drift and idleness pull the best node."""
+        selector = WorkStealingSelector(num_workers=3, max_bound_drift=0.1)
+        low = [self._node(i, float(i)) for i in range(5)]
+        deep = self._node(10, 2.5, depth=2)
+        high = [self._node(20 + i, 20.0 + i) for i in range(5)]
+        selector.add_nodes_for_worker(low + [deep], 0)
+        selector.add_nodes_for_worker(high, 1)
+
+        assert selector.size() == 11
+        assert selector.select_for_worker(0) is deep
+        assert selector.select_for_worker(1) is low[0]
+        assert selector.num_balancing_picks == 1
+        assert selector.select_for_worker(2) is low[1]
+        assert selector.num_steals == 1
+        assert selector.best_bound() == 2.0
+
+    def test_drain(self):
+        """Every node is returned exactly once."""
+        selector = WorkStealingSelector(num_workers=4)
+        nodes = [self._node(i, float(i % 7)) for i in range(40)]
+        for node in nodes:
+            selector.add_node(node)
+        nodes[3].status = NodeStatus.PRUNED_BOUND
+
+        drained = []
+        while (node := selector.select_for_worker(len(drained) % 4)) is not None:
+            drained.append(node)
+
+        assert len(drained) == 39
+        assert len({n.id for n in drained}) == 39
+        assert selector.empty()
+
+
 class TestCreateSelector:
     """Tests for the create_selector factory."""
 
@@ -259,6 +302,11 @@ class TestCreateSelector:
         selector = create_selector("hybrid")
         assert isinstance(selector, HybridSelector)
 
+    def test_create_work_stealing(self):
+        """Test creating work-stealing selector."""
+        selector = create_selector("work_stealing")
+        assert isinstance(selector, WorkStealingSelector)
+
     def test_unknown_defaults_to_best_first(self):
         """Test that unknown name defaults to best-first."""
         selector = create_selector("unknown")
@@ -1,5 +1,7 @@
 """Tests for BPTree."""
 
+import random
+
 import pytest
 
 from openbp.core.tree import BPTree, TreeStats
@@ -143,6 +145,28 @@ class TestBPTree:
         assert tree.global_upper_bound == 100.0
         assert abs(tree.gap() - 0.5) < 1e-9
 
+    def test_lower_bound_tracks_open_nodes(self):
+        """Test that the global lower bound follows the open nodes."""
+        tree = BPTree()
+        tree.root().lower_bound = 10.0
+        assert tree.global_lower_bound == 10.0
+
+        children = tree.create_children(tree.root(), [
+            BranchingDecision.variable_branch(0, 0.5, True),
+            BranchingDecision.variable_branch(0, 0.5, False),
+        ])
+        children[0].lower_bound = 12.0
+        children[1].lower_bound = 15.0
+        assert tree.global_lower_bound == 12.0
+
+        tree.mark_processed(children[0], NodeStatus.PRUNED_INFEASIBLE)
+        assert tree.global_lower_bound == 15.0
+
+        tree.global_upper_bound = 20.0
+        tree.mark_processed(children[1], NodeStatus.FATHOMED)
+        assert tree.global_lower_bound == 20.0
+        assert tree.gap() == 0.0
+
     def test_update_bounds(self):
         """Test updating bounds from a node."""
         tree = BPTree()
@@ -278,3 +302,58 @@ class TestBPTree:
 
         assert tree.stats.nodes_pruned_bound == 1
         assert tree.stats.nodes_open == 1
+
+    def test_infeasible_ryan_foster_children(self):
+        """Children contradicting the path are created closed."""
+        tree = BPTree()
+        child = tree.create_children(tree.root(), [BranchingDecision.ryan_foster(0, 1, True)])[0]
+        grandchildren = tree.create_children(child, [
+            BranchingDecision.ryan_foster(1, 2, True),
+            BranchingDecision.ryan_foster(0, 1, False),
+        ])
+
+        assert grandchildren[0].status == NodeStatus.PENDING
+        assert grandchildren[1].status == NodeStatus.PRUNED_INFEASIBLE
+        assert tree.get_open_nodes() == [grandchildren[0].id]
+        assert tree.stats.nodes_pruned_infeasible == 1
+
+    def test_ryan_foster_dive_matches_closure(self, backend):
+        """Feasibility of children down a long dive matches a fresh closure."""
+        BranchingDecision = backend.BranchingDecision
+        tree = backend.BPTree()
+        rng = random.Random(7)
+        node = tree.root()
+        for _ in range(200):
+            i, j = rng.randrange(12), rng.randrange(12)
+            children = tree.create_children(node, [
+                BranchingDecision.ryan_foster(i, j, True),
+                BranchingDecision.ryan_foster(i, j, False),
+            ])
+            for child in children:
+                expected = backend.RyanFosterClosure(child.all_decisions()).feasible
+                assert child.ryan_foster_feasible == expected
+                if rng.random() < 0.1:
+                    # Reading a closure must not disturb the children's checks
+                    assert child.ryan_foster_closure().feasible == expected
+            feasible = [child for child in children if child.ryan_foster_feasible]
+            node = feasible[0] if feasible else tree.root()
+
+    def test_node_table(self):
+        """Nodes export as NumPy columns in ID order."""
+        np = pytest.importorskip("numpy")
+        tree = BPTree()
+        tree.root().lower_bound = 1.0
+        children = tree.create_children(tree.root(), [
+            BranchingDecision.variable_branch(0, 0.5, False),
+            BranchingDecision.variable_branch(0, 0.5, True),
+        ])
+        children[1].lower_bound = 2.5
+        tree.mark_processed(children[0], NodeStatus.PRUNED_INFEASIBLE)
+
+        table = tree.node_table()
+
+        assert table["id"].tolist() == [0, 1, 2]
+        assert table["parent_id"].tolist() == [-1, 0, 0]
+        assert table["depth"].dtype == np.int32
+        assert table["lower_bound"].tolist() == [1.0, 1.0, 2.5]
+        assert table["status"].tolist() == [2, 4, 0]  # C++ NodeStatus codes